@@ -0,0 +1,37 @@
+#include <assert.h>
+
+unsigned int nondet_uint();
+int nondet_int();
+
+struct reg
+{
+  unsigned char flags;
+  unsigned short data[4];
+};
+
+int main()
+{
+  unsigned int x = nondet_uint();
+  int y = nondet_int();
+
+  /* Bit tricks */
+  assert(((x & -x) & (x - 1)) == 0);
+  assert(((x << 3) >> 3) == (x & 0x1fffffff));
+  assert((x ^ x) == 0);
+
+  /* Signed division and remainder follow C semantics */
+  int q = y / 7, r = y % 7;
+  assert(q * 7 + r == y);
+  assert(r > -7 && r < 7);
+  assert(((y >> 31) & 1) == (y < 0));
+
+  /* Tuples and arrays go through the flatteners */
+  struct reg r0;
+  unsigned int i = nondet_uint() % 4;
+  r0.data[i] = (unsigned short)x;
+  r0.flags = 0x80;
+  assert(r0.data[i] == (x & 0xffff));
+  assert((r0.flags >> 7) == 1);
+
+  return 0;
+}
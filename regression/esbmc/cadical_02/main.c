@@ -0,0 +1,13 @@
+#include <assert.h>
+
+unsigned int nondet_uint();
+
+int main()
+{
+  unsigned int x = nondet_uint();
+  unsigned int mask = x & -x;
+
+  /* Wrong for x == 0 */
+  assert(mask != 0);
+  return 0;
+}
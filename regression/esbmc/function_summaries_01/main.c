@@ -0,0 +1,33 @@
+#include <assert.h>
+
+int nondet_int();
+
+static int max(int a, int b)
+{
+  if(a > b)
+    return a;
+  return b;
+}
+
+static int clamp(int x, int lo, int hi)
+{
+  int r = x;
+  if(r < lo)
+    r = lo;
+  else if(r > hi)
+    r = hi;
+  return r;
+}
+
+int main()
+{
+  int acc = 0;
+  for(int i = 0; i < 8; i++)
+  {
+    int v = clamp(nondet_int(), -10, 10);
+    assert(v >= -10 && v <= 10);
+    acc = max(acc, v);
+  }
+  assert(acc >= 0 && acc <= 10);
+  return 0;
+}
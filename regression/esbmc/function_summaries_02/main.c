@@ -0,0 +1,24 @@
+#include <assert.h>
+
+int nondet_int();
+
+int limit = 4;
+
+static int scaled(int x)
+{
+  if(x > limit)
+    return limit;
+  return x;
+}
+
+int main()
+{
+  int a = scaled(nondet_int());
+  limit = 8;
+  int b = scaled(6);
+
+  /* b is 6 once the limit has been raised */
+  assert(a <= 4);
+  assert(b == 4);
+  return 0;
+}
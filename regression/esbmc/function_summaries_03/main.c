@@ -0,0 +1,47 @@
+#include <assert.h>
+
+int nondet_int();
+
+struct point
+{
+  int x;
+  int y;
+};
+
+/* Small accessors: each call reads through the pointer it is given */
+static int get_x(const struct point *p)
+{
+  return p->x;
+}
+
+static int distance(const struct point *p)
+{
+  if(p->x > p->y)
+    return p->x - p->y;
+  return p->y - p->x;
+}
+
+static int at(const int *a, int i)
+{
+  return a[i];
+}
+
+int main()
+{
+  struct point pts[3] = {{1, 2}, {5, 3}, {7, 7}};
+  int data[4] = {10, 20, 30, 40};
+
+  int s = 0;
+  for(int i = 0; i < 3; i++)
+    s = s + get_x(&pts[i]);
+  assert(s == 13);
+  assert(distance(&pts[1]) == 2);
+  assert(at(data, 2) == 30);
+
+  /* q may point to either of two objects */
+  struct point *q = nondet_int() ? &pts[0] : &pts[1];
+  int v = get_x(q);
+  assert(v == 1 || v == 5);
+  assert(get_x(q) == 1); // fails for q == &pts[1]
+  return 0;
+}
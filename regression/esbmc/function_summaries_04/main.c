@@ -0,0 +1,19 @@
+#include <assert.h>
+
+int nondet_int();
+
+static int get(const int *p)
+{
+  return *p;
+}
+
+int main()
+{
+  int a = 1;
+  int *p = nondet_int() ? &a : 0;
+
+  /* The summarised call must still check the dereference */
+  int v = get(p);
+  assert(v == 1);
+  return 0;
+}
@@ -0,0 +1,28 @@
+#include <assert.h>
+
+struct point
+{
+  int x, y;
+};
+
+int nondet_int();
+
+int main()
+{
+  struct point p[4];
+  int i = nondet_int();
+  __ESBMC_assume(i >= 0 && i < 4);
+
+  for(int j = 0; j < 4; j++)
+  {
+    p[j].x = j;
+    p[j].y = j * 2;
+  }
+
+  // The same address-of and offset subterms get built over and over here.
+  int *px = &p[i].x, *py = &p[i].y;
+  assert(*py == 2 * *px);
+  assert(&p[i].x == px);
+  assert(*px != 3);
+  return 0;
+}
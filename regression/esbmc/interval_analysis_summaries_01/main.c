@@ -0,0 +1,28 @@
+#include <assert.h>
+
+int counter;
+
+void bump(void)
+{
+  if(counter < 100)
+    counter = counter + 1;
+}
+
+int fact(int n)
+{
+  if(n <= 1)
+    return 1;
+  return n * fact(n - 1);
+}
+
+int main()
+{
+  counter = 0;
+  bump();
+  bump();
+
+  int x = fact(3);
+  assert(counter == 2);
+  assert(x == 6);
+  return 0;
+}
@@ -0,0 +1,19 @@
+#include <assert.h>
+
+unsigned int limit;
+
+void set_limit(unsigned int v)
+{
+  limit = v;
+}
+
+int main()
+{
+  set_limit(10);
+
+  /* The summary of set_limit must forget the old value of limit */
+  limit = 5;
+  set_limit(20);
+  assert(limit == 5);
+  return 0;
+}
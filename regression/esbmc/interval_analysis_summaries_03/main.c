@@ -0,0 +1,59 @@
+#include <assert.h>
+
+int total;
+int parity;
+
+void leaf(void)
+{
+  total = total + 1;
+}
+
+/* Each level calls the one below twice, so many functions share callees */
+#define NODE(name, callee)                                                     \
+  void name(void)                                                              \
+  {                                                                            \
+    callee();                                                                  \
+    callee();                                                                  \
+  }
+
+NODE(n1, leaf)
+NODE(n2, n1)
+NODE(n3, n2)
+NODE(n4, n3)
+NODE(n5, n4)
+NODE(n6, n5)
+NODE(n7, n6)
+NODE(n8, n7)
+
+int is_odd(int n);
+
+int is_even(int n)
+{
+  if(n == 0)
+    return 1;
+  parity = parity + 1;
+  return is_odd(n - 1);
+}
+
+int is_odd(int n)
+{
+  if(n == 0)
+    return 0;
+  parity = parity + 1;
+  return is_even(n - 1);
+}
+
+int main()
+{
+  total = 0;
+  n8();
+
+  parity = 0;
+  int e = is_even(3);
+
+  /* Fails: a summary that kept the entry value of a global would turn
+     these into assumptions that hide it */
+  assert(e == 0 && parity == 3);
+  assert(total != 256);
+  return 0;
+}
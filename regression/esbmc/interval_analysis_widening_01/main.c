@@ -0,0 +1,24 @@
+#include <assert.h>
+
+int nondet_int();
+
+/* A termination check for the interval analysis: the counter grows on
+   every iteration, so the loop head only stabilises once widening drops
+   the upper bound of i. Without widening the analysis walks all 100000
+   values. The assertion fails after four iterations, and the assumes the
+   analysis adds keep that path only if the bound it inferred for i at the
+   loop head is sound. */
+int main()
+{
+  unsigned int i = 0;
+  unsigned int sum = 0;
+
+  while(i < 100000 && nondet_int())
+  {
+    sum = sum + 2;
+    i = i + 1;
+  }
+
+  assert(i < 4 || sum != 2 * i);
+  return 0;
+}
@@ -0,0 +1,14 @@
+#include <assert.h>
+
+int main()
+{
+  int i = 0;
+
+  /* Narrowing restores the bound of i that widening drops at the loop
+     head, the assumes it adds must still allow the failing path */
+  while(i < 10)
+    i = i + 1;
+
+  assert(i != 10);
+  return 0;
+}
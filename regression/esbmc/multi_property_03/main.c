@@ -0,0 +1,23 @@
+#include <assert.h>
+
+int nondet_int();
+
+int main()
+{
+  int x = 0;
+
+  /* Never terminates: the forward condition is satisfiable at every k, and
+   * the inductive step proves both claims */
+  while(1)
+  {
+    if(nondet_int())
+      x = 0;
+    else
+      x = 1;
+
+    assert(x == 0 || x == 1);
+    assert(x != 2);
+  }
+
+  return 0;
+}
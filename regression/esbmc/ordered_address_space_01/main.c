@@ -0,0 +1,26 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#define N 40
+
+int main()
+{
+  int *p[N];
+
+  for(int i = 0; i < N; i++)
+  {
+    p[i] = malloc(sizeof(int));
+    if(p[i] == NULL)
+      return 0;
+    *p[i] = i;
+  }
+
+  // Distinct objects never alias
+  for(int i = 0; i < N; i++)
+  {
+    assert(*p[i] == i);
+    free(p[i]);
+  }
+
+  return 0;
+}
@@ -0,0 +1,29 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#define N 8
+#define SIZE 16
+
+int main()
+{
+  unsigned long addr[N];
+
+  for(int i = 0; i < N; i++)
+  {
+    char *p = malloc(SIZE);
+    if(p == NULL)
+      return 0;
+    addr[i] = (unsigned long)p;
+  }
+
+  /* Holds only if no two objects share a byte: with overlapping objects
+     the solver could place two of them less than SIZE apart */
+  _Bool disjoint = 1;
+  for(int i = 0; i < N; i++)
+    for(int j = 0; j < N; j++)
+      if(i != j && addr[i] <= addr[j] && addr[j] < addr[i] + SIZE)
+        disjoint = 0;
+
+  assert(disjoint);
+  return 0;
+}
@@ -0,0 +1,31 @@
+#include <pthread.h>
+#include <assert.h>
+
+int x = 0;
+
+void *t1(void *arg)
+{
+  int tmp = x;
+  x = tmp + 1;
+  return NULL;
+}
+
+void *t2(void *arg)
+{
+  int tmp = x;
+  x = tmp + 1;
+  return NULL;
+}
+
+int main()
+{
+  pthread_t id1, id2;
+
+  pthread_create(&id1, NULL, t1, NULL);
+  pthread_create(&id2, NULL, t2, NULL);
+  pthread_join(id1, NULL);
+  pthread_join(id2, NULL);
+
+  assert(x == 2);
+  return 0;
+}
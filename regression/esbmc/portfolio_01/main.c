@@ -0,0 +1,14 @@
+#include <assert.h>
+
+unsigned int nondet_uint();
+
+int main()
+{
+  unsigned int x = nondet_uint();
+  unsigned int y = x * x;
+
+  if(x > 3 && x < 10)
+    assert(y != 49);
+
+  return 0;
+}
@@ -0,0 +1,18 @@
+#include <assert.h>
+
+unsigned int nondet_uint();
+
+int main()
+{
+  unsigned int x = nondet_uint();
+  unsigned int y = x ^ (x >> 1);
+
+  // Gray code round trip
+  unsigned int z = y;
+  for(unsigned int shift = 1; shift < 32; shift <<= 1)
+    z ^= z >> shift;
+
+  assert(z == x);
+
+  return 0;
+}
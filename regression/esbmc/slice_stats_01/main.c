@@ -0,0 +1,15 @@
+#include <assert.h>
+
+int nondet_int();
+
+int main()
+{
+  int a = nondet_int(), b = nondet_int(), unused = 0;
+  for(int i = 0; i < 4; i++)
+  {
+    unused += i * b;
+    a = a ^ (a << 1);
+  }
+  assert(a != 3);
+  return 0;
+}
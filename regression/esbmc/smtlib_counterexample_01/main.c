@@ -0,0 +1,13 @@
+#include <assert.h>
+
+int nondet_int();
+
+int main()
+{
+  int x = nondet_int();
+  int y = nondet_int();
+
+  /* Fails for exactly one model, which the trace must show */
+  assert(!(x == 1234 && y == x + 1));
+  return 0;
+}
@@ -0,0 +1,17 @@
+#include <assert.h>
+
+int nondet_int();
+
+int main()
+{
+  int n = nondet_int();
+  __ESBMC_assume(n >= 0 && n < 8);
+
+  /* Every bound is solved in the same solver process */
+  int sum = 0;
+  for(int i = 0; i < n; i++)
+    sum = sum + 2;
+
+  assert(sum == 2 * n);
+  return 0;
+}
@@ -0,0 +1,18 @@
+#include <assert.h>
+
+int nondet_int();
+
+int main()
+{
+  int x = nondet_int();
+  int a[4];
+
+  for(int i = 0; i < 4; i++)
+    a[i] = i * x;
+
+  assert(a[1] == x);     // holds
+  assert(a[2] != 4);     // fails for x == 2
+  assert(a[3] == 3 * x); // holds
+  assert(x != 7);        // fails
+  return 0;
+}
@@ -0,0 +1,11 @@
+#include <assert.h>
+
+int nondet_int();
+
+int main()
+{
+  int x = nondet_int();
+  int y = x + 1;
+  assert(y != 0);
+  return 0;
+}
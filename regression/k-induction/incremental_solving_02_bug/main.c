@@ -0,0 +1,12 @@
+unsigned int nondet_uint();
+
+int main()
+{
+  unsigned int x = 0, n = nondet_uint();
+
+  while(x < n)
+  {
+    x++;
+    assert(x != 6);
+  }
+}
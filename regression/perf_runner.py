@@ -0,0 +1,290 @@
+#!/usr/bin/env python3
+# -*- coding: UTF-8 -*-
+
+import argparse
+import datetime
+import json
+import os
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+from concurrent.futures import ProcessPoolExecutor, as_completed
+
+from testing_tool import SUPPORTED_TEST_MODES, FAIL_MODES, XMLTestCase, get_test_objects, matches_test_regex
+
+#####################
+# Performance Runner
+#####################
+
+# Summary
+# - Runs the test descriptions of one or more regression suites on a pool of processes, one test per job
+# - Records the wall time, CPU time and peak memory of every run of the tool, and its --stats-json output
+# - Appends every run to a history file, saves baselines and flags tests whose time or memory grew beyond a
+#   threshold compared to a baseline
+# - Only works where os.wait4 exists (Linux, macOS)
+
+# Thresholds are relative growth (0.25 = 25% more), and growth below the
+# minimum deltas is noise whatever the ratio.
+DEFAULT_TIME_THRESHOLD = 0.25
+DEFAULT_MEMORY_THRESHOLD = 0.25
+DEFAULT_MIN_TIME_DELTA = 0.5  # seconds
+DEFAULT_MIN_MEMORY_DELTA = 10 * 1024  # kB
+
+# Test ids are relative to this directory
+REGRESSION_DIR = os.path.dirname(os.path.abspath(__file__))
+
+
+def _max_rss_kb(usage) -> int:
+    # Linux reports kilobytes, macOS bytes
+    if sys.platform == "darwin":
+        return usage.ru_maxrss // 1024
+    return usage.ru_maxrss
+
+
+def run_once(tool: str, test_case, timeout: float, collect_stats: bool) -> dict:
+    """Runs the tool on test_case once, measuring that process alone"""
+    args = test_case.generate_run_argument_list(tool)
+
+    stats_path = None
+    if collect_stats:
+        fd, stats_path = tempfile.mkstemp(prefix="esbmc-stats-", suffix=".json")
+        os.close(fd)
+        args += ["--stats-json", stats_path]
+
+    with tempfile.TemporaryFile() as output:
+        start = time.monotonic()
+        process = subprocess.Popen(args, stdout=output, stderr=subprocess.STDOUT, cwd=test_case.test_dir)
+
+        timed_out = threading.Event()
+
+        def kill():
+            timed_out.set()
+            process.kill()
+
+        timer = threading.Timer(timeout, kill) if timeout else None
+        if timer:
+            timer.start()
+
+        # Unlike Popen.wait, wait4 gives the resource usage of this child only
+        _, status, usage = os.wait4(process.pid, 0)
+        wall = time.monotonic() - start
+        if timer:
+            timer.cancel()
+        process.returncode = os.WEXITSTATUS(status) if os.WIFEXITED(status) else -os.WTERMSIG(status)
+
+        output.seek(0)
+        text = output.read().decode(errors="replace")
+
+    stats = None
+    if stats_path:
+        try:
+            with open(stats_path) as fp:
+                stats = json.load(fp)
+        except (OSError, ValueError):
+            pass
+        os.remove(stats_path)
+
+    return {"output": text,
+            "returncode": process.returncode,
+            "timeout": timed_out.is_set(),
+            "wall": wall,
+            "cpu": usage.ru_utime + usage.ru_stime,
+            "rss_kb": _max_rss_kb(usage),
+            "stats": stats}
+
+
+def run_test(tool: str, suite: str, test_case, timeout: float, repeat: int, collect_stats: bool) -> dict:
+    """Runs one test, repeat times, keeping the fastest run and the smallest peak memory"""
+    runs = [run_once(tool, test_case, timeout, collect_stats) for _ in range(max(repeat, 1))]
+    best = min(runs, key=lambda r: r["wall"])
+
+    matches = matches_test_regex(test_case, best["output"])
+    passed = not best["timeout"] and (not matches if test_case.test_mode in FAIL_MODES else matches)
+
+    result = {"id": f"{suite}/{test_case.name}",
+              "mode": test_case.test_mode,
+              "passed": passed,
+              "timeout": best["timeout"],
+              "returncode": best["returncode"],
+              "wall": best["wall"],
+              "cpu": best["cpu"],
+              "rss_kb": min(r["rss_kb"] for r in runs),
+              "stats": best["stats"]}
+    if not passed:
+        result["output"] = best["output"]
+        result["arguments"] = test_case.generate_run_argument_list(tool)
+    return result
+
+
+def compare_to_baseline(results: list, baseline: dict,
+                        time_threshold: float = DEFAULT_TIME_THRESHOLD,
+                        memory_threshold: float = DEFAULT_MEMORY_THRESHOLD,
+                        min_time_delta: float = DEFAULT_MIN_TIME_DELTA,
+                        min_memory_delta: int = DEFAULT_MIN_MEMORY_DELTA) -> list:
+    """Lists the (test, metric, old, new) that grew beyond the thresholds,
+       worst first. Tests missing from the baseline are not compared."""
+    regressions = []
+    for result in results:
+        old = baseline.get(result["id"])
+        if old is None or not result["passed"]:
+            continue
+
+        for metric, threshold, min_delta in [("wall", time_threshold, min_time_delta),
+                                             ("rss_kb", memory_threshold, min_memory_delta)]:
+            before, after = old.get(metric), result[metric]
+            if before is None:
+                continue
+            if after - before >= min_delta and after > before * (1 + threshold):
+                regressions.append((result["id"], metric, before, after))
+
+    regressions.sort(key=lambda r: r[3] / max(r[2], 1e-9), reverse=True)
+    return regressions
+
+
+def summarise(results: list) -> dict:
+    """The part of the results kept in baselines and in the history"""
+    return {r["id"]: {"passed": r["passed"], "wall": r["wall"], "cpu": r["cpu"], "rss_kb": r["rss_kb"]}
+            for r in results}
+
+
+def load_baseline(path: str) -> dict:
+    with open(path) as fp:
+        return json.load(fp)["tests"]
+
+
+def save_baseline(path: str, tool: str, results: list):
+    with open(path, "w") as fp:
+        json.dump({"tool": tool,
+                   "date": datetime.datetime.now().isoformat(timespec="seconds"),
+                   "tests": summarise(results)}, fp, indent=1, sort_keys=True)
+
+
+def append_history(path: str, tool: str, results: list):
+    with open(path, "a") as fp:
+        fp.write(json.dumps({"tool": tool,
+                             "date": datetime.datetime.now().isoformat(timespec="seconds"),
+                             "tests": summarise(results)}, sort_keys=True))
+        fp.write("\n")
+
+
+def suite_id(suite: str) -> str:
+    """Names a suite by its path under the regression directory, or by its
+       directory name if it is elsewhere, so that test ids do not depend on
+       where the checkout is"""
+    path = os.path.relpath(os.path.abspath(suite), REGRESSION_DIR)
+    if path == os.curdir or path.startswith(os.pardir + os.sep):
+        return os.path.basename(os.path.normpath(os.path.abspath(suite)))
+    return path.replace(os.sep, "/")
+
+
+def collect_tests(suites: list, mode: str) -> list:
+    tests = []
+    for suite in suites:
+        for test_case in get_test_objects(suite):
+            if test_case.test_mode == mode or mode == "ALL":
+                tests.append((suite_id(suite), test_case))
+    return tests
+
+
+def _init_worker(library: str):
+    XMLTestCase.CPP_INCLUDE_DIR = library
+
+
+def run_all(tool: str, tests: list, jobs: int, timeout: float, repeat: int, collect_stats: bool,
+            baseline: dict = None) -> list:
+    # Longest first, as far as the baseline knows, so that a slow test does not start last
+    if baseline:
+        tests = sorted(tests, key=lambda t: baseline.get(f"{t[0]}/{t[1].name}", {}).get("wall", 0),
+                       reverse=True)
+
+    results = []
+    with ProcessPoolExecutor(max_workers=jobs, initializer=_init_worker,
+                             initargs=(XMLTestCase.CPP_INCLUDE_DIR,)) as pool:
+        futures = [pool.submit(run_test, tool, suite, test_case, timeout, repeat, collect_stats)
+                   for suite, test_case in tests]
+        for done, future in enumerate(as_completed(futures), 1):
+            result = future.result()
+            results.append(result)
+            status = "ok" if result["passed"] else ("TIMEOUT" if result["timeout"] else "FAIL")
+            print(f'[{done}/{len(futures)}] {result["id"]}: {status} '
+                  f'{result["wall"]:.2f}s {result["rss_kb"] // 1024}MB', flush=True)
+
+    results.sort(key=lambda r: r["id"])
+    return results
+
+
+def _arg_parsing():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--tool", required=True, help="tool executable path")
+    parser.add_argument("--regression", required=True, action="append",
+                        help="regression suite path, may be given several times")
+    parser.add_argument("--mode", default="CORE", choices=SUPPORTED_TEST_MODES, help="tests to be executed")
+    parser.add_argument("--library", required=False,
+                        help="Path for the Standard C++ Libraries abstractions")
+    parser.add_argument("-j", "--jobs", type=int, default=os.cpu_count(),
+                        help="number of tests to run at once (default: number of cores)")
+    parser.add_argument("--timeout", type=float, default=None, help="seconds before a test is killed")
+    parser.add_argument("--repeat", type=int, default=1,
+                        help="run every test this many times and keep the best figures")
+    parser.add_argument("--no-stats", action="store_true", help="do not pass --stats-json to the tool")
+    parser.add_argument("--baseline", help="compare with this baseline, if it exists")
+    parser.add_argument("--save-baseline", help="save the results of this run as a baseline")
+    parser.add_argument("--history", help="append the results of this run to this file")
+    parser.add_argument("--report", help="write the full results, with the tool statistics, as JSON")
+    parser.add_argument("--time-threshold", type=float, default=DEFAULT_TIME_THRESHOLD,
+                        help="relative time growth reported as a regression")
+    parser.add_argument("--memory-threshold", type=float, default=DEFAULT_MEMORY_THRESHOLD,
+                        help="relative peak memory growth reported as a regression")
+    parser.add_argument("--min-time-delta", type=float, default=DEFAULT_MIN_TIME_DELTA,
+                        help="seconds of growth below which time is not compared")
+    parser.add_argument("--min-memory-delta", type=int, default=DEFAULT_MIN_MEMORY_DELTA,
+                        help="kilobytes of growth below which memory is not compared")
+    return parser.parse_args()
+
+
+def main() -> int:
+    args = _arg_parsing()
+    XMLTestCase.CPP_INCLUDE_DIR = args.library
+
+    baseline = None
+    if args.baseline and os.path.exists(args.baseline):
+        baseline = load_baseline(args.baseline)
+    elif args.baseline:
+        print(f"No baseline at {args.baseline}, nothing to compare with")
+
+    tests = collect_tests(args.regression, args.mode)
+    print(f"Running {len(tests)} test cases on {args.jobs} jobs")
+    start = time.monotonic()
+    results = run_all(args.tool, tests, args.jobs, args.timeout, args.repeat, not args.no_stats, baseline)
+    elapsed = time.monotonic() - start
+
+    if args.report:
+        with open(args.report, "w") as fp:
+            json.dump(results, fp, indent=1)
+    if args.history:
+        append_history(args.history, args.tool, results)
+    if args.save_baseline:
+        save_baseline(args.save_baseline, args.tool, results)
+
+    failures = [r for r in results if not r["passed"]]
+    for r in failures:
+        print(f'\nFAILED: {r["id"]}\nARGUMENTS: {r["arguments"]}\n{r["output"]}')
+
+    regressions = []
+    if baseline is not None:
+        regressions = compare_to_baseline(results, baseline, args.time_threshold, args.memory_threshold,
+                                          args.min_time_delta, args.min_memory_delta)
+        for test, metric, before, after in regressions:
+            unit = "s" if metric == "wall" else "kB"
+            print(f"REGRESSION: {test}: {metric} {before:.2f}{unit} -> {after:.2f}{unit} "
+                  f"({after / max(before, 1e-9):.2f}x)")
+
+    print(f"\n{len(results) - len(failures)} passed, {len(failures)} failed, "
+          f"{len(regressions)} regression(s) in {elapsed:.1f}s")
+    return 1 if failures or regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
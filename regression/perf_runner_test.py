@@ -0,0 +1,86 @@
+import os
+import unittest
+from perf_runner import *
+from testing_tool import CTestCase
+
+
+def _result(test_id, wall, rss_kb, passed=True):
+    return {"id": test_id, "passed": passed, "wall": wall, "cpu": wall, "rss_kb": rss_kb}
+
+
+class CompareToBaseline(unittest.TestCase):
+    """Regressions are growth beyond both the relative threshold and the minimum delta"""
+
+    def setUp(self):
+        self.baseline = {"esbmc/a": {"wall": 2.0, "rss_kb": 100000},
+                         "esbmc/b": {"wall": 0.1, "rss_kb": 1000}}
+
+    def test_time_regression(self):
+        regressions = compare_to_baseline([_result("esbmc/a", 3.0, 100000)], self.baseline)
+        self.assertEqual(regressions, [("esbmc/a", "wall", 2.0, 3.0)])
+
+    def test_memory_regression(self):
+        regressions = compare_to_baseline([_result("esbmc/a", 2.0, 200000)], self.baseline)
+        self.assertEqual(regressions, [("esbmc/a", "rss_kb", 100000, 200000)])
+
+    def test_small_deltas_are_noise(self):
+        # 3x slower and 5x the memory, but by less than the minimum deltas
+        regressions = compare_to_baseline([_result("esbmc/b", 0.3, 5000)], self.baseline)
+        self.assertEqual(regressions, [])
+
+    def test_within_threshold(self):
+        regressions = compare_to_baseline([_result("esbmc/a", 2.4, 110000)], self.baseline)
+        self.assertEqual(regressions, [])
+
+    def test_new_and_failing_tests_are_skipped(self):
+        regressions = compare_to_baseline([_result("esbmc/c", 100.0, 10 ** 7),
+                                           _result("esbmc/a", 100.0, 10 ** 7, passed=False)], self.baseline)
+        self.assertEqual(regressions, [])
+
+    def test_worst_first(self):
+        regressions = compare_to_baseline([_result("esbmc/a", 3.0, 1000000)], self.baseline)
+        self.assertEqual([r[1] for r in regressions], ["rss_kb", "wall"])
+
+
+class SuiteId(unittest.TestCase):
+    """Test ids do not depend on where the checkout is, or on the working directory"""
+
+    def test_relative_to_regression_dir(self):
+        self.assertEqual(suite_id("esbmc"), "esbmc")
+        self.assertEqual(suite_id("./esbmc-cpp/cpp/"), "esbmc-cpp/cpp")
+        self.assertEqual(suite_id(os.path.join(REGRESSION_DIR, "esbmc")), "esbmc")
+
+    def test_elsewhere(self):
+        self.assertEqual(suite_id("/some/other/checkout/regression/esbmc"), "esbmc")
+
+    def test_collected_ids(self):
+        tests = collect_tests([os.path.join(REGRESSION_DIR, "esbmc")], "CORE")
+        self.assertIn("esbmc", {suite for suite, _ in tests})
+        self.assertEqual(len({suite for suite, _ in tests}), 1)
+
+
+class RunTest(unittest.TestCase):
+    """Runs a test description with a stand-in for the tool"""
+
+    def test_measurements(self):
+        test_case = CTestCase("./esbmc/00_bbuf_02", "00_bbuf_02")
+        result = run_test("echo", "esbmc", test_case, timeout=None, repeat=2, collect_stats=False)
+        self.assertEqual(result["id"], "esbmc/00_bbuf_02")
+        self.assertFalse(result["passed"])
+        self.assertFalse(result["timeout"])
+        self.assertIn("main.c", result["output"])
+        self.assertGreaterEqual(result["wall"], 0)
+        self.assertGreater(result["rss_kb"], 0)
+
+    def test_timeout(self):
+        test_case = CTestCase("./esbmc/00_bbuf_02", "00_bbuf_02")
+        test_case.test_file = "10"
+        test_case.test_args = ""
+        result = run_test("sleep", "esbmc", test_case, timeout=0.2, repeat=1, collect_stats=False)
+        self.assertTrue(result["timeout"])
+        self.assertFalse(result["passed"])
+        self.assertLess(result["wall"], 5)
+
+
+if __name__ == '__main__':
+    unittest.main()
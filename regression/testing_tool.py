@@ -8,6 +8,7 @@ import unittest
 from subprocess import Popen, PIPE
 import argparse
 import re
+import shlex
 import xml.etree.ElementTree as ET
 
 #####################
@@ -20,6 +21,7 @@ import xml.etree.ElementTree as ET
 # - Sadly unittest does not provide any multiprocessing out-of-box. In the future we can change to a package that
 #   extends unittest and adds multiprocessing e.g. nose, testtools. However, it will be an extra dependency on something
 #   that is not maintained by python itself.
+# - perf_runner.py runs the same test descriptions in parallel, and tracks their time and memory use
 
 # Dependencies (install through pip)
 # - unittest-xml-reporting
@@ -48,9 +50,9 @@ class BaseTest:
         """Generates run command list to be used in Popen"""
         result = [executable]
         result.append(self.test_file)
-        for x in self.test_args.split(" "):
-            if x != "":
-                result.append(x)
+        # Quotes keep an argument with spaces together, e.g. "z3 -in"
+        for x in shlex.split(self.test_args):
+            result.append(x)
         return result
 
     def mark_test_as_knownbug(self, issue: str):
@@ -225,6 +227,15 @@ class RegressionBase(unittest.TestCase):
     FAIL_WITH_WORD: str = None
 
 
+def matches_test_regex(test_case: BaseTest, output: str) -> bool:
+    """Whether the output matches every regex of the test description"""
+    for regex in test_case.test_regex:
+        match_regex = re.compile(regex, re.MULTILINE)
+        if not match_regex.search(output):
+            return False
+    return True
+
+
 def _add_test(test_case, executor):
     """This method returns a function that defines a test"""
 
@@ -237,11 +248,7 @@ def _add_test(test_case, executor):
         error_message = output_to_validate + "\n\nARGUMENTS: " + \
             str(test_case.generate_run_argument_list(executor.tool))
 
-        matches_regex = True
-        for regex in test_case.test_regex:
-            match_regex = re.compile(regex, re.MULTILINE)
-            if not match_regex.search(output_to_validate):
-                matches_regex = False
+        matches_regex = matches_test_regex(test_case, output_to_validate)
 
         if (test_case.test_mode in FAIL_MODES) and matches_regex:
             self.fail(error_message_prefix + error_message)
@@ -131,6 +131,30 @@ class CTest4(ParseTest):
         self.assertEqual(argument_list, expected, str(argument_list))
 
 
+class CTest5(ParseTest):
+    """Added testcase with a quoted argument"""
+
+    def setUp(self):
+        self.test_case: CTestCase = CTestCase(
+            "./esbmc/smtlib_counterexample_01", "smtlib_counterexample_01")
+        self.test_parsed: CTestCase = TestParser.from_file(
+            "./esbmc/smtlib_counterexample_01", "smtlib_counterexample_01")
+
+    def _read_file_checks(self, test_obj: BaseTest):
+        self.assertEqual(self.test_case.test_mode, "CORE")
+        self.assertEqual(self.test_case.test_file, "main.c")
+        self.assertEqual(self.test_case.test_args,
+                         '--smtlib --smtlib-solver-prog "z3 -in"')
+        self.assertEqual(self.test_case.test_regex[-1],
+                         "^VERIFICATION FAILED$")
+
+    def _argument_list_checks(self, test_obj: BaseTest):
+        argument_list = self.test_case.generate_run_argument_list("__test__")
+        expected = ['__test__', 'main.c', '--smtlib', '--smtlib-solver-prog',
+                    'z3 -in']
+        self.assertEqual(argument_list, expected, str(argument_list))
+
+
 class XMLTest1(ParseTest):
     """Added testcase with multiple white spaces in description"""
 
@@ -30,12 +30,14 @@ option(ENABLE_Z3 "Use Z3 solver (default: OFF)" OFF)
 option(ENABLE_MATHSAT "Use MathSAT solver (default: OFF)" OFF)
 option(ENABLE_YICES "Use Yices solver (default: OFF)" OFF)
 option(ENABLE_CVC4 "Use CVC4 solver (default: OFF)" OFF)
+option(ENABLE_CADICAL "Use CaDiCaL SAT solver (default: OFF)" OFF)
 
 #############################
 # OTHERS
 #############################
 option(ENABLE_LIBM "Use libm from c2goto (default: ON)" ON)
 option(ENABLE_FUZZER "Add fuzzing targets (default: OFF)" OFF)
+option(ENABLE_BENCHMARK "Add benchmark targets (default: OFF)" OFF)
 option(ENABLE_CLANG_TIDY "Activate clang tidy analysis (default: OFF)" OFF)
 
 #############################
@@ -6,21 +6,11 @@ Author: Daniel Kroening, kroening@kroening.com
 
 \*******************************************************************/
 
-extern "C"
-{
-#include <unistd.h>
-
-#ifdef _WIN32
-#include <windows.h>
-#include <io.h>
-#undef small // MinGW header workaround
-#endif
-}
-
 #include <c2goto/cprover_library.h>
 #include <cstdlib>
-#include <fstream>
-#include <goto-programs/read_goto_binary.h>
+#include <goto-programs/read_bin_goto_object.h>
+#include <streambuf>
+#include <unordered_set>
 #include <util/c_link.h>
 #include <util/config.h>
 
@@ -142,20 +132,31 @@ void add_cprover_library(
 
 #else
 
+namespace
+{
+// Read-only stream buffer over one of the embedded C library images.
+class clib_streambuft : public std::streambuf
+{
+public:
+  clib_streambuft(uint8_t *start, uint64_t size)
+  {
+    char *p = reinterpret_cast<char *>(start);
+    setg(p, p, p + size);
+  }
+};
+} // namespace
+
 void add_cprover_library(contextt &context, message_handlert &message_handler)
 {
   if(config.ansi_c.lib == configt::ansi_ct::libt::LIB_NONE)
     return;
 
   contextt new_ctx, store_ctx;
-  goto_functionst goto_functions;
   std::multimap<irep_idt, irep_idt> symbol_deps;
+  std::unordered_set<irep_idt, irep_id_hash> scanned;
   std::list<irep_idt> to_include;
-  char symname_buffer[288];
-  FILE *f;
   uint8_t **this_clib_ptrs;
   uint64_t size;
-  int fd;
 
   if(config.ansi_c.word_size == 32)
   {
@@ -200,36 +201,16 @@ void add_cprover_library(contextt &context, message_handlert &message_handler)
     abort();
   }
 
-#ifndef _WIN32
-  sprintf(symname_buffer, "/tmp/ESBMC_XXXXXX");
-  fd = mkstemp(symname_buffer);
-  close(fd);
-#else
-  char tmpdir[256];
-  GetTempPath(sizeof(tmpdir), tmpdir);
-  GetTempFileName(tmpdir, "bmc", 0, symname_buffer);
-#endif
-  f = fopen(symname_buffer, "wb");
-  if(fwrite(this_clib_ptrs[0], size, 1, f) != 1)
+  // Deserialise the library's symbol table straight out of the embedded
+  // buffer. The goto function bodies it also carries are never used here,
+  // so reading stops before them.
+  clib_streambuft clib_buf(this_clib_ptrs[0], size);
+  std::istream infile(&clib_buf);
+  if(read_bin_goto_symbols(infile, "", new_ctx, message_handler))
   {
-    std::cerr << "Couldn't manipulate internal C library" << std::endl;
+    std::cerr << "Couldn't read internal C library" << std::endl;
     abort();
   }
-  fclose(f);
-
-  std::ifstream infile(symname_buffer, std::ios::in | std::ios::binary);
-  read_goto_binary(infile, new_ctx, goto_functions, message_handler);
-  infile.close();
-#ifndef _WIN32
-  unlink(symname_buffer);
-#else
-  DeleteFile(symname_buffer);
-#endif
-
-  new_ctx.foreach_operand([&symbol_deps](const symbolt &s) {
-    generate_symbol_deps(s.id, s.value, symbol_deps);
-    generate_symbol_deps(s.id, s.type, symbol_deps);
-  });
 
   // Add two hacks; we migth use either pthread_mutex_lock or the checked
   // variety; so if one version is used, pull in the other too.
@@ -245,20 +226,29 @@ void add_cprover_library(contextt &context, message_handlert &message_handler)
     dstring("pthread_join"), dstring("pthread_join_noswitch"));
   symbol_deps.insert(joincheck);
 
+  // Dependencies are only computed for library symbols that actually get
+  // pulled in, rather than for the whole library up front.
+  auto pull_in =
+    [&store_ctx, &symbol_deps, &scanned, &to_include](const symbolt &s) {
+      store_ctx.add(s);
+      if(scanned.insert(s.id).second)
+      {
+        generate_symbol_deps(s.id, s.value, symbol_deps);
+        generate_symbol_deps(s.id, s.type, symbol_deps);
+      }
+      ingest_symbol(s.id, symbol_deps, to_include);
+    };
+
   /* The code just pulled into store_ctx might use other symbols in the C
    * library. So, repeatedly search for new C library symbols that we use but
    * haven't pulled in, then pull them in. We finish when we've made a pass
    * that adds no new symbols. */
 
-  new_ctx.foreach_operand(
-    [&context, &store_ctx, &symbol_deps, &to_include](const symbolt &s) {
-      const symbolt *symbol = context.find_symbol(s.id);
-      if(symbol != nullptr && symbol->value.is_nil())
-      {
-        store_ctx.add(s);
-        ingest_symbol(s.id, symbol_deps, to_include);
-      }
-    });
+  new_ctx.foreach_operand([&context, &pull_in](const symbolt &s) {
+    const symbolt *symbol = context.find_symbol(s.id);
+    if(symbol != nullptr && symbol->value.is_nil())
+      pull_in(s);
+  });
 
   for(std::list<irep_idt>::const_iterator nameit = to_include.begin();
       nameit != to_include.end();
@@ -266,10 +256,7 @@ void add_cprover_library(contextt &context, message_handlert &message_handler)
   {
     symbolt *s = new_ctx.find_symbol(*nameit);
     if(s != nullptr)
-    {
-      store_ctx.add(*s);
-      ingest_symbol(*nameit, symbol_deps, to_include);
-    }
+      pull_in(*s);
   }
 
   if(c_link(context, store_ctx, message_handler, "<built-in-library>"))
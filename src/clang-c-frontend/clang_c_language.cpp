@@ -8,7 +8,6 @@ Author: Daniel Kroening, kroening@cs.cmu.edu
 
 #include <AST/build_ast.h>
 #include <ansi-c/c_preprocess.h>
-#include <boost/filesystem.hpp>
 #include <c2goto/cprover_library.h>
 #include <clang-c-frontend/clang_c_adjust.h>
 #include <clang-c-frontend/clang_c_convert.h>
@@ -25,31 +24,9 @@ languaget *new_clang_c_language()
 
 clang_c_languaget::clang_c_languaget()
 {
-  // Create a temporary directory, to dump clang's headers
-  auto p = boost::filesystem::temp_directory_path();
-  if(!boost::filesystem::exists(p) || !boost::filesystem::is_directory(p))
-  {
-    std::cerr << "Can't find temporary directory (needed to dump clang headers)"
-              << std::endl;
-    abort();
-  }
-
-  // Create temporary directory
-  p += "/esbmc_clang_headers";
-  boost::filesystem::create_directory(p);
-  if(!boost::filesystem::is_directory(p))
-  {
-    std::cerr
-      << "Can't create temporary directory (needed to dump clang headers)"
-      << std::endl;
-    abort();
-  }
-
-  // Build the compile arguments
-  build_compiler_args(std::move(p.string()));
-
-  // Dump clang headers on the temporary folder
-  dump_clang_headers(p.string());
+  // Dump clang headers on the temporary folder, or find them from an earlier
+  // run, and build the compile arguments
+  build_compiler_args(dump_clang_headers());
 }
 
 void clang_c_languaget::build_compiler_args(const std::string &&tmp_dir)
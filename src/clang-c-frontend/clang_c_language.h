@@ -72,7 +72,8 @@ protected:
   virtual std::string internal_additions();
   virtual void force_file_type();
 
-  void dump_clang_headers(const std::string &tmp_dir);
+  // Returns the directory holding clang's headers
+  std::string dump_clang_headers();
   void build_compiler_args(const std::string &&tmp_dir);
 
   std::vector<std::string> compiler_args;
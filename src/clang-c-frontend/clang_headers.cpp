@@ -1,5 +1,9 @@
+#include <boost/filesystem.hpp>
 #include <clang-c-frontend/clang_c_language.h>
+#include <cstring>
 #include <fstream>
+#include <iostream>
+#include <util/crypto_hash.h>
 
 struct hooked_header
 {
@@ -597,18 +601,97 @@ extern "C"
     {nullptr, nullptr, nullptr}};
 }
 
-void clang_c_languaget::dump_clang_headers(const std::string &tmp_dir)
+/// Whether dir holds every header, at its full size. Cleaners of the
+/// temporary directory may remove old files and leave the directory.
+static bool clang_headers_complete(const boost::filesystem::path &dir)
 {
-  static bool dumped = false;
-  if(dumped)
-    return;
-  dumped = true;
+  boost::system::error_code ec;
+  for(struct hooked_header *h = &clang_headers[0]; h->basename != nullptr; h++)
+  {
+    boost::uintmax_t size = boost::filesystem::file_size(dir / h->basename, ec);
+    if(ec || size != *h->textsize)
+      return false;
+  }
+
+  return true;
+}
+
+std::string clang_c_languaget::dump_clang_headers()
+{
+  static std::string dir;
+  if(!dir.empty())
+    return dir;
+
+  auto tmp = boost::filesystem::temp_directory_path();
+  if(!boost::filesystem::exists(tmp) || !boost::filesystem::is_directory(tmp))
+  {
+    std::cerr << "Can't find temporary directory (needed to dump clang headers)"
+              << std::endl;
+    abort();
+  }
 
+  // The headers only change with the ESBMC binary, so name the directory
+  // after their contents: every run of the same build finds them already
+  // there, and different builds never see each other's headers.
+  crypto_hash hash;
   for(struct hooked_header *h = &clang_headers[0]; h->basename != nullptr; h++)
   {
-    std::ofstream header;
-    header.open(tmp_dir + "/" + std::string(h->basename));
-    header << std::string(h->textstart, *h->textsize);
-    header.close();
+    hash.ingest(h->basename, strlen(h->basename) + 1);
+    hash.ingest(h->textsize, sizeof(*h->textsize));
+    hash.ingest(h->textstart, *h->textsize);
+  }
+  hash.fin();
+
+  boost::filesystem::path p = tmp / ("esbmc-clang-headers-" + hash.to_string());
+  dir = p.string();
+  if(clang_headers_complete(p))
+    return dir;
+
+  // Write to a private directory and rename it into place, so that a run
+  // never sees a partially written cache, even with others racing it.
+  boost::system::error_code ec;
+  boost::filesystem::path staging =
+    tmp / boost::filesystem::unique_path("esbmc-clang-headers-%%%%-%%%%-%%%%");
+  if(!boost::filesystem::create_directory(staging, ec) || ec)
+  {
+    std::cerr
+      << "Can't create temporary directory (needed to dump clang headers)"
+      << std::endl;
+    abort();
   }
+
+  for(struct hooked_header *h = &clang_headers[0]; h->basename != nullptr; h++)
+  {
+    std::ofstream header((staging / h->basename).string(), std::ios::binary);
+    header.write(h->textstart, *h->textsize);
+    if(!header)
+    {
+      std::cerr << "Can't write clang header " << h->basename << std::endl;
+      abort();
+    }
+  }
+
+  // Move a pruned cache out of the way, unless another run replaced it
+  if(boost::filesystem::exists(p) && !clang_headers_complete(p))
+  {
+    boost::filesystem::path stale = tmp / boost::filesystem::unique_path(
+      "esbmc-clang-headers-%%%%-%%%%-%%%%");
+    boost::filesystem::rename(p, stale, ec);
+    if(!ec)
+      boost::filesystem::remove_all(stale, ec);
+  }
+
+  boost::filesystem::rename(staging, p, ec);
+  if(ec)
+  {
+    // Another run got there first, its copy is just as good
+    boost::filesystem::remove_all(staging, ec);
+    if(!clang_headers_complete(p))
+    {
+      std::cerr << "Can't create clang header cache " << dir << std::endl;
+      abort();
+    }
+  }
+
+  return dir;
 }
@@ -11,6 +11,8 @@ Authors: Daniel Kroening, kroening@kroening.com
 #include <sys/types.h>
 
 #ifndef _WIN32
+#include <fcntl.h>
+#include <sys/wait.h>
 #include <unistd.h>
 #else
 #include <windows.h>
@@ -32,6 +34,7 @@ Authors: Daniel Kroening, kroening@kroening.com
 #include <langapi/language_util.h>
 #include <langapi/languages.h>
 #include <langapi/mode.h>
+#include <set>
 #include <sstream>
 #include <util/i2string.h>
 #include <util/irep2.h>
@@ -39,6 +42,7 @@ Authors: Daniel Kroening, kroening@kroening.com
 #include <util/message_stream.h>
 #include <util/migrate.h>
 #include <util/show_symbol_table.h>
+#include <util/stats.h>
 #include <util/time_stopping.h>
 
 bmct::bmct(
@@ -54,6 +58,9 @@ bmct::bmct(
 {
   interleaving_number = 0;
   interleaving_failed = 0;
+  trace_reported = false;
+  ileave_workers =
+    strtoul(options.get_option("parallel-ileaves").c_str(), nullptr, 10);
 
   if(options.get_bool_option("smt-during-symex"))
   {
@@ -128,6 +135,21 @@ void bmct::successful_trace()
   }
 }
 
+// Files what conv reports about the solve it just did, for --stats-json
+static void account_solve(smt_convt &conv)
+{
+  std::vector<std::pair<std::string, std::string>> values;
+  values.emplace_back("smt_asts", std::to_string(conv.live_ast_count()));
+  values.emplace_back("smt_cache_hits", std::to_string(conv.cache_hits));
+
+  std::vector<std::pair<std::string, std::string>> reported =
+    conv.solver_statistics();
+  values.insert(values.end(), reported.begin(), reported.end());
+
+  stats.add_solver_stats(conv.solver_text(), values);
+  stats.add_count("solver-calls");
+}
+
 void bmct::error_trace(
   std::shared_ptr<smt_convt> &smt_conv,
   std::shared_ptr<symex_target_equationt> &eq)
@@ -138,7 +160,9 @@ void bmct::error_trace(
   status("Building error trace");
 
   goto_tracet goto_trace;
+  stats_phaset trace_phase("trace");
   build_goto_trace(eq, smt_conv, goto_trace);
+  trace_phase.stop();
 
   switch(ui)
   {
@@ -188,9 +212,11 @@ smt_convt::resultt bmct::run_decision_procedure(
   smt_conv->set_message_handler(message_handler);
   smt_conv->set_verbosity(get_verbosity());
 
+  stats_phaset encode_phase("conversion");
   fine_timet encode_start = current_time();
   do_cbmc(smt_conv, eq);
   fine_timet encode_stop = current_time();
+  encode_phase.stop();
 
   std::ostringstream str;
   str << "Encoding to solver time: ";
@@ -211,9 +237,12 @@ smt_convt::resultt bmct::run_decision_procedure(
   ss << "Solving with solver " << smt_conv->solver_text();
   status(ss.str());
 
+  stats_phaset sat_phase("solving");
   fine_timet sat_start = current_time();
   smt_convt::resultt dec_result = smt_conv->dec_solve();
   fine_timet sat_stop = current_time();
+  sat_phase.stop();
+  account_solve(*smt_conv);
 
   // output runtime
   str.clear();
@@ -462,7 +491,18 @@ smt_convt::resultt bmct::start_bmc()
 {
   std::shared_ptr<symex_target_equationt> eq;
   smt_convt::resultt res = run(eq);
-  report_trace(res, eq);
+
+  // With --parallel-ileaves or --portfolio the counterexample was built by
+  // the worker that owned the solver, this process never held a model. With
+  // --multi-property every violated claim got its trace while it was solved
+  if(!(trace_reported && res == smt_convt::P_SATISFIABLE))
+    report_trace(res, eq);
+
+  // Solving and trace building are done: hand the SSA arena and the stack
+  // trace table back now rather than when symex next replaces the target
+  if(eq)
+    eq->clear();
+
   report_result(res);
   return res;
 }
@@ -475,9 +515,15 @@ smt_convt::resultt bmct::run(std::shared_ptr<symex_target_equationt> &eq)
   if(options.get_bool_option("schedule"))
     return run_thread(eq);
 
+#ifndef _WIN32
+  if(ileave_workers > 1)
+    return run_parallel_ileaves(eq);
+#endif
+
   smt_convt::resultt res;
   do
   {
+    stats.add_count("interleavings");
     if(++interleaving_number > 1)
     {
       std::cout << "*** Thread interleavings " << interleaving_number << " ***"
@@ -487,7 +533,7 @@ smt_convt::resultt bmct::run(std::shared_ptr<symex_target_equationt> &eq)
     fine_timet bmc_start = current_time();
     res = run_thread(eq);
 
-    if(res == smt_convt::P_SATISFIABLE)
+    if(res == smt_convt::P_SATISFIABLE && !trace_reported)
     {
       if(config.options.get_bool_option("smt-model"))
         runtime_solver->print_model();
@@ -531,10 +577,13 @@ void bmct::bidirectional_search(
        options.get_bool_option("k-induction")))
     return;
 
+  // Everything below reads the one model the solver holds
+  smt_convt::model_batcht batch(*smt_conv);
+
   // We'll walk list of SSA steps and look for inductive assignments
   std::vector<stack_framet> frames;
   unsigned assert_loop_number = 0;
-  for(auto ssait : eq->SSA_steps)
+  for(const auto &ssait : eq->SSA_steps)
   {
     if(ssait.is_assert() && smt_conv->l_get(ssait.cond_ast).is_false())
     {
@@ -542,7 +591,7 @@ void bmct::bidirectional_search(
         return;
 
       // Save the location of the failed assertion
-      frames = ssait.stack_trace;
+      frames = ssait.get_stack_trace();
       assert_loop_number = ssait.loop_number;
 
       // We are not interested in instructions before the failed assertion yet
@@ -589,7 +638,7 @@ void bmct::bidirectional_search(
     std::unordered_map<irep_idt, std::pair<expr2tc, expr2tc>, irep_id_hash>
       var_ssa_list;
 
-    for(auto ssait : eq->SSA_steps)
+    for(const auto &ssait : eq->SSA_steps)
     {
       if(ssait.loop_number == lit->get_original_loop_head()->loop_number)
         break;
@@ -655,6 +704,17 @@ smt_convt::resultt bmct::run_thread(std::shared_ptr<symex_target_equationt> &eq)
 {
   std::shared_ptr<goto_symext::symex_resultt> result;
 
+  if(generate_formula(result, eq))
+    return smt_convt::P_ERROR;
+
+  return solve_formula(result, eq);
+}
+
+bool bmct::generate_formula(
+  std::shared_ptr<goto_symext::symex_resultt> &result,
+  std::shared_ptr<symex_target_equationt> &eq)
+{
+  stats_phaset symex_phase("symex");
   fine_timet symex_start = current_time();
   try
   {
@@ -672,25 +732,27 @@ smt_convt::resultt bmct::run_thread(std::shared_ptr<symex_target_equationt> &eq)
   {
     message_streamt message_stream(*get_message_handler());
     message_stream.error(error_str);
-    return smt_convt::P_ERROR;
+    return true;
   }
 
   catch(const char *error_str)
   {
     message_streamt message_stream(*get_message_handler());
     message_stream.error(error_str);
-    return smt_convt::P_ERROR;
+    return true;
   }
 
   catch(std::bad_alloc &)
   {
     std::cout << "Out of memory" << std::endl;
-    return smt_convt::P_ERROR;
+    return true;
   }
 
   fine_timet symex_stop = current_time();
+  symex_phase.stop();
 
   eq = std::dynamic_pointer_cast<symex_target_equationt>(result->target);
+  stats.add_count("ssa-steps", eq->SSA_steps.size());
 
   {
     std::ostringstream str;
@@ -701,18 +763,36 @@ smt_convt::resultt bmct::run_thread(std::shared_ptr<symex_target_equationt> &eq)
     status(str.str());
   }
 
+  return false;
+}
+
+smt_convt::resultt bmct::solve_formula(
+  std::shared_ptr<goto_symext::symex_resultt> &result,
+  std::shared_ptr<symex_target_equationt> &eq)
+{
+  trace_reported = false;
+
   if(options.get_bool_option("double-assign-check"))
     eq->check_for_duplicate_assigns();
 
   try
   {
+    stats_phaset slice_phase("slicing");
     fine_timet slice_start = current_time();
     BigInt ignored;
+    size_t slice_bytes = 0;
     if(!options.get_bool_option("no-slice"))
-      ignored = slice(eq, options.get_bool_option("slice-assumes"));
+    {
+      symex_slicet symex_slice(options.get_bool_option("slice-assumes"));
+      symex_slice.slice(eq);
+      ignored = symex_slice.ignored;
+      slice_bytes = symex_slice.depends.peak_bytes();
+    }
     else
       ignored = simple_slice(eq);
     fine_timet slice_stop = current_time();
+    slice_phase.stop();
+    stats.add_count("sliced-steps", ignored.to_uint64());
 
     {
       std::ostringstream str;
@@ -723,6 +803,17 @@ smt_convt::resultt bmct::run_thread(std::shared_ptr<symex_target_equationt> &eq)
       status(str.str());
     }
 
+    if(options.get_bool_option("slice-stats"))
+    {
+      // current_time() has millisecond resolution
+      fine_timet elapsed = std::max(slice_stop - slice_start, fine_timet(1));
+      std::ostringstream str;
+      str << "Slicing stats: " << eq->SSA_steps.size() << " steps, "
+          << (eq->SSA_steps.size() * 1000) / elapsed << " steps/s, "
+          << slice_bytes << " bytes in dependency set";
+      status(str.str());
+    }
+
     if(
       options.get_bool_option("program-only") ||
       options.get_bool_option("program-too"))
@@ -733,6 +824,8 @@ smt_convt::resultt bmct::run_thread(std::shared_ptr<symex_target_equationt> &eq)
 
     {
       std::ostringstream str;
+      stats.add_count("vccs", result->total_claims);
+      stats.add_count("remaining-vccs", result->remaining_claims);
       str << "Generated " << result->total_claims << " VCC(s), ";
       str << result->remaining_claims << " remaining after simplification ";
       str << "(" << BigInt(eq->SSA_steps.size()) - ignored << " assignments)";
@@ -763,10 +856,23 @@ smt_convt::resultt bmct::run_thread(std::shared_ptr<symex_target_equationt> &eq)
       return smt_convt::P_UNSATISFIABLE;
     }
 
+    if(options.get_bool_option("multi-property"))
+      return run_multi_property(eq);
+
+    if(incremental && !incremental->disabled)
+      return run_incremental(eq);
+
     if(!options.get_bool_option("smt-during-symex"))
     {
+      std::string solver_name;
+
+#ifndef _WIN32
+      if(!options.get_option("portfolio").empty())
+        return run_portfolio(eq, solver_name);
+#endif
+
       runtime_solver = std::shared_ptr<smt_convt>(create_solver_factory(
-        "", options.get_bool_option("int-encoding"), ns, options));
+        solver_name, options.get_bool_option("int-encoding"), ns, options));
     }
 
     return run_decision_procedure(runtime_solver, eq);
@@ -790,3 +896,773 @@ smt_convt::resultt bmct::run_thread(std::shared_ptr<symex_target_equationt> &eq)
     return smt_convt::P_ERROR;
   }
 }
+
+static bool same_ssa_step(
+  const symex_target_equationt::SSA_stept &a,
+  const symex_target_equationt::SSA_stept &b)
+{
+  return a.type == b.type && a.guard == b.guard && a.lhs == b.lhs &&
+         a.rhs == b.rhs && a.cond == b.cond && a.output_args == b.output_args;
+}
+
+smt_convt::resultt
+bmct::run_incremental(std::shared_ptr<symex_target_equationt> &eq)
+{
+  incremental_solvert &inc = *incremental;
+  symex_target_equationt::SSA_stepst &steps = eq->SSA_steps;
+
+  // How many leading steps does this program share with the last one?
+  size_t common = 0;
+  {
+    auto it = steps.begin();
+    while(
+      common < inc.prev_steps.size() && it != steps.end() &&
+      same_ssa_step(inc.prev_steps[common], *it))
+    {
+      ++common;
+      ++it;
+    }
+  }
+
+  if(inc.solver && common < inc.base_steps.size())
+  {
+    status("Program no longer extends the asserted prefix, restarting solver");
+    inc.solver.reset();
+  }
+
+  if(!inc.solver)
+  {
+    inc.solver = std::shared_ptr<smt_convt>(create_solver_factory(
+      "", options.get_bool_option("int-encoding"), inc.ns, options));
+
+    if(!inc.solver->solver_push_pop())
+    {
+      warning(
+        "Solver " + inc.solver->solver_text() +
+        " can't push and pop assertions, solving every bound from scratch");
+      inc.solver.reset();
+      inc.disabled = true;
+      runtime_solver = std::shared_ptr<smt_convt>(create_solver_factory(
+        "", options.get_bool_option("int-encoding"), ns, options));
+      return run_decision_procedure(runtime_solver, eq);
+    }
+
+    inc.base_steps.clear();
+    inc.base_assertions.clear();
+    inc.base_assumpt = inc.solver->convert_ast(gen_true_expr());
+    inc.pushed = false;
+  }
+  else if(inc.pushed)
+  {
+    inc.solver->pop_ctx();
+    inc.pushed = false;
+  }
+
+  smt_convt &conv = *inc.solver;
+  conv.set_message_handler(message_handler);
+  conv.set_verbosity(get_verbosity());
+
+  {
+    std::ostringstream str;
+    str << "Encoding " << steps.size() - inc.base_steps.size() << " of "
+        << steps.size() << " SSA steps, the rest is already in the solver";
+    status(str.str());
+  }
+
+  stats_phaset encode_phase("conversion");
+  fine_timet encode_start = current_time();
+
+  // Shared steps not asserted yet join the base. They are converted unsliced:
+  // what the slicer drops depends on the claims of one particular bound.
+  auto it = steps.begin();
+  for(size_t i = 0; i < common; ++i, ++it)
+  {
+    if(i == inc.base_steps.size())
+    {
+      symex_target_equationt::SSA_stept step = *it;
+      step.ignore = false;
+      eq->convert_internal_step(
+        conv, inc.base_assumpt, inc.base_assertions, step);
+      inc.base_steps.push_back(step);
+    }
+
+    if(it->ignore)
+    {
+      it->cond_ast = conv.convert_ast(gen_true_expr());
+      it->guard_ast = conv.convert_ast(gen_false_expr());
+    }
+    else
+    {
+      it->guard_ast = inc.base_steps[i].guard_ast;
+      it->cond_ast = inc.base_steps[i].cond_ast;
+      it->converted_output_args = inc.base_steps[i].converted_output_args;
+    }
+  }
+
+  conv.push_ctx();
+  inc.pushed = true;
+
+  smt_astt assumpt = inc.base_assumpt;
+  smt_convt::ast_vec assertions = inc.base_assertions;
+  for(; it != steps.end(); ++it)
+    eq->convert_internal_step(conv, assumpt, assertions, *it);
+
+  if(!assertions.empty())
+    conv.assert_ast(conv.make_n_ary(&conv, &smt_convt::mk_or, assertions));
+
+  inc.prev_steps.assign(steps.begin(), steps.end());
+
+  fine_timet encode_stop = current_time();
+  encode_phase.stop();
+  {
+    std::ostringstream str;
+    str << "Encoding to solver time: ";
+    output_time(encode_stop - encode_start, str);
+    str << "s";
+    status(str.str());
+  }
+
+  runtime_solver = inc.solver;
+  status("Solving with solver " + conv.solver_text());
+
+  stats_phaset sat_phase("solving");
+  fine_timet sat_start = current_time();
+  smt_convt::resultt dec_result = conv.dec_solve();
+  fine_timet sat_stop = current_time();
+  sat_phase.stop();
+  account_solve(conv);
+
+  {
+    std::ostringstream str;
+    str << "\nRuntime decision procedure: ";
+    output_time(sat_stop - sat_start, str);
+    str << "s";
+    status(str.str());
+  }
+
+  return dec_result;
+}
+
+namespace
+{
+/* One claim of --multi-property: every SSA assertion produced by the same
+ * assert instruction, e.g. once per loop unwinding. */
+struct multi_claimt
+{
+  goto_programt::const_targett pc;
+  std::string comment;
+  std::vector<symex_target_equationt::SSA_stept *> instances;
+  bool failed = false;
+};
+} // namespace
+
+smt_convt::resultt
+bmct::run_multi_property(std::shared_ptr<symex_target_equationt> &eq)
+{
+  runtime_solver = std::shared_ptr<smt_convt>(create_solver_factory(
+    "", options.get_bool_option("int-encoding"), ns, options));
+
+  if(!runtime_solver->solver_push_pop())
+  {
+    warning(
+      "Solver " + runtime_solver->solver_text() +
+      " can't push and pop assertions, checking all claims at once");
+    return run_decision_procedure(runtime_solver, eq);
+  }
+
+  // Every violated claim gets its trace below, while its model is current
+  trace_reported = true;
+
+  smt_convt &conv = *runtime_solver;
+  conv.set_message_handler(message_handler);
+  conv.set_verbosity(get_verbosity());
+
+  // Encode the program once. The claims are not asserted here, each round
+  // asserts the ones that are still open in a context of its own.
+  stats_phaset encode_phase("conversion");
+  fine_timet encode_start = current_time();
+
+  smt_astt assumpt = conv.convert_ast(gen_true_expr());
+  smt_convt::ast_vec unused;
+  std::vector<multi_claimt> claims;
+  std::map<const goto_programt::instructiont *, size_t> claim_of_pc;
+
+  for(auto &step : eq->SSA_steps)
+  {
+    eq->convert_internal_step(conv, assumpt, unused, step);
+
+    if(!step.is_assert() || step.ignore)
+      continue;
+
+    auto ins = claim_of_pc.emplace(&*step.source.pc, claims.size());
+    if(ins.second)
+    {
+      claims.emplace_back();
+      claims.back().pc = step.source.pc;
+      claims.back().comment = step.comment;
+    }
+    claims[ins.first->second].instances.push_back(&step);
+  }
+
+  fine_timet encode_stop = current_time();
+  encode_phase.stop();
+  {
+    std::ostringstream str;
+    str << "Encoding to solver time: ";
+    output_time(encode_stop - encode_start, str);
+    str << "s";
+    status(str.str());
+  }
+
+  status(
+    "Checking " + i2string((unsigned long)claims.size()) +
+    " claim(s) with solver " + conv.solver_text());
+
+  // In the forward condition and the inductive step a model is no
+  // violation, it only means the step can't prove the claims: one is enough,
+  // and there is no per-claim verdict to give.
+  bool step = options.get_bool_option("inductive-step") ||
+              options.get_bool_option("forward-condition");
+
+  // Traces are printed under the same conditions as report_trace does
+  bool show_traces = (!options.get_bool_option("base-case") &&
+                      options.get_bool_option("show-cex")) ||
+                     !step;
+
+  std::list<size_t> open;
+  for(size_t i = 0; i < claims.size(); i++)
+    open.push_back(i);
+
+  // Each round asks for a model violating any open claim. Every claim that
+  // model violates is reported and retired, so the next round only looks
+  // for violations of the others; once no model is left, every open claim
+  // holds.
+  unsigned int rounds = 0;
+  smt_convt::resultt res = smt_convt::P_UNSATISFIABLE;
+  stats_phaset sat_phase("solving");
+  fine_timet sat_start = current_time();
+  while(!open.empty())
+  {
+    conv.push_ctx();
+
+    smt_convt::ast_vec violations;
+    for(size_t c : open)
+      for(auto *step : claims[c].instances)
+        violations.push_back(conv.invert_ast(step->cond_ast));
+    conv.assert_ast(conv.make_n_ary(&conv, &smt_convt::mk_or, violations));
+
+    ++rounds;
+    smt_convt::resultt round_res = conv.dec_solve();
+    if(round_res != smt_convt::P_SATISFIABLE)
+    {
+      conv.pop_ctx();
+      if(round_res != smt_convt::P_UNSATISFIABLE)
+        res = round_res;
+      break;
+    }
+
+    res = smt_convt::P_SATISFIABLE;
+    if(step && !show_traces)
+    {
+      conv.pop_ctx();
+      break;
+    }
+
+    {
+      // Closed again before the pop below invalidates the model
+      smt_convt::model_batcht batch(conv);
+      for(auto it = open.begin(); it != open.end();)
+      {
+        multi_claimt &claim = claims[*it];
+        symex_target_equationt::SSA_stept *violated = nullptr;
+        for(auto *step : claim.instances)
+          if(conv.l_get(step->cond_ast).is_false())
+          {
+            violated = step;
+            break;
+          }
+
+        if(violated == nullptr)
+        {
+          ++it;
+          continue;
+        }
+
+        claim.failed = true;
+        if(show_traces)
+          claim_trace(eq, *violated);
+        it = open.erase(it);
+      }
+    }
+
+    conv.pop_ctx();
+  }
+  fine_timet sat_stop = current_time();
+  sat_phase.stop();
+  account_solve(conv);
+
+  {
+    std::ostringstream str;
+    str << "\nRuntime decision procedure: ";
+    output_time(sat_stop - sat_start, str);
+    str << "s (" << rounds << " solver call(s))";
+    status(str.str());
+  }
+
+  if(
+    step ||
+    (res != smt_convt::P_SATISFIABLE && res != smt_convt::P_UNSATISFIABLE))
+    return res;
+
+  std::cout << "\nClaims:\n";
+  for(const auto &claim : claims)
+  {
+    std::cout << "  " << claim.pc->location.as_string();
+    if(!claim.comment.empty())
+      std::cout << ", " << claim.comment;
+    std::cout << ": " << (claim.failed ? "FAILED" : "SUCCESSFUL") << "\n";
+  }
+  std::cout << std::flush;
+
+  return res;
+}
+
+void bmct::claim_trace(
+  std::shared_ptr<symex_target_equationt> &eq,
+  const symex_target_equationt::SSA_stept &violated)
+{
+  // The model may violate other claims too. Hide every other assertion and
+  // everything after this one, so the trace ends where this claim fails.
+  std::vector<bool> hidden;
+  hidden.reserve(eq->SSA_steps.size());
+  bool after = false;
+  for(auto &step : eq->SSA_steps)
+  {
+    hidden.push_back(step.hidden);
+    if(after || (step.is_assert() && &step != &violated))
+      step.hidden = true;
+    if(&step == &violated)
+      after = true;
+  }
+
+  error_trace(runtime_solver, eq);
+
+  size_t i = 0;
+  for(auto &step : eq->SSA_steps)
+    step.hidden = hidden[i++];
+}
+
+#ifndef _WIN32
+namespace
+{
+/* Message sent back by an interleaving worker once its formula is solved.
+ * Small enough for write(2) to be atomic on a pipe shared by all workers. */
+struct ileave_resultt
+{
+  pid_t pid;
+  smt_convt::resultt res;
+};
+
+/* Where an interleaving worker leaves what it prints and its --stats-json
+ * statistics, for the parent to pass on once the worker has exited. Then
+ * the traces of workers running at the same time don't mix. */
+struct ileave_workert
+{
+  FILE *out;
+  FILE *stats;
+};
+
+// The contents of a file a worker wrote through a descriptor it inherited
+std::string read_back(FILE *f)
+{
+  std::string contents;
+  rewind(f);
+  char buf[4096];
+  size_t len;
+  while((len = fread(buf, 1, sizeof(buf), f)) > 0)
+    contents.append(buf, len);
+  return contents;
+}
+
+/* Message sent back by a portfolio worker, solver is an index into the list
+ * of solvers given to --portfolio. */
+struct portfolio_resultt
+{
+  unsigned int solver;
+  smt_convt::resultt res;
+};
+} // namespace
+
+smt_convt::resultt
+bmct::run_parallel_ileaves(std::shared_ptr<symex_target_equationt> &eq)
+{
+  // Symex is cheap compared to solving, so this process keeps walking the
+  // reachability tree depth-first and hands every complete interleaving to a
+  // forked worker. The worker inherits its own copy of the execution state
+  // and equation, builds its own solver and reports back through a pipe.
+  int result_pipe[2];
+  if(pipe(result_pipe))
+  {
+    error("Pipe creation failed, giving up");
+    return smt_convt::P_ERROR;
+  }
+
+  fcntl(
+    result_pipe[0], F_SETFL, fcntl(result_pipe[0], F_GETFL) | O_NONBLOCK);
+
+  std::map<pid_t, ileave_workert> workers;
+  // Workers killed once the answer is known: they are reaped quietly
+  std::set<pid_t> killed;
+  std::map<pid_t, smt_convt::resultt> finished;
+  bool stop = false;
+  smt_convt::resultt res = smt_convt::P_UNSATISFIABLE;
+
+  // Wait for any worker to exit and account for its result
+  auto reap_worker = [&]() {
+    int status;
+    pid_t pid = waitpid(-1, &status, 0);
+    if(pid == -1)
+    {
+      for(const auto &w : workers)
+      {
+        fclose(w.second.out);
+        fclose(w.second.stats);
+      }
+      workers.clear();
+      return;
+    }
+
+    auto w = workers.find(pid);
+    if(w == workers.end())
+      return;
+    ileave_workert worker = w->second;
+    workers.erase(w);
+
+    // Workers write their result before exiting, so it is already queued
+    ileave_resultt r;
+    while(read(result_pipe[0], &r, sizeof(r)) == sizeof(r))
+      finished[r.pid] = r.res;
+
+    auto it = finished.find(pid);
+    if(killed.erase(pid))
+    {
+      if(it != finished.end())
+        finished.erase(it);
+      fclose(worker.out);
+      fclose(worker.stats);
+      return;
+    }
+
+    std::cout << read_back(worker.out) << std::flush;
+    fclose(worker.out);
+
+    std::istringstream worker_stats(read_back(worker.stats));
+    if(stats.merge(worker_stats))
+      warning("Can't read the statistics of an interleaving worker");
+    fclose(worker.stats);
+
+    smt_convt::resultt worker_res;
+    if(it == finished.end())
+    {
+      std::cout << "**** WARNING: Interleaving worker crashed." << std::endl;
+      worker_res = smt_convt::P_ERROR;
+    }
+    else
+    {
+      worker_res = it->second;
+      finished.erase(it);
+    }
+
+    if(worker_res == smt_convt::P_UNSATISFIABLE)
+      return;
+
+    if(worker_res == smt_convt::P_SATISFIABLE)
+      ++interleaving_failed;
+
+    res = worker_res;
+    if(!options.get_bool_option("all-runs"))
+      stop = true;
+  };
+
+  do
+  {
+    stats.add_count("interleavings");
+    if(++interleaving_number > 1)
+    {
+      std::cout << "*** Thread interleavings " << interleaving_number << " ***"
+                << std::endl;
+    }
+
+    std::shared_ptr<goto_symext::symex_resultt> result;
+    if(generate_formula(result, eq))
+    {
+      res = smt_convt::P_ERROR;
+      break;
+    }
+
+    while(!stop && workers.size() >= ileave_workers)
+      reap_worker();
+
+    if(stop)
+      break;
+
+    ileave_workert worker;
+    worker.out = tmpfile();
+    worker.stats = tmpfile();
+    if(worker.out == nullptr || worker.stats == nullptr)
+    {
+      error("Temporary file creation failed, giving up");
+      if(worker.out != nullptr)
+        fclose(worker.out);
+      if(worker.stats != nullptr)
+        fclose(worker.stats);
+      res = smt_convt::P_ERROR;
+      break;
+    }
+
+    // Don't let the worker inherit (and print twice) buffered output
+    std::cout.flush();
+    std::cerr.flush();
+
+    pid_t pid = fork();
+    if(pid == -1)
+    {
+      error("Fork failed, giving up");
+      fclose(worker.out);
+      fclose(worker.stats);
+      res = smt_convt::P_ERROR;
+      break;
+    }
+
+    if(pid == 0)
+    {
+      close(result_pipe[0]);
+      dup2(fileno(worker.out), STDOUT_FILENO);
+
+      // The parent accounts for everything up to the fork
+      stats.clear();
+
+      ileave_resultt r;
+      r.pid = getpid();
+      r.res = solve_formula(result, eq);
+
+      if(r.res == smt_convt::P_SATISFIABLE && !trace_reported)
+      {
+        if(config.options.get_bool_option("smt-model"))
+          runtime_solver->print_model();
+
+        report_trace(r.res, eq);
+      }
+
+      std::cout.flush();
+      std::cerr.flush();
+
+      if(stats.enabled)
+      {
+        std::ostringstream saved;
+        stats.save(saved);
+        fputs(saved.str().c_str(), worker.stats);
+        fflush(worker.stats);
+      }
+
+      auto const len = write(result_pipe[1], &r, sizeof(r));
+      assert(len == sizeof(r) && "short write");
+      (void)len; //ndebug
+
+      // Skip destructors and atexit handlers, the parent owns all of it
+      _exit(0);
+    }
+
+    workers[pid] = worker;
+  } while(!stop && symex->setup_next_formula());
+
+  if(stop)
+  {
+    for(const auto &w : workers)
+    {
+      kill(w.first, SIGKILL);
+      killed.insert(w.first);
+    }
+  }
+
+  while(!workers.empty())
+    reap_worker();
+
+  close(result_pipe[0]);
+  close(result_pipe[1]);
+
+  trace_reported = true;
+  return interleaving_failed > 0 ? smt_convt::P_SATISFIABLE : res;
+}
+
+smt_convt::resultt bmct::run_portfolio(
+  std::shared_ptr<symex_target_equationt> &eq,
+  std::string &winner)
+{
+  std::vector<std::string> solvers;
+  std::istringstream list(options.get_option("portfolio"));
+  std::string name;
+  while(std::getline(list, name, ','))
+  {
+    if(name.empty())
+      continue;
+
+    bool built_in = false;
+    for(unsigned int i = 0; i < esbmc_num_solvers; i++)
+      built_in |= (esbmc_solvers[i].name == name);
+
+    if(!built_in)
+    {
+      error(
+        "The " + name +
+        " solver has not been built into this version of ESBMC, sorry");
+      return smt_convt::P_ERROR;
+    }
+
+    solvers.push_back(name);
+  }
+
+  if(solvers.empty())
+  {
+    error("Please give a comma separated list of solvers to --portfolio");
+    return smt_convt::P_ERROR;
+  }
+
+  int result_pipe[2];
+  if(pipe(result_pipe))
+  {
+    error("Pipe creation failed, giving up");
+    return smt_convt::P_ERROR;
+  }
+
+  std::cout.flush();
+  std::cerr.flush();
+
+  stats_phaset sat_phase("solving");
+  fine_timet sat_start = current_time();
+
+  // Every worker encodes the same equation with its own backend. Whoever
+  // comes back first with a definitive answer wins, the others are killed.
+  // Only the winner's model is wanted, so it builds the counterexample
+  // itself and leaves it in a file of its own for this process to print.
+  std::vector<pid_t> workers;
+  std::vector<FILE *> outs;
+  for(unsigned int i = 0; i < solvers.size(); i++)
+  {
+    FILE *out = tmpfile();
+    if(out == nullptr)
+    {
+      error("Temporary file creation failed, giving up");
+      break;
+    }
+
+    pid_t pid = fork();
+    if(pid == -1)
+    {
+      error("Fork failed, giving up");
+      fclose(out);
+      break;
+    }
+
+    if(pid == 0)
+    {
+      close(result_pipe[0]);
+
+      // Encoding and solving chatter from several solvers at once is just
+      // noise, the parent reports who won
+      int devnull = open("/dev/null", O_WRONLY);
+      if(devnull != -1)
+        dup2(devnull, STDOUT_FILENO);
+
+      portfolio_resultt r;
+      r.solver = i;
+      try
+      {
+        runtime_solver = std::shared_ptr<smt_convt>(create_solver_factory(
+          solvers[i], options.get_bool_option("int-encoding"), ns, options));
+        r.res = run_decision_procedure(runtime_solver, eq);
+
+        if(r.res == smt_convt::P_SATISFIABLE)
+        {
+          std::cout.flush();
+          dup2(fileno(out), STDOUT_FILENO);
+
+          if(config.options.get_bool_option("smt-model"))
+            runtime_solver->print_model();
+
+          report_trace(r.res, eq);
+          std::cout.flush();
+        }
+      }
+      catch(...)
+      {
+        r.res = smt_convt::P_ERROR;
+      }
+
+      auto const len = write(result_pipe[1], &r, sizeof(r));
+      assert(len == sizeof(r) && "short write");
+      (void)len; //ndebug
+
+      _exit(0);
+    }
+
+    workers.push_back(pid);
+    outs.push_back(out);
+  }
+
+  // Close our end, so that read returns zero once every worker is gone
+  close(result_pipe[1]);
+
+  smt_convt::resultt res = smt_convt::P_ERROR;
+  portfolio_resultt r;
+  while(read(result_pipe[0], &r, sizeof(r)) == sizeof(r))
+  {
+    if(
+      r.res == smt_convt::P_SATISFIABLE ||
+      r.res == smt_convt::P_UNSATISFIABLE)
+    {
+      res = r.res;
+      winner = solvers[r.solver];
+      break;
+    }
+  }
+
+  close(result_pipe[0]);
+
+  for(pid_t pid : workers)
+    kill(pid, SIGKILL);
+
+  for(pid_t pid : workers)
+    waitpid(pid, nullptr, 0);
+
+  fine_timet sat_stop = current_time();
+  sat_phase.stop();
+
+  std::string trace;
+  if(res == smt_convt::P_SATISFIABLE)
+    trace = read_back(outs[r.solver]);
+  for(FILE *out : outs)
+    fclose(out);
+
+  if(res == smt_convt::P_ERROR)
+  {
+    error("No solver in the portfolio produced an answer");
+    return res;
+  }
+
+  std::ostringstream str;
+  str << "Solver portfolio: " << winner << " answered first\n";
+  str << "Runtime decision procedure: ";
+  output_time(sat_stop - sat_start, str);
+  str << "s";
+  status(str.str());
+
+  if(res == smt_convt::P_SATISFIABLE)
+  {
+    std::cout << trace << std::flush;
+    trace_reported = true;
+  }
+
+  return res;
+}
+#endif
@@ -18,6 +18,39 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <solvers/smtlib/smtlib_conv.h>
 #include <solvers/solve.h>
 #include <util/options.h>
+#include <vector>
+
+/**
+ *  Solver kept alive across successive bounds by --incremental-solving.
+ *  The SSA program for one bound repeats the program of the previous bound
+ *  up to the point where the smaller bound was hit. Steps repeated that way
+ *  are asserted once, outside of any solver context; everything after them,
+ *  and the disjunction of the claims, is asserted in a context that is
+ *  popped again before the next bound is solved.
+ */
+class incremental_solvert
+{
+public:
+  explicit incremental_solvert(const contextt &context)
+    : ns(context), base_assumpt(nullptr), pushed(false), disabled(false)
+  {
+  }
+
+  // Outlives the bmct objects of the individual bounds.
+  namespacet ns;
+  std::shared_ptr<smt_convt> solver;
+
+  // Steps asserted outside of any context, with their converted asts.
+  std::vector<symex_target_equationt::SSA_stept> base_steps;
+  smt_astt base_assumpt;
+  smt_convt::ast_vec base_assertions;
+
+  // The whole program of the last bound, for finding the shared prefix.
+  std::vector<symex_target_equationt::SSA_stept> prev_steps;
+
+  bool pushed;
+  bool disabled;
+};
 
 class bmct : public messaget
 {
@@ -42,6 +75,11 @@ public:
     ui = _ui;
   }
 
+  void set_incremental_solver(std::shared_ptr<incremental_solvert> inc)
+  {
+    incremental = std::move(inc);
+  }
+
 protected:
   const contextt &context;
   namespacet ns;
@@ -85,6 +123,42 @@ protected:
     std::shared_ptr<symex_target_equationt> &eq);
 
   smt_convt::resultt run_thread(std::shared_ptr<symex_target_equationt> &eq);
+
+  bool generate_formula(
+    std::shared_ptr<goto_symext::symex_resultt> &result,
+    std::shared_ptr<symex_target_equationt> &eq);
+
+  smt_convt::resultt solve_formula(
+    std::shared_ptr<goto_symext::symex_resultt> &result,
+    std::shared_ptr<symex_target_equationt> &eq);
+
+  /* Whether the counterexample of the last satisfiable solve was already
+   * printed, by a worker process or claim by claim, so this process has no
+   * model to build one from. */
+  bool trace_reported;
+
+  /* Number of worker processes used by --parallel-ileaves; zero when every
+   * interleaving is solved in this process. */
+  unsigned int ileave_workers;
+
+  smt_convt::resultt
+  run_parallel_ileaves(std::shared_ptr<symex_target_equationt> &eq);
+
+  std::shared_ptr<incremental_solvert> incremental;
+
+  smt_convt::resultt
+  run_incremental(std::shared_ptr<symex_target_equationt> &eq);
+
+  smt_convt::resultt
+  run_multi_property(std::shared_ptr<symex_target_equationt> &eq);
+
+  void claim_trace(
+    std::shared_ptr<symex_target_equationt> &eq,
+    const symex_target_equationt::SSA_stept &violated);
+
+  smt_convt::resultt run_portfolio(
+    std::shared_ptr<symex_target_equationt> &eq,
+    std::string &winner);
 };
 
 #endif
@@ -18,6 +18,7 @@ extern "C"
 #include <sys/sendfile.h>
 #endif
 
+#include <sys/mman.h>
 #include <sys/resource.h>
 #include <sys/time.h>
 #include <sys/types.h>
@@ -29,6 +30,7 @@ extern "C"
 #include <ansi-c/c_preprocess.h>
 #include <cctype>
 #include <clang-c-frontend/clang_c_language.h>
+#include <climits>
 #include <util/config.h>
 #include <csignal>
 #include <cstdlib>
@@ -37,6 +39,7 @@ extern "C"
 #include <goto-programs/add_race_assertions.h>
 #include <goto-programs/goto_check.h>
 #include <goto-programs/goto_convert_functions.h>
+#include <goto-programs/goto_function_passes.h>
 #include <goto-programs/goto_inline.h>
 #include <goto-programs/goto_k_induction.h>
 #include <goto-programs/interval_analysis.h>
@@ -55,6 +58,7 @@ extern "C"
 #include <pointer-analysis/value_set_analysis.h>
 #include <util/symbol.h>
 #include <sys/wait.h>
+#include <util/stats.h>
 #include <util/time_stopping.h>
 
 enum PROCESS_TYPE
@@ -71,6 +75,18 @@ struct resultt
   BigInt k;
 };
 
+// One slot of the shared-memory result board used by --k-induction-workers.
+// The parent fills in step and k before forking; the worker only ever writes
+// result, right before it exits.
+struct k_induction_slott
+{
+  pid_t pid;
+  PROCESS_TYPE step;
+  uint64_t k;
+  int result;
+  bool killed;
+};
+
 #ifndef _WIN32
 void timeout_handler(int dummy __attribute__((unused)))
 {
@@ -181,6 +197,9 @@ void esbmc_parseoptionst::get_command_line_options(optionst &options)
 
   options.cmdline(cmdline);
 
+  // Has to be settled before the program is converted to irep2.
+  irep2_hash_consing = cmdline.isset("hash-consing");
+
   /* graphML generation options check */
   if(cmdline.isset("witness-output"))
     options.set_option("witness-output", cmdline.getval("witness-output"));
@@ -243,6 +262,119 @@ void esbmc_parseoptionst::get_command_line_options(optionst &options)
     options.set_option("no-slice", true);
   }
 
+  if(cmdline.isset("parallel-ileaves"))
+  {
+#ifdef _WIN32
+    std::cerr << "Parallel interleaving exploration unimplemented on Windows, "
+                 "sorry"
+              << std::endl;
+    abort();
+#else
+    if(
+      cmdline.isset("smt-during-symex") || cmdline.isset("schedule") ||
+      cmdline.isset("interactive-ileaves"))
+    {
+      std::cerr << "--parallel-ileaves can't be used with --smt-during-symex, "
+                   "--schedule or --interactive-ileaves"
+                << std::endl;
+      abort();
+    }
+
+    const char *workers = cmdline.getval("parallel-ileaves");
+    char *end;
+    unsigned long nr = strtoul(workers, &end, 10);
+    if(!isdigit(workers[0]) || *end != '\0' || nr == 0 || nr > UINT_MAX)
+    {
+      std::cerr << "--parallel-ileaves expects a positive number of workers"
+                << std::endl;
+      abort();
+    }
+
+    if(cmdline.isset("bidirectional"))
+      std::cout << "**** WARNING: --bidirectional is ignored with "
+                   "--parallel-ileaves"
+                << std::endl;
+#endif
+  }
+
+  if(cmdline.isset("incremental-solving"))
+  {
+    if(
+      cmdline.isset("smt-during-symex") || cmdline.isset("portfolio") ||
+      cmdline.isset("smt-formula-only") || cmdline.isset("smt-formula-too") ||
+      cmdline.isset("parallel-ileaves"))
+    {
+      std::cerr << "--incremental-solving can't be used with "
+                   "--smt-during-symex, --portfolio, --smt-formula-only, "
+                   "--smt-formula-too or --parallel-ileaves"
+                << std::endl;
+      abort();
+    }
+  }
+
+  if(cmdline.isset("multi-property"))
+  {
+    if(
+      cmdline.isset("smt-during-symex") || cmdline.isset("portfolio") ||
+      cmdline.isset("smt-formula-only") || cmdline.isset("smt-formula-too") ||
+      cmdline.isset("parallel-ileaves") ||
+      cmdline.isset("incremental-solving"))
+    {
+      std::cerr << "--multi-property can't be used with --smt-during-symex, "
+                   "--portfolio, --smt-formula-only, --smt-formula-too, "
+                   "--parallel-ileaves or --incremental-solving"
+                << std::endl;
+      abort();
+    }
+  }
+
+  if(cmdline.isset("k-induction-workers"))
+  {
+#ifdef _WIN32
+    std::cerr << "Parallel k-induction unimplemented on Windows, sorry"
+              << std::endl;
+    abort();
+#else
+    if(!cmdline.isset("k-induction-parallel"))
+    {
+      std::cerr << "--k-induction-workers requires --k-induction-parallel"
+                << std::endl;
+      abort();
+    }
+
+    // Each worker is a process of its own with a slot on the result board
+    const char *workers = cmdline.getval("k-induction-workers");
+    char *end;
+    unsigned long nr = strtoul(workers, &end, 10);
+    if(!isdigit(workers[0]) || *end != '\0' || nr > 1024)
+    {
+      std::cerr << "--k-induction-workers expects a number of workers from 0 "
+                   "to 1024"
+                << std::endl;
+      abort();
+    }
+#endif
+  }
+
+  if(cmdline.isset("portfolio"))
+  {
+#ifdef _WIN32
+    std::cerr << "Solver portfolio unimplemented on Windows, sorry"
+              << std::endl;
+    abort();
+#else
+    if(
+      cmdline.isset("smt-during-symex") || cmdline.isset("smt-formula-only") ||
+      cmdline.isset("smt-formula-too"))
+    {
+      std::cerr << "--portfolio can't be used with --smt-during-symex, "
+                   "--smt-formula-only or --smt-formula-too"
+                << std::endl;
+      abort();
+    }
+#endif
+  }
+
   if(cmdline.isset("smt-thread-guard") || cmdline.isset("smt-symex-guard"))
   {
     if(!cmdline.isset("smt-during-symex"))
@@ -340,6 +472,45 @@ void esbmc_parseoptionst::get_command_line_options(optionst &options)
   config.options = options;
 }
 
+esbmc_parseoptionst::esbmc_parseoptionst(int argc, const char **argv)
+  : parseoptions_baset(esbmc_options, argc, argv), language_uit(cmdline)
+{
+#ifndef _WIN32
+  main_pid = getpid();
+#else
+  main_pid = 0;
+#endif
+}
+
+void esbmc_parseoptionst::output_stats(int result)
+{
+  if(!cmdline.isset("stats-json"))
+    return;
+
+#ifndef _WIN32
+  if(getpid() != main_pid)
+    return;
+#endif
+
+  stats.set_count("exit-code", result);
+
+  std::string filename = cmdline.getval("stats-json");
+  if(filename == "-")
+  {
+    stats.output_json(std::cout);
+    return;
+  }
+
+  std::ofstream out(filename);
+  if(!out)
+  {
+    std::cerr << "failed to open " << filename << " for writing" << std::endl;
+    return;
+  }
+
+  stats.output_json(out);
+}
+
 int esbmc_parseoptionst::doit()
 {
   //
@@ -370,6 +541,7 @@ int esbmc_parseoptionst::doit()
   //
 
   set_verbosity_msg(*this);
+  stats.enabled = cmdline.isset("stats-json");
 
   if(cmdline.isset("preprocess"))
   {
@@ -390,7 +562,18 @@ int esbmc_parseoptionst::doit()
     return doit_k_induction();
 
   if(cmdline.isset("k-induction-parallel"))
+  {
+    if(cmdline.isset("k-induction-workers"))
+    {
+      unsigned workers =
+        strtoul(cmdline.getval("k-induction-workers"), nullptr, 10);
+      if(workers == 0)
+        workers = std::max(sysconf(_SC_NPROCESSORS_ONLN), 1L);
+      return doit_k_induction_workers(workers);
+    }
+
     return doit_k_induction_parallel();
+  }
 
   optionst opts;
   get_command_line_options(opts);
@@ -979,6 +1162,301 @@ int esbmc_parseoptionst::doit_k_induction_parallel()
   return 0;
 }
 
+int esbmc_parseoptionst::doit_k_induction_workers(unsigned num_workers)
+{
+  optionst opts;
+  get_command_line_options(opts);
+
+  if(get_goto_program(opts, goto_functions))
+    return 6;
+
+  if(cmdline.isset("show-claims"))
+  {
+    const namespacet ns(context);
+    show_claims(ns, get_ui(), goto_functions);
+    return 0;
+  }
+
+  if(set_claims(goto_functions))
+    return 7;
+
+  // Get max number of iterations
+  uint64_t max_k_step = cmdline.isset("unlimited-k-steps")
+                          ? UINT_MAX
+                          : strtoul(cmdline.getval("max-k-step"), nullptr, 10);
+
+  // Get the increment
+  unsigned k_step_inc = strtoul(cmdline.getval("k-step"), nullptr, 10);
+
+  uint64_t max_inductive_step =
+    strtoul(cmdline.getval("max-inductive-step"), nullptr, 10);
+
+  // Result board shared with the workers. Every worker is forked from this
+  // process after the goto program was built, so none of them rebuild it.
+  k_induction_slott *board = static_cast<k_induction_slott *>(mmap(
+    nullptr,
+    num_workers * sizeof(k_induction_slott),
+    PROT_READ | PROT_WRITE,
+    MAP_SHARED | MAP_ANONYMOUS,
+    -1,
+    0));
+  if(board == MAP_FAILED)
+  {
+    status("\nShared memory allocation failed, giving up.");
+    _exit(1);
+  }
+
+  for(unsigned i = 0; i < num_workers; i++)
+    board[i].pid = 0;
+
+  // What has been learnt so far: the smallest k at which the base case found
+  // a bug, the largest k the base case has cleared, and the smallest k at
+  // which the forward condition or the inductive step proved the program.
+  uint64_t bug_k = 0, bc_clean_k = 0, fc_k = 0, is_k = 0;
+
+  auto proof_k = [&fc_k, &is_k]() -> uint64_t {
+    if(fc_k && is_k)
+      return std::min(fc_k, is_k);
+    return fc_k ? fc_k : is_k;
+  };
+
+  // Jobs are handed out in order of k, all three steps for one k before
+  // moving on to the next; jobs that can no longer change the verdict are
+  // skipped.
+  uint64_t next_k = 1;
+  int next_step = BASE_CASE;
+
+  auto next_job = [&](PROCESS_TYPE &step, uint64_t &k) -> bool {
+    while(next_k <= max_k_step)
+    {
+      step = PROCESS_TYPE(next_step);
+      k = next_k;
+
+      if(++next_step > INDUCTIVE_STEP)
+      {
+        next_step = BASE_CASE;
+        next_k += k_step_inc;
+      }
+
+      uint64_t proved = proof_k();
+      switch(step)
+      {
+      case BASE_CASE:
+        if(proved && k > proved)
+          continue;
+        return true;
+
+      case FORWARD_CONDITION:
+        if(opts.get_bool_option("disable-forward-condition"))
+          continue;
+        if(proved && k >= proved)
+          continue;
+        return true;
+
+      case INDUCTIVE_STEP:
+        if(k == 1 || opts.get_bool_option("disable-inductive-step"))
+          continue;
+        if(k > max_inductive_step || (proved && k >= proved))
+          continue;
+        return true;
+
+      default:
+        assert(0 && "Unknown process type.");
+      }
+    }
+
+    return false;
+  };
+
+  auto start_worker = [&](unsigned i, PROCESS_TYPE step, uint64_t k) {
+    board[i].step = step;
+    board[i].k = k;
+    board[i].result = -1;
+    board[i].killed = false;
+
+    // Don't let the worker inherit (and later repeat) buffered output.
+    std::cout.flush();
+
+    pid_t pid = fork();
+    if(pid == -1)
+    {
+      status("\nFork Failed, giving up.");
+      _exit(1);
+    }
+
+    if(pid)
+    {
+      board[i].pid = pid;
+      return;
+    }
+
+    optionst step_opts = opts;
+    step_opts.set_option("base-case", step == BASE_CASE);
+    step_opts.set_option("forward-condition", step == FORWARD_CONDITION);
+    step_opts.set_option("inductive-step", step == INDUCTIVE_STEP);
+    step_opts.set_option("no-unwinding-assertions", step != FORWARD_CONDITION);
+    step_opts.set_option("partial-loops", step == INDUCTIVE_STEP);
+    if(step == FORWARD_CONDITION)
+      step_opts.set_option("no-assertions", true);
+
+    bmct bmc(goto_functions, step_opts, context, ui_message_handler);
+    set_verbosity_msg(bmc);
+
+    bmc.options.set_option("unwind", i2string(k));
+
+    std::cout << std::endl << "*** K-Induction Loop Iteration " << k << " ***"
+              << std::endl;
+    std::cout << "*** Checking "
+              << (step == BASE_CASE
+                    ? "base case"
+                    : step == FORWARD_CONDITION ? "forward condition"
+                                                : "inductive step")
+              << std::endl;
+
+    int res = smt_convt::P_ERROR;
+    try
+    {
+      res = do_bmc(bmc);
+    }
+    catch(...)
+    {
+    }
+
+    board[i].result = res;
+    std::cout.flush();
+    _exit(0);
+  };
+
+  unsigned running = 0;
+  for(;;)
+  {
+    uint64_t proved = proof_k();
+    if(bug_k || (proved && bc_clean_k >= proved))
+      break;
+
+    for(unsigned i = 0; i < num_workers; i++)
+    {
+      PROCESS_TYPE step;
+      uint64_t k;
+      if(board[i].pid == 0 && next_job(step, k))
+      {
+        start_worker(i, step, k);
+        ++running;
+      }
+    }
+
+    if(!running)
+      break;
+
+    int status;
+    pid_t pid = waitpid(-1, &status, 0);
+    if(pid == -1)
+    {
+      if(errno == EINTR)
+        continue;
+      break;
+    }
+
+    unsigned i = 0;
+    while(i < num_workers && board[i].pid != pid)
+      ++i;
+    if(i == num_workers)
+      continue;
+
+    --running;
+    board[i].pid = 0;
+    if(board[i].killed)
+      continue;
+
+    if(!WIFEXITED(status) || board[i].result == -1)
+    {
+      std::cout << "**** WARNING: k-induction worker for k = " << board[i].k
+                << " crashed." << std::endl;
+      continue;
+    }
+
+    uint64_t k = board[i].k;
+    switch(board[i].step)
+    {
+    case BASE_CASE:
+      if(board[i].result == smt_convt::P_SATISFIABLE)
+        bug_k = bug_k ? std::min(bug_k, k) : k;
+      else if(board[i].result == smt_convt::P_UNSATISFIABLE)
+        bc_clean_k = std::max(bc_clean_k, k);
+      break;
+
+    case FORWARD_CONDITION:
+      if(board[i].result == smt_convt::P_UNSATISFIABLE)
+        fc_k = fc_k ? std::min(fc_k, k) : k;
+      break;
+
+    case INDUCTIVE_STEP:
+      if(board[i].result == smt_convt::P_UNSATISFIABLE)
+        is_k = is_k ? std::min(is_k, k) : k;
+      break;
+
+    default:
+      assert(0 && "Unknown process type.");
+    }
+
+    // A proof at k makes every worker beyond k redundant, except for the
+    // base cases still needed to confirm it.
+    proved = proof_k();
+    for(unsigned j = 0; proved && j < num_workers; j++)
+    {
+      if(board[j].pid == 0 || board[j].killed)
+        continue;
+
+      bool beyond = board[j].step == BASE_CASE ? board[j].k > proved
+                                               : board[j].k >= proved;
+      if(beyond)
+      {
+        kill(board[j].pid, SIGKILL);
+        board[j].killed = true;
+      }
+    }
+  }
+
+  // Stop anything still running and reap it.
+  for(unsigned i = 0; i < num_workers; i++)
+    if(board[i].pid != 0)
+      kill(board[i].pid, SIGKILL);
+
+  while(running > 0 && wait(nullptr) != -1)
+    --running;
+
+  munmap(board, num_workers * sizeof(k_induction_slott));
+
+  if(bug_k)
+  {
+    std::cout << std::endl
+              << "Bug found by the base case (k = " << bug_k << ")"
+              << std::endl;
+    std::cout << "VERIFICATION FAILED" << std::endl;
+    return true;
+  }
+
+  uint64_t proved = proof_k();
+  if(proved && bc_clean_k >= proved)
+  {
+    if(proved == fc_k)
+      std::cout << std::endl
+                << "Solution found by the forward condition; "
+                << "all states are reachable (k = " << fc_k << ")"
+                << std::endl;
+    else
+      std::cout << std::endl
+                << "Solution found by the inductive step "
+                << "(k = " << is_k << ")" << std::endl;
+    std::cout << "VERIFICATION SUCCESSFUL" << std::endl;
+    return false;
+  }
+
+  // Couldn't find a bug or a proof for the current deepth
+  std::cout << std::endl << "VERIFICATION UNKNOWN" << std::endl;
+  return false;
+}
+
 int esbmc_parseoptionst::doit_k_induction()
 {
   optionst opts;
@@ -1159,6 +1637,18 @@ int esbmc_parseoptionst::doit_termination()
   return 0;
 }
 
+void esbmc_parseoptionst::use_incremental_solver(
+  bmct &bmc,
+  std::shared_ptr<incremental_solvert> &inc)
+{
+  if(!cmdline.isset("incremental-solving"))
+    return;
+
+  if(!inc)
+    inc = std::make_shared<incremental_solvert>(context);
+  bmc.set_incremental_solver(inc);
+}
+
 int esbmc_parseoptionst::do_base_case(
   optionst &opts,
   goto_functionst &goto_functions,
@@ -1175,6 +1665,7 @@ int esbmc_parseoptionst::do_base_case(
   set_verbosity_msg(bmc);
 
   bmc.options.set_option("unwind", integer2string(k_step));
+  use_incremental_solver(bmc, base_case_solver);
 
   std::cout << "*** Checking base case\n";
   switch(do_bmc(bmc))
@@ -1222,6 +1713,7 @@ int esbmc_parseoptionst::do_forward_condition(
   set_verbosity_msg(bmc);
 
   bmc.options.set_option("unwind", integer2string(k_step));
+  use_incremental_solver(bmc, forward_condition_solver);
 
   std::cout << "*** Checking forward condition\n";
   auto res = do_bmc(bmc);
@@ -1277,6 +1769,7 @@ int esbmc_parseoptionst::do_inductive_step(
   set_verbosity_msg(bmc);
 
   bmc.options.set_option("unwind", integer2string(k_step));
+  use_incremental_solver(bmc, inductive_step_solver);
 
   std::cout << "*** Checking inductive step\n";
   switch(do_bmc(bmc))
@@ -1345,14 +1838,17 @@ bool esbmc_parseoptionst::get_goto_program(
     {
       status("Reading GOTO program from file");
 
+      stats_phaset parse_phase("parse");
       if(read_goto_binary(goto_functions))
         return true;
     }
     else
     {
       // Parsing
+      stats_phaset parse_phase("parse");
       if(parse())
         return true;
+      parse_phase.stop();
       if(cmdline.isset("parse-tree-too") || cmdline.isset("parse-tree-only"))
       {
         assert(language_files.filemap.size());
@@ -1364,10 +1860,12 @@ bool esbmc_parseoptionst::get_goto_program(
       }
 
       // Typecheking (old frontend) or adjust (clang frontend)
+      stats_phaset typecheck_phase("typecheck");
       if(typecheck())
         return true;
       if(final())
         return true;
+      typecheck_phase.stop();
 
       // we no longer need any parse trees or language files
       clear_parse();
@@ -1385,6 +1883,7 @@ bool esbmc_parseoptionst::get_goto_program(
       // Ahem
       migrate_namespace_lookup = new namespacet(context);
 
+      stats_phaset convert_phase("goto-convert");
       goto_convert(context, options, goto_functions, ui_message_handler);
     }
 
@@ -1395,10 +1894,12 @@ bool esbmc_parseoptionst::get_goto_program(
     str << "s";
     status(str.str());
 
+    stats_phaset process_phase("goto-passes");
     fine_timet process_start = current_time();
     if(process_goto_program(options, goto_functions))
       return true;
     fine_timet process_stop = current_time();
+    process_phase.stop();
     std::ostringstream str2;
     str2 << "GOTO program processing time: ";
     output_time(process_stop - process_start, str2);
@@ -1500,7 +2001,10 @@ bool esbmc_parseoptionst::process_goto_program(
     }
 
     if(cmdline.isset("interval-analysis"))
-      interval_analysis(goto_functions, ns);
+    {
+      stats_phaset interval_phase("interval-analysis");
+      interval_analysis(goto_functions, ns, options);
+    }
 
     if(
       cmdline.isset("inductive-step") || cmdline.isset("k-induction") ||
@@ -1522,11 +2026,18 @@ bool esbmc_parseoptionst::process_goto_program(
       goto_termination(goto_functions, ui_message_handler);
     }
 
-    goto_check(ns, options, goto_functions);
+    // The checks and the clean-up after them are all local to a function,
+    // so they run as one pipeline over each body in turn.
+    goto_function_passest function_passes;
+    function_passes.add([&ns, &options](goto_programt &body) {
+      goto_check(ns, options, body);
+    });
 
     // show it?
     if(cmdline.isset("show-goto-value-sets"))
     {
+      function_passes(goto_functions);
+
       value_set_analysist value_set_analysis(ns);
       value_set_analysis(goto_functions);
       show_value_sets(get_ui(), goto_functions, value_set_analysis);
@@ -1546,18 +2057,17 @@ bool esbmc_parseoptionst::process_goto_program(
       goto_functions, ns, context, options, value_set_analysis);
 #endif
 
-    // remove skips
-    remove_skip(goto_functions);
-
-    // remove unreachable code
-    Forall_goto_functions(f_it, goto_functions)
-      remove_unreachable(f_it->second.body);
+    // remove skips, then unreachable code, and the skips that leaves; the
+    // bodies are only renumbered once, after the last pass
+    auto skips = [](goto_programt &body) {
+      remove_skip(body, body.instructions.begin(), body.instructions.end());
+    };
+    function_passes.add(skips);
+    function_passes.add([](goto_programt &body) { remove_unreachable(body); });
+    function_passes.add(skips);
 
-    // remove skips
-    remove_skip(goto_functions);
-
-    // recalculate numbers, etc.
-    goto_functions.update();
+    // this also recalculates numbers, etc.
+    function_passes(goto_functions);
 
     // add loop ids
     goto_functions.compute_loop_numbers();
@@ -1631,6 +2141,11 @@ int esbmc_parseoptionst::do_bmc(bmct &bmc)
     int fd = open("/proc/self/status", O_RDONLY);
     sendfile(2, fd, nullptr, 100000);
     close(fd);
+
+    // --stats-json resets VmHWM at every phase
+    if(stats.enabled)
+      std::cerr << "Peak RSS of the process: " << stats.get_peak_rss()
+                << " kB\n";
   }
 #endif
 
@@ -1735,14 +2250,20 @@ void esbmc_parseoptionst::help()
        "\nBMC options\n"
        " --function name              set main function name\n"
        " --claim nr                   only check specific claim\n"
+       " --multi-property             encode once and report a verdict for "
+       "every claim\n"
        " --depth nr                   limit search depth\n"
        " --unwind nr                  unwind nr times\n"
        " --unwindset nr               unwind given loop nr times\n"
        " --no-unwinding-assertions    do not generate unwinding assertions\n"
        " --partial-loops              permit paths with partial loops\n"
        " --no-slice                   do not remove unused equations\n"
+       " --slice-stats                report slicer throughput and memory\n"
        " --extended-try-analysis      check all the try block, even when an "
        "exception is thrown\n"
+       " --function-summaries         replace calls to loop-free functions "
+       "that only compute\n"
+       "                              a value by that value\n"
 
        "\nIncremental BMC\n"
        " --falsification              incremental loop unwinding for bug "
@@ -1750,6 +2271,10 @@ void esbmc_parseoptionst::help()
        " --incremental-bmc            incremental loop unwinding verification\n"
        " --termination                incremental loop unwinding assertion "
        "verification\n"
+       " --incremental-solving        keep one solver across bounds, only "
+       "encoding the part\n"
+       "                              of the program that changed (also for "
+       "--k-induction)\n"
        " --k-step nr                  set k increment (default is 1)\n"
        " --max-k-step nr              set max number of iteration (default is "
        "50)\n"
@@ -1762,10 +2287,16 @@ void esbmc_parseoptionst::help()
        " --mathsat                    use MathSAT\n"
        " --cvc                        use CVC4\n"
        " --yices                      use Yices\n"
+       " --cadical                    bitblast to CNF and use CaDiCaL\n"
        " --bv                         use solver with bit-vector arithmetic\n"
        " --ir                         use solver with integer/real arithmetic\n"
        " --smtlib                     use SMT lib format\n"
-       " --smtlib-solver-prog         SMT lib program name\n"
+       " --smtlib-solver-prog         SMT lib program name, and its "
+       "arguments\n"
+       " --smtlib-assume-contexts     pass contexts to the SMT lib program "
+       "as\n"
+       "                              check-sat-assuming guards instead of "
+       "push/pop\n"
        " --output <filename>          output VCCs in SMT lib format to given "
        "file\n"
        " --fixedbv                    encode floating-point as fixed "
@@ -1782,8 +2313,14 @@ void esbmc_parseoptionst::help()
        "--tuple-sym-flattener         encode tuples using our tuple to symbol "
        "API\n"
        "--array-flattener             encode arrays using our array API\n"
+       "--ordered-address-space       place objects in allocation order, "
+       "linear instead of\n"
+       "                              quadratic disjointness constraints\n"
        "--no-return-value-opt         disable return value optimization to "
        "compute the stack size\n"
+       "--portfolio s1,s2,...         solve with all the listed solvers at once "
+       "and use the\n"
+       "                              first answer\n"
 
        "\nIncremental SMT solving\n"
        " --smt-during-symex           enable incremental SMT solving "
@@ -1822,6 +2359,11 @@ void esbmc_parseoptionst::help()
        " --k-induction-parallel       prove by k-induction, running each step "
        "on a separate\n"
        "                              process\n"
+       " --k-induction-workers nr     with --k-induction-parallel, run up to "
+       "nr steps at once\n"
+       "                              over several values of k (0 = one per "
+       "CPU, at\n"
+       "                              most 1024)\n"
        " --k-step nr                  set k increment (default is 1)\n"
        " --max-k-step nr              set max number of iteration (default is "
        "50)\n"
@@ -1844,6 +2386,9 @@ void esbmc_parseoptionst::help()
        " --no-por                     do not do partial order reduction\n"
        " --all-runs                   check all interleavings, even if a bug "
        "was already found\n"
+       " --parallel-ileaves nr        solve up to nr interleavings at once, "
+       "each on a separate\n"
+       "                              process\n"
 
        "\nMiscellaneous options\n"
        " --memlimit                   configure memory limit, of form \"100m\" "
@@ -1851,10 +2396,22 @@ void esbmc_parseoptionst::help()
        " --timeout                    configure time limit, integer followed "
        "by {s,m,h}\n"
        " --memstats                   print memory usage statistics\n"
+       " --stats-json file            write time, memory and solver statistics"
+       " per phase\n"
+       "                              to file as JSON (- for stdout)\n"
        " --no-simplify                do not simplify any expression\n"
        " --no-propagation             disable constant propagation\n"
+       " --hash-consing               share one instance of structurally "
+       "equal expressions\n"
        " --enable-core-dump           do not disable core dump output\n"
        " --interval-analysis          enable interval analysis and add assumes "
        "to the program\n"
+       " --interval-analysis-narrowing\n"
+       "                              refine the bounds widening drops at loop "
+       "heads\n"
+       " --interval-analysis-summaries\n"
+       "                              analyse each function once and apply "
+       "its summary at\n"
+       "                              call sites\n"
        "\n";
 }
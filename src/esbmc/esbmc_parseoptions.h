@@ -25,10 +25,10 @@ public:
   int doit() override;
   void help() override;
 
-  esbmc_parseoptionst(int argc, const char **argv)
-    : parseoptions_baset(esbmc_options, argc, argv), language_uit(cmdline)
-  {
-  }
+  esbmc_parseoptionst(int argc, const char **argv);
+
+  // Writes the statistics of the run, with --stats-json
+  void output_stats(int result);
 
 protected:
   virtual void get_command_line_options(optionst &options);
@@ -42,6 +42,7 @@ protected:
 
   int doit_k_induction();
   int doit_k_induction_parallel();
+  int doit_k_induction_workers(unsigned num_workers);
 
   int doit_falsification();
   int doit_incremental();
@@ -62,6 +63,14 @@ protected:
     goto_functionst &goto_functions,
     const BigInt &k_step);
 
+  // Solvers kept across bounds by --incremental-solving, one per step.
+  std::shared_ptr<incremental_solvert> base_case_solver;
+  std::shared_ptr<incremental_solvert> forward_condition_solver;
+  std::shared_ptr<incremental_solvert> inductive_step_solver;
+
+  void
+  use_incremental_solver(bmct &bmc, std::shared_ptr<incremental_solvert> &inc);
+
   bool read_goto_binary(goto_functionst &goto_functions);
 
   bool set_claims(goto_functionst &goto_functions);
@@ -77,6 +86,10 @@ protected:
 
 public:
   goto_functionst goto_functions;
+
+protected:
+  // The process that started the run; forked workers return through main too
+  int main_pid;
 };
 
 #endif
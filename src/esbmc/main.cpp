@@ -30,5 +30,7 @@ int main(int argc, const char **argv)
   type_pool = bees;
 
   esbmc_parseoptionst parseoptions(argc, argv);
-  return parseoptions.main();
+  int res = parseoptions.main();
+  parseoptions.output_stats(res);
+  return res;
 }
@@ -72,6 +72,7 @@ const struct opt_templ esbmc_options[] = {
   // BMC
   {0, "function", string, ""},
   {0, "claim", number, ""},
+  {0, "multi-property", switc, ""},
   {0, "depth", number, ""},
   {0, "unwind", number, ""},
   {0, "unwindset", string, ""},
@@ -80,12 +81,15 @@ const struct opt_templ esbmc_options[] = {
   {0, "unroll-loops", switc, ""},
   {0, "no-slice", switc, ""},
   {0, "slice-assumes", switc, ""},
+  {0, "slice-stats", switc, ""},
   {0, "extended-try-analysis", switc, ""},
   {0, "skip-bmc", switc, ""},
   {0, "no-return-value-opt", switc, ""},
+  {0, "function-summaries", switc, ""},
 
   // IBMC
   {0, "incremental-bmc", switc, ""},
+  {0, "incremental-solving", switc, ""},
   {0, "falsification", switc, ""},
   {0, "termination", switc, ""},
 
@@ -96,10 +100,12 @@ const struct opt_templ esbmc_options[] = {
   {0, "mathsat", switc, ""},
   {0, "cvc", switc, ""},
   {0, "yices", switc, ""},
+  {0, "cadical", switc, ""},
   {0, "bv", switc, ""},
   {0, "ir", switc, ""},
   {0, "smtlib", switc, ""},
   {0, "smtlib-solver-prog", string, ""},
+  {0, "smtlib-assume-contexts", switc, ""},
   {0, "output", string, ""},
   {0, "floatbv", switc, ""},
   {0, "fixedbv", switc, ""},
@@ -107,6 +113,8 @@ const struct opt_templ esbmc_options[] = {
   {0, "tuple-node-flattener", switc, ""},
   {0, "tuple-sym-flattener", switc, ""},
   {0, "array-flattener", switc, ""},
+  {0, "ordered-address-space", switc, ""},
+  {0, "portfolio", string, ""},
 
   // Incremental SMT
   {0, "smt-during-symex", switc, ""},
@@ -136,6 +144,7 @@ const struct opt_templ esbmc_options[] = {
   {0, "inductive-step", switc, ""},
   {0, "k-induction", switc, ""},
   {0, "k-induction-parallel", switc, ""},
+  {0, "k-induction-workers", number, ""},
   {0, "k-step", number, "1"},
   {0, "max-k-step", number, "50"},
   {0, "unlimited-k-steps", switc, ""},
@@ -153,15 +162,20 @@ const struct opt_templ esbmc_options[] = {
   {0, "state-hashing", switc, ""},
   {0, "no-por", switc, ""},
   {0, "all-runs", switc, ""},
+  {0, "parallel-ileaves", number, ""},
 
   // Miscellaneous
   {0, "memlimit", string, ""},
   {0, "memstats", switc, ""},
+  {0, "stats-json", string, ""},
   {0, "timeout", string, ""},
   {0, "enable-core-dump", switc, ""},
   {0, "no-simplify", switc, ""},
   {0, "no-propagation", switc, ""},
+  {0, "hash-consing", switc, ""},
   {0, "interval-analysis", switc, ""},
+  {0, "interval-analysis-narrowing", switc, ""},
+  {0, "interval-analysis-summaries", switc, ""},
 
   // DEBUG options
 
@@ -11,9 +11,11 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "ai.h"
 
+#include <algorithm>
 #include <cassert>
 #include <memory>
 #include <sstream>
+#include <unordered_set>
 
 #include <util/std_code.h>
 #include <util/std_expr.h>
@@ -71,7 +73,68 @@ void ai_baset::initialize(const goto_programt &goto_program)
   // we mark everything as unreachable as starting point
 
   forall_goto_program_instructions(i_it, goto_program)
+  {
     get_state(i_it).make_bottom();
+
+    if(i_it->is_backwards_goto())
+      for(const auto &target : i_it->targets)
+        widening_points.emplace(target, 0);
+  }
+
+  number_rpo(goto_program);
+}
+
+void ai_baset::number_rpo(const goto_programt &goto_program)
+{
+  if(goto_program.empty())
+    return;
+
+  // Iterative depth-first search, as bodies can be very long
+  std::vector<goto_programt::const_targett> post_order;
+  std::unordered_set<
+    goto_programt::const_targett,
+    const_target_hash,
+    pointee_address_equalt>
+    visited;
+
+  typedef std::pair<goto_programt::const_targett, goto_programt::const_targetst>
+    framet;
+  std::vector<framet> stack;
+
+  goto_programt::const_targett begin = goto_program.instructions.begin();
+  visited.insert(begin);
+  stack.emplace_back(begin, goto_programt::const_targetst());
+  goto_program.get_successors(begin, stack.back().second);
+
+  while(!stack.empty())
+  {
+    goto_programt::const_targetst &successors = stack.back().second;
+
+    if(successors.empty())
+    {
+      post_order.push_back(stack.back().first);
+      stack.pop_back();
+      continue;
+    }
+
+    goto_programt::const_targett next = successors.front();
+    successors.pop_front();
+
+    if(next == goto_program.instructions.end() || !visited.insert(next).second)
+      continue;
+
+    stack.emplace_back(next, goto_programt::const_targetst());
+    goto_program.get_successors(next, stack.back().second);
+  }
+
+  unsigned number = 0;
+  for(auto it = post_order.rbegin(); it != post_order.rend(); it++)
+    rpo_numbers[*it] = number++;
+
+  // Unreachable code goes last, in program order
+  forall_goto_program_instructions(i_it, goto_program)
+    if(visited.count(i_it) == 0)
+      rpo_numbers[i_it] = number++;
 }
 
 void ai_baset::initialize(const goto_functionst &goto_functions)
@@ -121,6 +184,104 @@ bool ai_baset::fixedpoint(
   return new_data;
 }
 
+bool ai_baset::merge_or_widen(
+  const statet &src,
+  goto_programt::const_targett from,
+  goto_programt::const_targett to)
+{
+  widening_pointst::iterator w = widening_points.find(to);
+  if(w == widening_points.end())
+    return merge(src, from, to);
+
+  // Plain joins first, so loops that stabilise quickly keep exact bounds
+  if(w->second >= widening_delay)
+    return widen(src, from, to);
+
+  if(!merge(src, from, to))
+    return false;
+
+  w->second++;
+  return true;
+}
+
+void ai_baset::narrowing(
+  const goto_programt &goto_program,
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+{
+  if(narrowing_sweeps == 0 || goto_program.empty())
+    return;
+
+  // The edges into each location, with the instruction they come from
+  typedef std::unordered_map<
+    goto_programt::const_targett,
+    std::vector<goto_programt::const_targett>,
+    const_target_hash,
+    pointee_address_equalt>
+    predecessorst;
+  predecessorst predecessors;
+
+  forall_goto_program_instructions(i_it, goto_program)
+  {
+    goto_programt::const_targetst successors;
+    goto_program.get_successors(i_it, successors);
+
+    for(const auto &to_l : successors)
+      if(to_l != goto_program.instructions.end())
+        predecessors[to_l].push_back(i_it);
+  }
+
+  for(unsigned i = 0; i < narrowing_sweeps; i++)
+  {
+    bool changed = false;
+
+    forall_goto_program_instructions(i_it, goto_program)
+    {
+      // The entry state comes from the call sites, which are left alone
+      if(i_it == goto_program.instructions.begin())
+        continue;
+
+      predecessorst::const_iterator p = predecessors.find(i_it);
+      if(p == predecessors.end())
+        continue;
+
+      const statet &current = get_state(i_it);
+      if(current.is_bottom())
+        continue;
+
+      // Recompute the join of the edges into i_it. Edges returning from a
+      // call depend on the callee's end state, so locations after calls keep
+      // their state.
+      std::unique_ptr<statet> in(make_temporary_state(current));
+      in->make_bottom();
+
+      bool after_call = false;
+      for(const auto &from : p->second)
+      {
+        if(from->is_function_call() && !goto_functions.function_map.empty())
+        {
+          after_call = true;
+          break;
+        }
+
+        const statet &from_state = get_state(from);
+        if(from_state.is_bottom())
+          continue;
+
+        std::unique_ptr<statet> edge(make_temporary_state(from_state));
+        edge->transform(from, i_it, *this, ns);
+        merge_temporary(*in, *edge, from, i_it);
+      }
+
+      if(!after_call && narrow(*in, p->second.front(), i_it))
+        changed = true;
+    }
+
+    if(!changed)
+      break;
+  }
+}
+
 bool ai_baset::visit(
   goto_programt::const_targett l,
   working_sett &working_set,
@@ -151,7 +312,12 @@ bool ai_baset::visit(
       // this is a big special case
       const code_function_call2t &code = to_code_function_call2t(l->code);
 
-      if(do_function_call_rec(l, to_l, code.function, goto_functions, ns))
+      if(function_summaries)
+      {
+        if(do_summary_call(l, to_l, code.function, ns))
+          have_new_values = true;
+      }
+      else if(do_function_call_rec(l, to_l, code.function, goto_functions, ns))
         have_new_values = true;
     }
     else
@@ -161,7 +327,7 @@ bool ai_baset::visit(
 
       new_values.transform(l, to_l, *this, ns);
 
-      if(merge(new_values, l, to_l))
+      if(merge_or_widen(new_values, l, to_l))
         have_new_values = true;
     }
 
@@ -195,7 +361,7 @@ bool ai_baset::do_function_call(
     std::unique_ptr<statet> tmp_state(make_temporary_state(get_state(l_call)));
     tmp_state->transform(l_call, l_return, *this, ns);
 
-    return merge(*tmp_state, l_call, l_return);
+    return merge_or_widen(*tmp_state, l_call, l_return);
   }
 
   assert(!goto_function.body.instructions.empty());
@@ -216,7 +382,7 @@ bool ai_baset::do_function_call(
     bool new_data = false;
 
     // merge the new stuff
-    if(merge(*tmp_state, l_call, l_begin))
+    if(merge_or_widen(*tmp_state, l_call, l_begin))
       new_data = true;
 
     // do we need to do/re-do the fixedpoint of the body?
@@ -242,7 +408,7 @@ bool ai_baset::do_function_call(
     tmp_state->transform(l_end, l_return, *this, ns);
 
     // Propagate those
-    return merge(*tmp_state, l_end, l_return);
+    return merge_or_widen(*tmp_state, l_end, l_return);
   }
 }
 
@@ -282,4 +448,250 @@ void ai_baset::sequential_fixedpoint(
 
   if(f_it != goto_functions.function_map.end())
     fixedpoint(f_it->second.body, goto_functions, ns);
+
+  forall_goto_functions(it, goto_functions)
+    if(it->second.body_available)
+      narrowing(it->second.body, goto_functions, ns);
+}
+
+bool ai_baset::do_summary_call(
+  goto_programt::const_targett l_call,
+  goto_programt::const_targett l_return,
+  const expr2tc &function,
+  const namespacet &ns)
+{
+  // initialize state, if necessary
+  get_state(l_return);
+
+  std::unique_ptr<statet> tmp_state(make_temporary_state(get_state(l_call)));
+  tmp_state->transform(l_call, l_return, *this, ns);
+
+  // Without a body (or a known callee) there is just the edge call -> return
+  if(is_symbol2t(function))
+  {
+    summariest::const_iterator s_it =
+      summaries.find(to_symbol2t(function).thename);
+
+    if(s_it != summaries.end())
+    {
+      apply_summary(*tmp_state, *s_it->second.state, s_it->second.modified, ns);
+      if(tmp_state->is_bottom())
+        return false; // function exit point not reachable (yet)
+    }
+  }
+
+  return merge_or_widen(*tmp_state, l_call, l_return);
+}
+
+/// Adds the l-values goto_program assigns to, and the functions it calls, to
+/// modified and callees
+static void get_writes(
+  const goto_programt &goto_program,
+  std::unordered_set<expr2tc, irep2_hash> &modified,
+  std::unordered_set<irep_idt, irep_id_hash> &callees)
+{
+  forall_goto_program_instructions(i_it, goto_program)
+  {
+    if(i_it->is_assign())
+      modified.insert(to_code_assign2t(i_it->code).target);
+    else if(i_it->is_decl())
+      modified.insert(symbol2tc(
+        to_code_decl2t(i_it->code).type, to_code_decl2t(i_it->code).value));
+    else if(i_it->is_function_call())
+    {
+      const code_function_call2t &call = to_code_function_call2t(i_it->code);
+      if(!is_nil_expr(call.ret))
+        modified.insert(call.ret);
+      if(is_symbol2t(call.function))
+        callees.insert(to_symbol2t(call.function).thename);
+    }
+  }
+}
+
+void ai_baset::summarise_component(
+  const std::vector<irep_idt> &component,
+  bool recursive,
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+{
+  // The functions of a component may all call each other, so they share
+  // what they may modify
+  std::unordered_set<expr2tc, irep2_hash> modified;
+  std::unordered_set<irep_idt, irep_id_hash> callees;
+  for(const auto &id : component)
+    get_writes(goto_functions.function_map.at(id).body, modified, callees);
+
+  for(const auto &callee : callees)
+  {
+    summariest::const_iterator s_it = summaries.find(callee);
+    if(s_it != summaries.end())
+      modified.insert(s_it->second.modified.begin(), s_it->second.modified.end());
+  }
+
+  for(const auto &id : component)
+    summaries.at(id).modified.assign(modified.begin(), modified.end());
+
+  // Calls inside the component see the summaries built so far, which only
+  // grow, so iterate until none of them changes
+  for(unsigned round = 0;; round++)
+  {
+    bool changed = false;
+
+    for(const auto &id : component)
+    {
+      const goto_programt &body = goto_functions.function_map.at(id).body;
+
+      // Calls whose summary grew must be visited again, start afresh
+      if(round != 0)
+      {
+        forall_goto_program_instructions(i_it, body)
+        {
+          get_state(i_it).make_bottom();
+
+          widening_pointst::iterator w = widening_points.find(i_it);
+          if(w != widening_points.end())
+            w->second = 0;
+        }
+      }
+
+      get_state(body.instructions.begin()).make_entry();
+      fixedpoint(body, goto_functions, ns);
+
+      goto_programt::const_targett l_end = --body.instructions.end();
+      statet &summary = *summaries.at(id).state;
+      if(
+        round < widening_delay
+          ? merge_temporary(summary, get_state(l_end), l_end, l_end)
+          : widen_temporary(summary, get_state(l_end), l_end, l_end))
+        changed = true;
+    }
+
+    if(!recursive || !changed)
+      break;
+  }
+
+  for(const auto &id : component)
+    narrowing(goto_functions.function_map.at(id).body, goto_functions, ns);
+}
+
+void ai_baset::summary_fixedpoint(
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+{
+  // The call graph between the functions with a body
+  std::vector<irep_idt> functions;
+  std::unordered_map<irep_idt, unsigned, irep_id_hash> index;
+  forall_goto_functions(it, goto_functions)
+  {
+    if(!it->second.body_available || it->second.body.empty())
+      continue;
+
+    index[it->first] = functions.size();
+    functions.push_back(it->first);
+
+    // The end state of a function starts out unreachable
+    goto_programt::const_targett l_end = --it->second.body.instructions.end();
+    std::unique_ptr<statet> state(make_temporary_state(get_state(l_end)));
+    state->make_bottom();
+    summaries[it->first].state = std::move(state);
+  }
+
+  std::vector<std::vector<unsigned>> calls(functions.size());
+  std::vector<bool> self_call(functions.size(), false);
+  for(unsigned f = 0; f < functions.size(); f++)
+  {
+    std::unordered_set<expr2tc, irep2_hash> modified;
+    std::unordered_set<irep_idt, irep_id_hash> callees;
+    get_writes(
+      goto_functions.function_map.at(functions[f]).body, modified, callees);
+
+    for(const auto &callee : callees)
+    {
+      auto c_it = index.find(callee);
+      if(c_it == index.end())
+        continue;
+
+      calls[f].push_back(c_it->second);
+      if(c_it->second == f)
+        self_call[f] = true;
+    }
+  }
+
+  // Tarjan's algorithm, without recursion. It emits each strongly connected
+  // component after all the components it calls, i.e. bottom-up.
+  std::vector<std::vector<unsigned>> components;
+  {
+    const unsigned unvisited = functions.size();
+    std::vector<unsigned> order(functions.size(), unvisited);
+    std::vector<unsigned> low(functions.size(), 0);
+    std::vector<bool> on_stack(functions.size(), false);
+    std::vector<unsigned> stack;
+    std::vector<std::pair<unsigned, unsigned>> dfs; // function, next callee
+    unsigned counter = 0;
+
+    for(unsigned root = 0; root < functions.size(); root++)
+    {
+      if(order[root] != unvisited)
+        continue;
+
+      dfs.emplace_back(root, 0);
+      order[root] = low[root] = counter++;
+      stack.push_back(root);
+      on_stack[root] = true;
+
+      while(!dfs.empty())
+      {
+        unsigned f = dfs.back().first;
+        unsigned &next = dfs.back().second;
+
+        if(next < calls[f].size())
+        {
+          unsigned callee = calls[f][next++];
+          if(order[callee] == unvisited)
+          {
+            order[callee] = low[callee] = counter++;
+            stack.push_back(callee);
+            on_stack[callee] = true;
+            dfs.emplace_back(callee, 0);
+          }
+          else if(on_stack[callee])
+            low[f] = std::min(low[f], order[callee]);
+          continue;
+        }
+
+        dfs.pop_back();
+        if(!dfs.empty())
+          low[dfs.back().first] = std::min(low[dfs.back().first], low[f]);
+
+        if(low[f] != order[f])
+          continue;
+
+        components.emplace_back();
+        unsigned member;
+        do
+        {
+          member = stack.back();
+          stack.pop_back();
+          on_stack[member] = false;
+          components.back().push_back(member);
+        } while(member != f);
+      }
+    }
+  }
+
+  // Tarjan's algorithm numbers the components bottom-up already. They are
+  // summarised one at a time: the domains simplify and migrate expressions,
+  // which goes through the old irept reference counts, the string table
+  // and the cached crc of shared sub-expressions, none of which are
+  // synchronised.
+  for(unsigned c = 0; c < components.size(); c++)
+  {
+    std::vector<irep_idt> component;
+    for(const auto &f : components[c])
+      component.push_back(functions[f]);
+
+    bool recursive =
+      components[c].size() > 1 || self_call[components[c].front()];
+    summarise_component(component, recursive, goto_functions, ns);
+  }
 }
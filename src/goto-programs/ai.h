@@ -15,6 +15,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <iosfwd>
 #include <map>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 #include <goto-programs/ai_domain.h>
 #include <goto-programs/goto_functions.h>
 #include <util/xml.h>
@@ -40,6 +42,9 @@ public:
   typedef ai_domain_baset statet;
 
   ai_baset()
+    : widening_delay(2),
+      narrowing_sweeps(0),
+      function_summaries(false)
   {
   }
 
@@ -54,6 +59,7 @@ public:
     initialize(goto_program);
     entry_state(goto_program);
     fixedpoint(goto_program, goto_functions, ns);
+    narrowing(goto_program, goto_functions, ns);
     finalize();
   }
 
@@ -65,6 +71,29 @@ public:
     finalize();
   }
 
+  /// Number of times the state at a loop head may grow by merging before
+  /// widening takes over there
+  void set_widening_delay(unsigned delay)
+  {
+    widening_delay = delay;
+  }
+
+  /// Number of narrowing sweeps over each body after the fixedpoint is
+  /// reached, zero to keep the widened result
+  void set_narrowing_sweeps(unsigned sweeps)
+  {
+    narrowing_sweeps = sweeps;
+  }
+
+  /// Analyse each function once, from the entry state, and apply its summary
+  /// at the call sites rather than re-analysing the body for every caller.
+  /// Functions are scheduled bottom-up over the strongly connected
+  /// components of the call graph.
+  void set_function_summaries(bool enable)
+  {
+    function_summaries = enable;
+  }
+
   /// Accessing individual domains at particular locations
   /// (without needing to know what kind of domain or history is used)
   /// A pointer to a copy as the method should be const and
@@ -89,6 +118,9 @@ public:
   /// Resets the domain
   virtual void clear()
   {
+    widening_points.clear();
+    rpo_numbers.clear();
+    summaries.clear();
   }
 
   virtual void
@@ -106,17 +138,73 @@ protected:
   void entry_state(const goto_programt &);
   void entry_state(const goto_functionst &);
 
-  // the work-queue is sorted by location number
-  typedef std::unordered_map<unsigned, goto_programt::const_targett>
-    working_sett;
+  // the work-queue is sorted by reverse post-order, so that a location is
+  // usually visited after all its predecessors outside of loops
+  typedef std::map<unsigned, goto_programt::const_targett> working_sett;
+
+  // The position of each location in the reverse post-order of its body,
+  // numbered when the body is initialized
+  typedef std::unordered_map<
+    goto_programt::const_targett,
+    unsigned,
+    const_target_hash,
+    pointee_address_equalt>
+    rpo_numberst;
+  rpo_numberst rpo_numbers;
+
+  void number_rpo(const goto_programt &goto_program);
 
   goto_programt::const_targett get_next(working_sett &working_set);
 
+  // Loop heads, i.e. targets of backwards gotos, as goto_loopst finds them,
+  // with the number of times merging has grown the state there
+  typedef std::unordered_map<
+    goto_programt::const_targett,
+    unsigned,
+    const_target_hash,
+    pointee_address_equalt>
+    widening_pointst;
+  widening_pointst widening_points;
+
+  unsigned widening_delay;
+  unsigned narrowing_sweeps;
+  bool function_summaries;
+
+  // What a function does, as seen from its call sites: the join of the
+  // states reaching its END_FUNCTION from the entry state, and the l-values
+  // it or any function it calls may assign to
+  struct function_summaryt
+  {
+    std::unique_ptr<statet> state;
+    std::vector<expr2tc> modified;
+  };
+
+  // One entry for each function with a body, created before the analysis
+  // starts so that concurrent components never insert into the map
+  typedef std::unordered_map<irep_idt, function_summaryt, irep_id_hash>
+    summariest;
+  summariest summaries;
+
+  // Merges src into the state at to, widening at loop heads
+  // true = found something new
+  bool merge_or_widen(
+    const statet &src,
+    goto_programt::const_targett from,
+    goto_programt::const_targett to);
+
+  // Refines the states of a body that has reached its fixedpoint
+  void narrowing(
+    const goto_programt &goto_program,
+    const goto_functionst &goto_functions,
+    const namespacet &ns);
+
   void
   put_in_working_set(working_sett &working_set, goto_programt::const_targett l)
   {
+    rpo_numberst::const_iterator it = rpo_numbers.find(l);
+    assert(it != rpo_numbers.end());
     working_set.insert(
-      std::pair<unsigned, goto_programt::const_targett>(l->location_number, l));
+      std::pair<unsigned, goto_programt::const_targett>(it->second, l));
   }
 
   // true = found something new
@@ -132,6 +220,20 @@ protected:
     const goto_functionst &goto_functions,
     const namespacet &ns);
 
+  // Analyses the call graph bottom-up, summarising each function
+  void summary_fixedpoint(
+    const goto_functionst &goto_functions,
+    const namespacet &ns);
+
+  // Analyses the functions of one strongly connected component of the call
+  // graph until their summaries are stable. The summaries of the functions
+  // they call outside the component must be complete.
+  void summarise_component(
+    const std::vector<irep_idt> &component,
+    bool recursive,
+    const goto_functionst &goto_functions,
+    const namespacet &ns);
+
   // Visit performs one step of abstract interpretation from location l
   // Depending on the instruction type it may compute a number of "edges"
   // or applications of the abstract transformer
@@ -158,12 +260,44 @@ protected:
     const goto_functionst::function_mapt::const_iterator f_it,
     const namespacet &ns);
 
+  // the edge call -> return, through the callee's summary
+  bool do_summary_call(
+    goto_programt::const_targett l_call,
+    goto_programt::const_targett l_return,
+    const expr2tc &function,
+    const namespacet &ns);
+
   // abstract methods
 
   virtual bool merge(
     const statet &src,
     goto_programt::const_targett from,
     goto_programt::const_targett to) = 0;
+  virtual bool widen(
+    const statet &src,
+    goto_programt::const_targett from,
+    goto_programt::const_targett to) = 0;
+  virtual bool narrow(
+    const statet &src,
+    goto_programt::const_targett from,
+    goto_programt::const_targett to) = 0;
+  // like merge and widen, into a temporary state rather than the one at to
+  virtual bool merge_temporary(
+    statet &dest,
+    const statet &src,
+    goto_programt::const_targett from,
+    goto_programt::const_targett to) = 0;
+  virtual bool widen_temporary(
+    statet &dest,
+    const statet &src,
+    goto_programt::const_targett from,
+    goto_programt::const_targett to) = 0;
+  // for function summaries
+  virtual void apply_summary(
+    statet &dest,
+    const statet &summary,
+    const std::vector<expr2tc> &modified,
+    const namespacet &ns) = 0;
   // for concurrent fixedpoint
   virtual bool merge_shared(
     const statet &src,
@@ -258,6 +392,56 @@ protected:
       static_cast<const domainT &>(src), from, to);
   }
 
+  bool widen(
+    const statet &src,
+    goto_programt::const_targett from,
+    goto_programt::const_targett to) override
+  {
+    statet &dest = get_state(to);
+    return static_cast<domainT &>(dest).widen(
+      static_cast<const domainT &>(src), from, to);
+  }
+
+  bool narrow(
+    const statet &src,
+    goto_programt::const_targett from,
+    goto_programt::const_targett to) override
+  {
+    statet &dest = get_state(to);
+    return static_cast<domainT &>(dest).narrow(
+      static_cast<const domainT &>(src), from, to);
+  }
+
+  bool merge_temporary(
+    statet &dest,
+    const statet &src,
+    goto_programt::const_targett from,
+    goto_programt::const_targett to) override
+  {
+    return static_cast<domainT &>(dest).merge(
+      static_cast<const domainT &>(src), from, to);
+  }
+
+  bool widen_temporary(
+    statet &dest,
+    const statet &src,
+    goto_programt::const_targett from,
+    goto_programt::const_targett to) override
+  {
+    return static_cast<domainT &>(dest).widen(
+      static_cast<const domainT &>(src), from, to);
+  }
+
+  void apply_summary(
+    statet &dest,
+    const statet &summary,
+    const std::vector<expr2tc> &modified,
+    const namespacet &ns) override
+  {
+    static_cast<domainT &>(dest).apply_summary(
+      static_cast<const domainT &>(summary), modified, ns);
+  }
+
   std::unique_ptr<statet> make_temporary_state(const statet &s) override
   {
     return util_make_unique<domainT>(static_cast<const domainT &>(s));
@@ -266,7 +450,10 @@ protected:
   void fixedpoint(const goto_functionst &goto_functions, const namespacet &ns)
     override
   {
-    sequential_fixedpoint(goto_functions, ns);
+    if(function_summaries)
+      summary_fixedpoint(goto_functions, ns);
+    else
+      sequential_fixedpoint(goto_functions, ns);
   }
 
 private:
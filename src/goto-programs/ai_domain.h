@@ -82,6 +82,31 @@ public:
   /// PRECONDITION(from.is_dereferenceable(), "Must not be _::end()")
   /// PRECONDITION(to.is_dereferenceable(), "Must not be _::end()")
 
+  /// and
+  ///
+  ///   bool widen(const T &b, const_targett from, const_targett to);
+  ///   bool narrow(const T &b, const_targett from, const_targett to);
+  ///
+  /// widen is used instead of merge at loop heads, once merging there has
+  /// grown the state a few times: it must over-approximate the join and
+  /// ensure that any sequence of widenings stabilises. narrow refines a
+  /// stable "this" using "b", the join of all edges into "to" recomputed from
+  /// the stable states; any sequence of narrowings must also stabilise.
+  /// Both return true if "this" has changed.
+
+  /// and, for ai_baset::set_function_summaries,
+  ///
+  ///   void apply_summary(
+  ///     const T &summary,
+  ///     const std::vector<expr2tc> &modified,
+  ///     const namespacet &ns);
+  ///
+  /// "this" is the state after the edge from a call to its return site,
+  /// "summary" the join of the callee's end states from the entry state and
+  /// "modified" the l-values the callee may assign to, directly or not. It
+  /// must forget what the callee may change, and may keep what "summary"
+  /// knows about it that holds regardless of the calling context.
+
   /// This method allows an expression to be simplified / evaluated using the
   /// current state.  It is used to evaluate assertions and in program
   /// simplification
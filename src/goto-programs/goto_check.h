@@ -14,6 +14,11 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/namespace.h>
 #include <util/options.h>
 
+void goto_check(
+  const namespacet &ns,
+  optionst &options,
+  goto_programt &goto_program);
+
 void goto_check(
   const namespacet &ns,
   optionst &options,
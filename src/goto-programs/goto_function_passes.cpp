@@ -0,0 +1,22 @@
+/*******************************************************************\
+
+Module: Program Transformation, run function by function
+
+\*******************************************************************/
+
+#include <goto-programs/goto_function_passes.h>
+
+void goto_function_passest::operator()(goto_functionst &goto_functions) const
+{
+  Forall_goto_functions(f_it, goto_functions)
+  {
+    goto_programt &body = f_it->second.body;
+    if(body.empty())
+      continue;
+
+    for(const passt &pass : passes)
+      pass(body);
+  }
+
+  goto_functions.update();
+}
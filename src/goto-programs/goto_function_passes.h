@@ -0,0 +1,36 @@
+/*******************************************************************\
+
+Module: Program Transformation, run function by function
+
+\*******************************************************************/
+
+#ifndef CPROVER_GOTO_PROGRAMS_GOTO_FUNCTION_PASSES_H
+#define CPROVER_GOTO_PROGRAMS_GOTO_FUNCTION_PASSES_H
+
+#include <functional>
+#include <goto-programs/goto_functions.h>
+#include <vector>
+
+/// A pipeline of transformations that only look at one function body at a
+/// time. Every pass runs on a body before the next body is touched, so each
+/// body is walked while it is still in cache rather than once per pass, and
+/// the numbering of the whole program is recomputed once at the end rather
+/// than after every pass. Bodies are visited in function map order, so the
+/// result does not depend on how the passes are grouped.
+class goto_function_passest
+{
+public:
+  typedef std::function<void(goto_programt &)> passt;
+
+  void add(passt pass)
+  {
+    passes.push_back(std::move(pass));
+  }
+
+  void operator()(goto_functionst &goto_functions) const;
+
+protected:
+  std::vector<passt> passes;
+};
+
+#endif
@@ -96,9 +96,17 @@ void instrument_intervals(
   }
 }
 
-void interval_analysis(goto_functionst &goto_functions, const namespacet &ns)
+void interval_analysis(
+  goto_functionst &goto_functions,
+  const namespacet &ns,
+  const optionst &options)
 {
   ait<interval_domaint> interval_analysis;
+  if(options.get_bool_option("interval-analysis-narrowing"))
+    interval_analysis.set_narrowing_sweeps(2);
+
+  if(options.get_bool_option("interval-analysis-summaries"))
+    interval_analysis.set_function_summaries(true);
 
   interval_analysis(goto_functions, ns);
 
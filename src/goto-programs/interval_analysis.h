@@ -13,7 +13,11 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_ANALYSES_INTERVAL_ANALYSIS_H
 
 #include <goto-programs/goto_functions.h>
+#include <util/options.h>
 
-void interval_analysis(goto_functionst &goto_functions, const namespacet &ns);
+void interval_analysis(
+  goto_functionst &goto_functions,
+  const namespacet &ns,
+  const optionst &options);
 
 #endif // CPROVER_ANALYSES_INTERVAL_ANALYSIS_H
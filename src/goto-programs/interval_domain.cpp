@@ -24,7 +24,7 @@ void interval_domaint::output(std::ostream &out) const
     return;
   }
 
-  for(const auto &interval : int_map)
+  for(const auto &interval : get_int_map())
   {
     if(interval.second.is_top())
       continue;
@@ -105,7 +105,7 @@ void interval_domaint::transform(
 /// \par parameters: The interval domain, b, to join to this domain.
 /// \return True if the join increases the set represented by *this, False if
 ///   there is no change.
-bool interval_domaint::join(const interval_domaint &b)
+bool interval_domaint::join_with(const interval_domaint &b, bool widening)
 {
   if(b.bottom)
     return false;
@@ -115,38 +115,251 @@ bool interval_domaint::join(const interval_domaint &b)
     return true;
   }
 
-  bool result = false;
+  // Sharing the intervals is the common case when nothing changes
+  if(int_map == b.int_map)
+    return false;
+
+  auto combine = [widening](
+                   integer_intervalt &dest, const integer_intervalt &src) {
+    if(widening)
+      dest.widen(src);
+    else
+      dest.join(src);
+  };
 
-  for(int_mapt::iterator it = int_map.begin(); it != int_map.end();) // no it++
+  // Look for a change before unsharing the intervals to make it
+  bool result = false;
+  for(const auto &interval : get_int_map())
   {
-    // search for the variable that needs to be merged
-    // containers have different size and variable order
-    const int_mapt::const_iterator b_it = b.int_map.find(it->first);
-    if(b_it == b.int_map.end())
+    const int_mapt::const_iterator b_it = b.get_int_map().find(interval.first);
+    if(b_it == b.get_int_map().end())
     {
-      it = int_map.erase(it);
       result = true;
+      break;
     }
-    else
+
+    integer_intervalt tmp = interval.second;
+    combine(tmp, b_it->second);
+    if(tmp != interval.second)
     {
-      integer_intervalt previous = it->second;
-      it->second.join(b_it->second);
-      if(it->second != previous)
-        result = true;
+      result = true;
+      break;
+    }
+  }
 
+  if(!result)
+    return false;
+
+  int_mapt &map = write_int_map();
+  for(int_mapt::iterator it = map.begin(); it != map.end();) // no it++
+  {
+    // search for the variable that needs to be merged
+    // containers have different size and variable order
+    const int_mapt::const_iterator b_it = b.get_int_map().find(it->first);
+    if(b_it == b.get_int_map().end())
+      it = map.erase(it);
+    else
+    {
+      combine(it->second, b_it->second);
       it++;
     }
   }
 
+  return true;
+}
+
+/// Restores the bounds that widening dropped from *this, as far as b, the
+/// state recomputed from the widened result, has them. Variables missing
+/// from *this are unbounded, so they take b's interval.
+/// \return True if *this has changed.
+bool interval_domaint::narrow(
+  const interval_domaint &b,
+  goto_programt::const_targett,
+  goto_programt::const_targett)
+{
+  if(bottom || b.bottom || int_map == b.int_map)
+    return false;
+
+  bool result = false;
+
+  for(const auto &b_interval : b.get_int_map())
+  {
+    const int_mapt::const_iterator it = get_int_map().find(b_interval.first);
+    integer_intervalt interval =
+      it == get_int_map().end() ? integer_intervalt() : it->second;
+
+    integer_intervalt previous = interval;
+    interval.narrow(b_interval.second);
+    if(interval == previous)
+      continue;
+
+    result = true;
+    if(interval.is_bottom())
+    {
+      make_bottom();
+      break;
+    }
+
+    write_int_map()[b_interval.first] = interval;
+  }
+
   return result;
 }
 
+/// Applies the summary of a function to *this, the state after the edge
+/// from a call to its return site: the variables the function may assign to
+/// are forgotten, then global ones take their interval from the summary.
+/// Locals keep no interval, as a recursive call has its own instances.
+void interval_domaint::apply_summary(
+  const interval_domaint &summary,
+  const std::vector<expr2tc> &modified,
+  const namespacet &ns)
+{
+  if(bottom)
+    return;
+
+  if(summary.bottom)
+  {
+    make_bottom();
+    return;
+  }
+
+  for(const auto &expr : modified)
+    havoc_rec(expr);
+
+  for(const auto &expr : modified)
+  {
+    if(!is_symbol2t(expr) || !is_bv_type(expr))
+      continue;
+
+    const irep_idt &identifier = to_symbol2t(expr).thename;
+    const int_mapt::const_iterator s_it =
+      summary.get_int_map().find(identifier);
+    if(s_it == summary.get_int_map().end())
+      continue;
+
+    const symbolt *symbol;
+    if(ns.lookup(identifier, symbol) || !symbol->static_lifetime)
+      continue;
+
+    integer_intervalt &ii = write_int_map()[identifier];
+    ii.meet(s_it->second);
+    if(ii.is_bottom())
+    {
+      make_bottom();
+      return;
+    }
+  }
+}
+
+const interval_domaint::int_mapt &interval_domaint::get_int_map() const
+{
+  static const int_mapt empty;
+  return int_map ? *int_map : empty;
+}
+
+interval_domaint::int_mapt &interval_domaint::write_int_map()
+{
+  if(!int_map)
+    int_map = std::make_shared<int_mapt>();
+  else if(int_map.use_count() > 1)
+    int_map = std::make_shared<int_mapt>(*int_map);
+
+  return *int_map;
+}
+
+/// The values of a bitvector type, or top for any other type
+static integer_intervalt type_range(const type2tc &type)
+{
+  if(!is_bv_type(type))
+    return integer_intervalt();
+
+  unsigned int width = type->get_width();
+  BigInt max;
+  if(is_signedbv_type(type))
+  {
+    max.setPower2(width - 1);
+    return integer_intervalt(-max, max - 1);
+  }
+
+  max.setPower2(width);
+  return integer_intervalt(BigInt(0), max - 1);
+}
+
 void interval_domaint::assign(const expr2tc &expr)
 {
   assert(is_code_assign2t(expr));
   auto const &c = to_code_assign2t(expr);
+
+  // Evaluate the source first, it may read the target
+  integer_intervalt value;
+  if(is_symbol2t(c.target) && is_bv_type(c.target) && is_bv_type(c.source))
+    value = get_int_rec(c.source);
+
   havoc_rec(c.target);
   assume_rec(c.target, expr2t::equality_id, c.source);
+
+  // Anything in the target's type is no constraint at all
+  if(value.is_top() || value == type_range(c.target->type))
+    return;
+
+  integer_intervalt &ii = write_int_map()[to_symbol2t(c.target).thename];
+  ii.meet(value);
+  if(ii.is_bottom())
+    make_bottom();
+}
+
+/// Over-approximates the values expr may take. Integer expressions always
+/// get both bounds, from their type if nothing better is known, so that
+/// arithmetic on them can tell when it may wrap around.
+integer_intervalt interval_domaint::get_int_rec(const expr2tc &expr) const
+{
+  integer_intervalt range = type_range(expr->type);
+  if(range.is_top())
+    return range;
+
+  integer_intervalt result;
+  if(is_constant_int2t(expr))
+    result = integer_intervalt(to_constant_int2t(expr).value);
+  else if(is_symbol2t(expr))
+  {
+    int_mapt::const_iterator it = get_int_map().find(to_symbol2t(expr).thename);
+    if(it != get_int_map().end())
+      result = it->second;
+  }
+  else if(is_typecast2t(expr))
+    result = get_int_rec(to_typecast2t(expr).from);
+  else if(is_add2t(expr) || is_sub2t(expr))
+  {
+    const arith_2ops &op = static_cast<const arith_2ops &>(*expr);
+    integer_intervalt a = get_int_rec(op.side_1);
+    integer_intervalt b = get_int_rec(op.side_2);
+    if(a.is_top() || b.is_top())
+      return range;
+
+    // Operands of integer type always have both bounds
+    if(is_add2t(expr))
+      result = integer_intervalt(a.lower + b.lower, a.upper + b.upper);
+    else
+      result = integer_intervalt(a.lower - b.upper, a.upper - b.lower);
+  }
+  else if(is_neg2t(expr))
+  {
+    integer_intervalt a = get_int_rec(to_neg2t(expr).value);
+    if(a.is_top())
+      return range;
+
+    result = integer_intervalt(-a.upper, -a.lower);
+  }
+
+  // A value the type can't hold wraps around to any other
+  if(
+    (result.lower_set && result.lower < range.lower) ||
+    (result.upper_set && result.upper > range.upper))
+    return range;
+
+  result.meet(range);
+  return result;
 }
 
 void interval_domaint::havoc_rec(const expr2tc &expr)
@@ -160,8 +373,8 @@ void interval_domaint::havoc_rec(const expr2tc &expr)
   {
     irep_idt identifier = to_symbol2t(expr).thename;
 
-    if(is_bv_type(expr))
-      int_map.erase(identifier);
+    if(is_bv_type(expr) && get_int_map().count(identifier) != 0)
+      write_int_map().erase(identifier);
   }
   else if(is_typecast2t(expr))
   {
@@ -210,7 +423,7 @@ void interval_domaint::assume_rec(
       BigInt tmp = to_constant_int2t(rhs).value;
       if(id == expr2t::lessthan_id)
         --tmp;
-      integer_intervalt &ii = int_map[lhs_identifier];
+      integer_intervalt &ii = write_int_map()[lhs_identifier];
       ii.make_le_than(tmp);
       if(ii.is_bottom())
         make_bottom();
@@ -225,7 +438,7 @@ void interval_domaint::assume_rec(
       BigInt tmp = to_constant_int2t(lhs).value;
       if(id == expr2t::lessthan_id)
         ++tmp;
-      integer_intervalt &ii = int_map[rhs_identifier];
+      integer_intervalt &ii = write_int_map()[rhs_identifier];
       ii.make_ge_than(tmp);
       if(ii.is_bottom())
         make_bottom();
@@ -238,8 +451,9 @@ void interval_domaint::assume_rec(
 
     if(is_bv_type(lhs) && is_bv_type(rhs))
     {
-      integer_intervalt &lhs_i = int_map[lhs_identifier];
-      integer_intervalt &rhs_i = int_map[rhs_identifier];
+      int_mapt &map = write_int_map();
+      integer_intervalt &lhs_i = map[lhs_identifier];
+      integer_intervalt &rhs_i = map[rhs_identifier];
       lhs_i.meet(rhs_i);
       rhs_i = lhs_i;
       if(rhs_i.is_bottom())
@@ -314,8 +528,8 @@ expr2tc interval_domaint::make_expression(const expr2tc &expr) const
   symbol2t src = to_symbol2t(expr);
   if(is_bv_type(expr))
   {
-    int_mapt::const_iterator i_it = int_map.find(src.thename);
-    if(i_it == int_map.end())
+    int_mapt::const_iterator i_it = get_int_map().find(src.thename);
+    if(i_it == get_int_map().end())
       return gen_true_expr();
 
     const integer_intervalt &interval = i_it->second;
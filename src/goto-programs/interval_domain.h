@@ -14,6 +14,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <goto-programs/ai.h>
 #include <goto-programs/interval_template.h>
+#include <memory>
 #include <util/ieee_float.h>
 #include <util/irep2_utils.h>
 #include <util/mp_arith.h>
@@ -45,7 +46,12 @@ public:
   }
 
 protected:
-  bool join(const interval_domaint &b);
+  bool join(const interval_domaint &b)
+  {
+    return join_with(b, false);
+  }
+
+  bool join_with(const interval_domaint &b, bool widening);
 
 public:
   bool merge(
@@ -56,17 +62,35 @@ public:
     return join(b);
   }
 
+  bool widen(
+    const interval_domaint &b,
+    goto_programt::const_targett,
+    goto_programt::const_targett)
+  {
+    return join_with(b, true);
+  }
+
+  bool narrow(
+    const interval_domaint &b,
+    goto_programt::const_targett from,
+    goto_programt::const_targett to);
+
+  void apply_summary(
+    const interval_domaint &summary,
+    const std::vector<expr2tc> &modified,
+    const namespacet &ns);
+
   // no states
   void make_bottom() final override
   {
-    int_map.clear();
+    int_map.reset();
     bottom = true;
   }
 
   // all states
   void make_top() final override
   {
-    int_map.clear();
+    int_map.reset();
     bottom = false;
   }
 
@@ -79,7 +103,7 @@ public:
   {
 #if 0
     // This invariant should hold but is not correctly enforced at the moment.
-    assert(!bottom || (int_map.empty() && float_map.empty()));
+    assert(!bottom || get_int_map().empty());
 #endif
 
     return bottom;
@@ -87,7 +111,7 @@ public:
 
   bool is_top() const override final
   {
-    return !bottom && int_map.empty();
+    return !bottom && get_int_map().empty();
   }
 
   expr2tc make_expression(const expr2tc &expr) const;
@@ -103,13 +127,20 @@ protected:
   typedef std::unordered_map<irep_idt, integer_intervalt, irep_id_hash>
     int_mapt;
 
-  int_mapt int_map;
+  // Variables without an entry are unconstrained. The map is shared between
+  // copies of a state until one of them writes to it, as the analysis copies
+  // a state for every edge it follows and most edges change little; null
+  // stands for the empty map.
+  std::shared_ptr<int_mapt> int_map;
+
+  const int_mapt &get_int_map() const;
+  int_mapt &write_int_map();
 
   void havoc_rec(const expr2tc &expr);
   void assume_rec(const expr2tc &expr, bool negation = false);
   void assume_rec(const expr2tc &lhs, expr2t::expr_ids id, const expr2tc &rhs);
   void assign(const expr2tc &assignment);
-  integer_intervalt get_int_rec(const expr2tc &expr);
+  integer_intervalt get_int_rec(const expr2tc &expr) const;
 };
 
 #endif // CPROVER_ANALYSES_INTERVAL_DOMAIN_H
@@ -106,6 +106,33 @@ public:
     intersect_with(i);
   }
 
+  // Union, giving up on any bound i goes beyond: applied at loop heads,
+  // bounds can only be dropped, so the iteration there terminates
+  void widen(const interval_templatet<T> &i)
+  {
+    if(lower_set && (!i.lower_set || i.lower < lower))
+      lower_set = false;
+
+    if(upper_set && (!i.upper_set || i.upper > upper))
+      upper_set = false;
+  }
+
+  // Restores the bounds widening dropped, as far as i has them
+  void narrow(const interval_templatet<T> &i)
+  {
+    if(!lower_set && i.lower_set)
+    {
+      lower_set = true;
+      lower = i.lower;
+    }
+
+    if(!upper_set && i.upper_set)
+    {
+      upper_set = true;
+      upper = i.upper;
+    }
+  }
+
   void intersect_with(const interval_templatet &i)
   {
     if(i.lower_set)
@@ -20,15 +20,12 @@ Date: June 2006
 
 #define BINARY_VERSION 1
 
-bool read_bin_goto_object(
+static bool read_bin_goto_header(
   std::istream &in,
   const std::string &filename,
-  contextt &context,
-  goto_functionst &functions,
-  message_handlert &message_handler)
+  irep_serializationt &irepconverter,
+  message_streamt &message_stream)
 {
-  message_streamt message_stream(message_handler);
-
   {
     char hdr[4];
     hdr[0] = in.get();
@@ -53,15 +50,10 @@ bool read_bin_goto_object(
 
       message_stream.error();
 
-      return false;
+      return true;
     }
   }
 
-  irep_serializationt::ireps_containert ic;
-  irep_serializationt irepconverter(ic);
-  symbol_serializationt symbolconverter(ic);
-  goto_function_serializationt gfconverter(ic);
-
   {
     unsigned version = irepconverter.read_long(in);
 
@@ -71,10 +63,20 @@ bool read_bin_goto_object(
         << "The input was compiled with a different version of "
         << "goto-cc, please recompile";
       message_stream.warning();
-      return false;
+      return true;
     }
   }
 
+  return false;
+}
+
+static void read_bin_goto_symbol_table(
+  std::istream &in,
+  irep_serializationt &irepconverter,
+  symbol_serializationt &symbolconverter,
+  contextt &context,
+  goto_functionst *functions)
+{
   unsigned count = irepconverter.read_long(in);
 
   for(unsigned i = 0; i < count; i++)
@@ -84,17 +86,38 @@ bool read_bin_goto_object(
     symbolt symbol;
     symbol.from_irep(t);
 
-    if(!symbol.is_type && symbol.type.is_code())
+    if(functions && !symbol.is_type && symbol.type.is_code())
     {
       // makes sure there is an empty function
       // for every function symbol and fixes
       // the function types.
-      functions.function_map[symbol.id].type = to_code_type(symbol.type);
+      functions->function_map[symbol.id].type = to_code_type(symbol.type);
     }
     context.add(symbol);
   }
+}
+
+bool read_bin_goto_object(
+  std::istream &in,
+  const std::string &filename,
+  contextt &context,
+  goto_functionst &functions,
+  message_handlert &message_handler)
+{
+  message_streamt message_stream(message_handler);
+
+  irep_serializationt::ireps_containert ic;
+  irep_serializationt irepconverter(ic);
+  symbol_serializationt symbolconverter(ic);
+  goto_function_serializationt gfconverter(ic);
 
-  count = irepconverter.read_long(in);
+  if(read_bin_goto_header(in, filename, irepconverter, message_stream))
+    return false;
+
+  read_bin_goto_symbol_table(
+    in, irepconverter, symbolconverter, context, &functions);
+
+  unsigned count = irepconverter.read_long(in);
   for(unsigned i = 0; i < count; i++)
   {
     irept t;
@@ -107,3 +130,24 @@ bool read_bin_goto_object(
 
   return false;
 }
+
+bool read_bin_goto_symbols(
+  std::istream &in,
+  const std::string &filename,
+  contextt &context,
+  message_handlert &message_handler)
+{
+  message_streamt message_stream(message_handler);
+
+  irep_serializationt::ireps_containert ic;
+  irep_serializationt irepconverter(ic);
+  symbol_serializationt symbolconverter(ic);
+
+  if(read_bin_goto_header(in, filename, irepconverter, message_stream))
+    return true;
+
+  // The goto function bodies follow the symbol table; we stop before them.
+  read_bin_goto_symbol_table(
+    in, irepconverter, symbolconverter, context, nullptr);
+  return false;
+}
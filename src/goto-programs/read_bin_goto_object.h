@@ -22,4 +22,14 @@ bool read_bin_goto_object(
   goto_functionst &functions,
   message_handlert &msg_hndlr);
 
+/**
+ *  Read only the symbol table of a goto binary, skipping the goto function
+ *  bodies. Returns true on error.
+ */
+bool read_bin_goto_symbols(
+  std::istream &in,
+  const std::string &filename,
+  contextt &context,
+  message_handlert &msg_hndlr);
+
 #endif /*READ_BIN_GOTO_OBJECT_H_*/
@@ -16,6 +16,11 @@ bool is_skip(
   goto_programt::const_targett,
   bool ignore_labels = false);
 void remove_skip(goto_programt &goto_program);
+// Doesn't renumber the program: the caller has to update() it afterwards
+void remove_skip(
+  goto_programt &goto_program,
+  goto_programt::targett begin,
+  goto_programt::targett end);
 void remove_skip(goto_functionst &goto_functions);
 
 #endif
@@ -54,6 +54,9 @@ void build_goto_trace(
   std::shared_ptr<smt_convt> &smt_conv,
   goto_tracet &goto_trace)
 {
+  // Steps share guards and index expressions; query each of them only once
+  smt_convt::model_batcht batch(*smt_conv);
+
   unsigned step_nr = 0;
 
   for(auto const &SSA_step : target->SSA_steps)
@@ -74,7 +77,7 @@ void build_goto_trace(
     goto_trace_step.step_nr = ++step_nr;
     goto_trace_step.format_string = SSA_step.format_string;
 
-    goto_trace_step.stack_trace = SSA_step.stack_trace;
+    goto_trace_step.stack_trace = SSA_step.get_stack_trace();
 
     if(SSA_step.is_assignment())
     {
@@ -140,7 +143,7 @@ void build_successful_goto_trace(
       goto_trace_step.type = it->type;
       goto_trace_step.step_nr = step_nr++;
       goto_trace_step.format_string = it->format_string;
-      goto_trace_step.stack_trace = it->stack_trace;
+      goto_trace_step.stack_trace = it->get_stack_trace();
     }
   }
 }
@@ -1041,36 +1041,32 @@ bool execution_statet::can_execution_continue() const
   return true;
 }
 
-crypto_hash execution_statet::generate_hash() const
+fast_hash::digestt execution_statet::generate_hash() const
 {
   auto l2 = std::dynamic_pointer_cast<state_hashing_level2t>(state_level2);
   assert(l2 != nullptr);
 
-  crypto_hash state = l2->generate_l2_state_hash();
-  std::string str = state.to_string();
+  fast_hash::digestt state = l2->generate_l2_state_hash();
 
+  fast_hash h;
+  h.ingest(state.data(), sizeof(state));
   for(const auto &it : threads_state)
   {
-    goto_programt::const_targett pc = it.source.pc;
-    int id = pc->location_number;
-    std::stringstream s;
-    s << id;
-    str += "!" + s.str();
+    unsigned int id = it.source.pc->location_number;
+    h.ingest(&id, sizeof(id));
   }
-
-  crypto_hash h;
-  h.ingest(str.c_str(), str.size());
   h.fin();
 
-  return h;
+  return h.hash;
 }
 
-crypto_hash execution_statet::update_hash_for_assignment(const expr2tc &rhs)
+fast_hash::digestt
+execution_statet::update_hash_for_assignment(const expr2tc &rhs)
 {
-  crypto_hash h;
+  fast_hash h;
   rhs->hash(h);
   h.fin();
-  return h;
+  return h.hash;
 }
 
 void execution_statet::print_stack_traces(unsigned int indent) const
@@ -1263,40 +1259,28 @@ void execution_statet::state_hashing_level2t::make_assignment(
   const expr2tc &const_value,
   const expr2tc &assigned_value)
 {
-  //  crypto_hash hash;
-
   renaming::level2t::make_assignment(lhs_sym, const_value, assigned_value);
 
   // If there's no body to the assignment, don't hash.
   if(!is_nil_expr(assigned_value))
   {
     // XXX - consider whether to use l1 names instead. Recursion, reentrancy.
-    crypto_hash hash = owner->update_hash_for_assignment(assigned_value);
-    std::string orig_name = to_symbol2t(lhs_sym).thename.as_string();
-    current_hashes[orig_name] = hash;
+    current_hashes[to_symbol2t(lhs_sym).thename] =
+      owner->update_hash_for_assignment(assigned_value);
   }
 }
 
-crypto_hash
+fast_hash::digestt
 execution_statet::state_hashing_level2t::generate_l2_state_hash() const
 {
-  unsigned int total;
-
-  uint8_t *data = (uint8_t *)alloca(
-    current_hashes.size() * CRYPTO_HASH_SIZE * sizeof(uint8_t));
-
-  total = 0;
-  for(const auto &current_hashe : current_hashes)
+  fast_hash c;
+  for(const auto &current_hash : current_hashes)
   {
-    memcpy(
-      &data[total * CRYPTO_HASH_SIZE],
-      current_hashe.second.hash,
-      CRYPTO_HASH_SIZE);
-    total++;
+    unsigned int name = current_hash.first.get_no();
+    c.ingest(&name, sizeof(name));
+    c.ingest(current_hash.second.data(), sizeof(current_hash.second));
   }
 
-  crypto_hash c;
-  c.ingest(data, total * CRYPTO_HASH_SIZE);
   c.fin();
-  return c;
+  return c.hash;
 }
@@ -15,6 +15,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <map>
 #include <pointer-analysis/dereference.h>
 #include <stack>
+#include <unordered_map>
 #include <util/i2string.h>
 #include <util/irep2.h>
 #include <util/options.h>
@@ -342,6 +343,49 @@ protected:
    */
   virtual void symex_function_call_code(const expr2tc &call);
 
+  /**
+   *  Summary of a function whose only effect is the value it returns.
+   *  Built once from the function body, over the symbols of its parameters
+   *  and of the globals it reads; calls then assign it to their return
+   *  destination with the arguments put in for the parameters. Reads
+   *  through pointers stay dereferences, resolved at each call with the
+   *  value sets of its arguments.
+   */
+  struct function_summaryt
+  {
+    /** Whether the function could be summarised at all. */
+    bool valid = false;
+    /** Whether value reads global variables or memory through pointers. */
+    bool reads_globals = false;
+    /** Value returned by the function. */
+    expr2tc value;
+  };
+
+  typedef std::unordered_map<irep_idt, function_summaryt, irep_id_hash>
+    function_summariest;
+
+  /**
+   *  Fetch the summary of a function, building it on first use.
+   *  @param identifier Name of the function.
+   *  @param goto_function Its body.
+   *  @return The summary, which is not valid if there can't be one.
+   */
+  const function_summaryt &get_function_summary(
+    const irep_idt &identifier,
+    const goto_functiont &goto_function);
+
+  /**
+   *  Perform a function call through the function's summary, if it has one.
+   *  @param call Function call we're working on.
+   *  @param identifier Name of the called function.
+   *  @param goto_function Its body.
+   *  @return True if the call was performed, false if it must be run.
+   */
+  bool symex_summarised_call(
+    const code_function_call2t &call,
+    const irep_idt &identifier,
+    const goto_functiont &goto_function);
+
   /**
    *  Discover whether recursion bound has been exceeded.
    *  @see get_unwind
@@ -793,6 +837,10 @@ protected:
   bool no_return_value_opt;
   /** Limit size for stack */
   unsigned long stack_limit;
+  /** Whether calls to functions that only compute a value use summaries */
+  bool use_function_summaries;
+  /** Summaries built so far, shared by all copies of this object */
+  std::shared_ptr<function_summariest> function_summaries;
   /** Depth limit, as given by the --depth option */
   unsigned long depth_limit;
   /** Instruction number we are to break at -- that is, trap, to the debugger.
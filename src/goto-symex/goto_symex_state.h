@@ -21,7 +21,7 @@
 #include <stack>
 #include <string>
 #include <unordered_set>
-#include <util/crypto_hash.h>
+#include <util/fast_hash.h>
 #include <util/guard.h>
 #include <util/i2string.h>
 #include <util/irep2.h>
@@ -18,7 +18,6 @@ Author: Lucas Cordeiro, lcc08r@ecs.soton.ac.uk
 #include <goto-symex/goto_symex.h>
 #include <goto-symex/reachability_tree.h>
 #include <util/config.h>
-#include <util/crypto_hash.h>
 #include <util/expr_util.h>
 #include <util/i2string.h>
 #include <util/message.h>
@@ -127,8 +126,7 @@ bool reachability_treet::check_for_hash_collision() const
 {
   const execution_statet &ex_state = get_cur_state();
 
-  crypto_hash hash;
-  hash = ex_state.generate_hash();
+  fast_hash::digestt hash = ex_state.generate_hash();
   if(hit_hashes.find(hash) != hit_hashes.end())
     return true;
 
@@ -145,9 +143,7 @@ void reachability_treet::update_hash_collision_set()
 {
   execution_statet &ex_state = get_cur_state();
 
-  crypto_hash hash;
-  hash = ex_state.generate_hash();
-  hit_hashes.insert(hash);
+  hit_hashes.insert(ex_state.generate_hash());
 }
 
 void reachability_treet::create_next_state()
@@ -18,7 +18,7 @@ Author: Lucas Cordeiro, lcc08r@ecs.soton.ac.uk
 #include <iostream>
 #include <unordered_map>
 #include <unordered_set>
-#include <util/crypto_hash.h>
+#include <util/fast_hash.h>
 #include <util/message.h>
 #include <util/options.h>
 
@@ -367,7 +367,7 @@ protected:
   /** Whether partial-order-reduction is enabled */
   bool por;
   /** Set of state hashes we've discovered */
-  std::set<crypto_hash> hit_hashes;
+  std::unordered_set<fast_hash::digestt, fast_hash::digest_hash> hit_hashes;
   /** Message handler reference. */
   message_handlert &message_handler;
   /** Flag as to whether we're picking interleaving directions explicitly.
@@ -1,3 +1,4 @@
+#include <bitset>
 #include <goto-symex/renaming.h>
 #include <langapi/language_util.h>
 #include <util/irep2.h>
@@ -325,3 +326,285 @@ void renaming::level2t::rename_to_record(expr2tc &expr, const name_record &rec)
   sym.thread_num = rec.t_num;
   sym.rlevel = rec.lev;
 }
+
+namespace
+{
+typedef renaming::level2t::current_namest current_namest;
+typedef current_namest::nodet nodet;
+
+// Position among the children present of the child on way w
+unsigned int child_pos(const nodet &n, unsigned int w)
+{
+  return std::bitset<32>(n.bitmap & ((1u << w) - 1)).count();
+}
+
+// Give this map its own copy of n, if another map holds it too
+void unshare(std::shared_ptr<nodet> &n)
+{
+  if(n.use_count() > 1)
+    n = std::make_shared<nodet>(*n);
+}
+
+const renaming::level2t::valuet *lookup(
+  const nodet *n,
+  unsigned int depth,
+  const renaming::level2t::name_record &rec)
+{
+  while(!n->leaf)
+  {
+    unsigned int w = current_namest::way_of(rec.hash, depth++);
+    if(!(n->bitmap & (1u << w)))
+      return nullptr;
+    n = n->children[child_pos(*n, w)].get();
+  }
+
+  for(const auto &entry : n->entries)
+    if(entry.first == rec)
+      return &entry.second;
+  return nullptr;
+}
+
+void for_each_entry(
+  const nodet *n,
+  const std::function<void(const current_namest::value_type &)> &f)
+{
+  if(n->leaf)
+  {
+    for(const auto &entry : n->entries)
+      f(entry);
+    return;
+  }
+
+  for(const auto &child : n->children)
+    for_each_entry(child.get(), f);
+}
+
+void diff_nodes(
+  const nodet *ours,
+  const nodet *theirs,
+  unsigned int depth,
+  const std::function<
+    void(const current_namest::value_type &, const renaming::level2t::valuet &)>
+    &f)
+{
+  if(ours == theirs)
+    return;
+
+  if(!ours->leaf && !theirs->leaf)
+  {
+    for(unsigned int w = 0; w < current_namest::ways; w++)
+    {
+      uint32_t bit = 1u << w;
+      if((ours->bitmap & bit) && (theirs->bitmap & bit))
+        diff_nodes(
+          ours->children[child_pos(*ours, w)].get(),
+          theirs->children[child_pos(*theirs, w)].get(),
+          depth + 1,
+          f);
+    }
+    return;
+  }
+
+  // A leaf against a subtree: look each of our names up on their side
+  for_each_entry(ours, [theirs, depth, &f](const current_namest::value_type &e) {
+    const renaming::level2t::valuet *v = lookup(theirs, depth, e.first);
+    if(v)
+      f(e, *v);
+  });
+}
+} // namespace
+
+void renaming::level2t::current_namest::const_iterator::descend()
+{
+  while(!path.back().first->leaf)
+  {
+    const nodet *n = path.back().first;
+    path.emplace_back(n->children[path.back().second].get(), 0);
+  }
+}
+
+renaming::level2t::current_namest::const_iterator &
+renaming::level2t::current_namest::const_iterator::operator++()
+{
+  ++path.back().second;
+  while(!path.empty())
+  {
+    const nodet *n = path.back().first;
+    size_t size = n->leaf ? n->entries.size() : n->children.size();
+    if(path.back().second < size)
+    {
+      descend();
+      break;
+    }
+
+    path.pop_back();
+    if(!path.empty())
+      ++path.back().second;
+  }
+  return *this;
+}
+
+renaming::level2t::current_namest::const_iterator
+renaming::level2t::current_namest::begin() const
+{
+  const_iterator it;
+  if(!root->children.empty())
+  {
+    it.path.emplace_back(root.get(), 0);
+    it.descend();
+  }
+  return it;
+}
+
+renaming::level2t::current_namest::const_iterator
+renaming::level2t::current_namest::find(const name_record &rec) const
+{
+  const_iterator it;
+  const nodet *n = root.get();
+  unsigned int depth = 0;
+  while(!n->leaf)
+  {
+    unsigned int w = way_of(rec.hash, depth++);
+    if(!(n->bitmap & (1u << w)))
+      return end();
+
+    unsigned int pos = child_pos(*n, w);
+    it.path.emplace_back(n, pos);
+    n = n->children[pos].get();
+  }
+
+  for(unsigned int i = 0; i < n->entries.size(); i++)
+    if(n->entries[i].first == rec)
+    {
+      it.path.emplace_back(n, i);
+      return it;
+    }
+
+  return end();
+}
+
+renaming::level2t::valuet &
+renaming::level2t::current_namest::operator[](const name_record &rec)
+{
+  // Copy every shared node on the way down. A node reached through one this
+  // map owns alone is shared only if another map holds it too.
+  unshare(root);
+  nodet *n = root.get();
+  unsigned int depth = 0;
+  for(;;)
+  {
+    unsigned int w = way_of(rec.hash, depth);
+    unsigned int pos = child_pos(*n, w);
+    if(!(n->bitmap & (1u << w)))
+    {
+      auto leaf = std::make_shared<nodet>();
+      leaf->leaf = true;
+      leaf->entries.emplace_back(rec, valuet());
+      n->bitmap |= 1u << w;
+      n->children.insert(n->children.begin() + pos, leaf);
+      return leaf->entries.back().second;
+    }
+
+    std::shared_ptr<nodet> &child = n->children[pos];
+    if(child->leaf && child->entries.front().first.hash != rec.hash)
+    {
+      // Two hashes on one way: push the leaf down a level, under a new node
+      auto split = std::make_shared<nodet>();
+      split->bitmap =
+        1u << way_of(child->entries.front().first.hash, depth + 1);
+      split->children.push_back(child);
+      child = split;
+    }
+
+    unshare(child);
+    n = child.get();
+    depth++;
+
+    if(n->leaf)
+    {
+      for(auto &entry : n->entries)
+        if(entry.first == rec)
+          return entry.second;
+
+      n->entries.emplace_back(rec, valuet());
+      return n->entries.back().second;
+    }
+  }
+}
+
+size_t renaming::level2t::current_namest::erase(const name_record &rec)
+{
+  if(find(rec) == end())
+    return 0;
+
+  // Unshare the path down to the leaf, as operator[] does
+  std::vector<std::pair<nodet *, unsigned int>> path;
+  unshare(root);
+  nodet *n = root.get();
+  unsigned int depth = 0;
+  while(!n->leaf)
+  {
+    unsigned int w = way_of(rec.hash, depth++);
+    unsigned int pos = child_pos(*n, w);
+    path.emplace_back(n, w);
+    unshare(n->children[pos]);
+    n = n->children[pos].get();
+  }
+
+  for(auto it = n->entries.begin(); it != n->entries.end(); ++it)
+    if(it->first == rec)
+    {
+      n->entries.erase(it);
+      break;
+    }
+
+  // Drop nodes left empty, and pull a leaf left alone under a node up in
+  // its place, so that a name sits where inserting it afresh would put it.
+  bool empty = n->entries.empty();
+  while(!path.empty())
+  {
+    nodet *parent = path.back().first;
+    unsigned int w = path.back().second;
+    path.pop_back();
+    unsigned int pos = child_pos(*parent, w);
+
+    if(empty)
+    {
+      parent->bitmap &= ~(1u << w);
+      parent->children.erase(parent->children.begin() + pos);
+    }
+    else
+    {
+      nodet *child = parent->children[pos].get();
+      if(!child->leaf && child->children.size() == 1 &&
+         child->children.front()->leaf)
+      {
+        std::shared_ptr<nodet> leaf = child->children.front();
+        parent->children[pos] = leaf;
+      }
+    }
+
+    empty = parent->children.empty() && parent != root.get();
+  }
+
+  return 1;
+}
+
+void renaming::level2t::current_namest::diff(
+  const current_namest &ref,
+  const std::function<void(const value_type &, const valuet &)> &f) const
+{
+  diff_nodes(root.get(), ref.root.get(), 0, f);
+}
+
+void renaming::level2t::get_changed_variables(
+  const level2t &ref,
+  std::set<name_record> &vars) const
+{
+  current_names.diff(
+    ref.current_names,
+    [&vars](const current_namest::value_type &ours, const valuet &theirs) {
+      if(ours.second.count != theirs.count)
+        vars.insert(ours.first);
+    });
+}
@@ -2,12 +2,15 @@
 #define _GOTO_SYMEX_RENAMING_H_
 
 #include <boost/functional/hash.hpp>
-#include <util/crypto_hash.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <util/expr_util.h>
 #include <util/guard.h>
 #include <util/i2string.h>
 #include <util/irep2_expr.h>
 #include <util/std_expr.h>
+#include <vector>
 
 namespace renaming
 {
@@ -255,6 +258,109 @@ public:
     }
   };
 
+  /**
+   *  Persistent map from level1 names to their current level2 values: a hash
+   *  array mapped trie over name_record::hash, with 32 ways per level. Copies
+   *  share the root, so copying a level2t (as done for each goto_statet
+   *  snapshot) costs a single reference count. A write copies only the nodes
+   *  on the path to its entry that are still shared, O(log N) of them, and
+   *  maps that diverged from one snapshot still share every other node.
+   */
+  class current_namest
+  {
+  public:
+    typedef std::pair<name_record, valuet> value_type;
+
+    static const unsigned int bits = 5;
+    static const unsigned int ways = 1 << bits;
+
+    /** An interior node keeps the children present among its ways, in
+     *  order; a leaf keeps the entries, whose hashes are all the same. A
+     *  node is only modified in place while no other map holds it. */
+    struct nodet
+    {
+      nodet() : leaf(false), bitmap(0)
+      {
+      }
+
+      bool leaf;
+      uint32_t bitmap;
+      std::vector<std::shared_ptr<nodet>> children;
+      std::vector<value_type> entries;
+    };
+
+    class const_iterator
+    {
+    public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef current_namest::value_type value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const value_type *pointer;
+      typedef const value_type &reference;
+
+      reference operator*() const
+      {
+        return path.back().first->entries[path.back().second];
+      }
+
+      pointer operator->() const
+      {
+        return &**this;
+      }
+
+      const_iterator &operator++();
+
+      bool operator==(const const_iterator &ref) const
+      {
+        return path == ref.path;
+      }
+
+      bool operator!=(const const_iterator &ref) const
+      {
+        return !(*this == ref);
+      }
+
+    protected:
+      friend class current_namest;
+
+      // Follow the first child down from the last node of the path
+      void descend();
+
+      // Nodes from the root down to a leaf, each with the position of the
+      // child (or entry) taken; empty at the end.
+      std::vector<std::pair<const nodet *, unsigned int>> path;
+    };
+
+    current_namest() : root(std::make_shared<nodet>())
+    {
+    }
+
+    const_iterator begin() const;
+    const_iterator end() const
+    {
+      return const_iterator();
+    }
+
+    const_iterator find(const name_record &rec) const;
+    valuet &operator[](const name_record &rec);
+    size_t erase(const name_record &rec);
+
+    /** Calls f with each entry of this map and the value ref has for the
+     *  same name, wherever the two may differ. Nodes shared by both maps
+     *  hold the same entries and are skipped. */
+    void diff(
+      const current_namest &ref,
+      const std::function<void(const value_type &, const valuet &)> &f) const;
+
+    static unsigned int way_of(size_t hash, unsigned int depth)
+    {
+      return (hash >> (depth * bits)) & (ways - 1);
+    }
+
+  protected:
+    std::shared_ptr<nodet> root;
+  };
+
   void get_variables(std::set<name_record> &vars) const
   {
     for(const auto &current_name : current_names)
@@ -263,6 +369,16 @@ public:
     }
   }
 
+  /**
+   *  Collect the names present in both this and ref whose level2 number
+   *  differs. Trie nodes shared between the two maps cannot differ and are
+   *  skipped, so the cost is proportional to what changed since the two
+   *  states diverged rather than to the number of live names.
+   */
+  void get_changed_variables(
+    const level2t &ref,
+    std::set<name_record> &vars) const;
+
   unsigned current_number(const expr2tc &sym) const;
   unsigned current_number(const name_record &rec) const;
 
@@ -283,11 +399,8 @@ public:
 
   friend void build_goto_symex_classes();
   // Repeat of the above ignored friend directive.
-  typedef std::unordered_map<name_record, valuet, name_rec_hash> current_namest;
 
   current_namest current_names;
-  typedef std::map<const expr2tc, crypto_hash> current_state_hashest;
-  current_state_hashest current_hashes;
 };
 
 } // namespace renaming
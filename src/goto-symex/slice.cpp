@@ -6,33 +6,182 @@ Author: Daniel Kroening, kroening@kroening.com
 
 \*******************************************************************/
 
+#include <algorithm>
 #include <goto-symex/slice.h>
 
-symex_slicet::symex_slicet(bool assume)
-  : ignored(0),
-    slice_assumes(assume),
-    add_to_deps([this](const symbol2t &s) -> bool {
-      return depends.insert(s.get_symbol_name()).second;
-    })
+symex_slicet::symbol_keyt::symbol_keyt(const symbol2t &sym)
+  : name(sym.thename.get_no()), l1(0), thread(0), node(0), l2(0), lev(0)
 {
+  // Only the fields that get_symbol_name prints take part in the key, so
+  // that keys compare equal exactly when the SSA names do.
+  switch(sym.rlevel)
+  {
+  case symbol2t::level0:
+  case symbol2t::level1_global:
+    lev = symbol2t::level0;
+    break;
+  case symbol2t::level1:
+    lev = symbol2t::level1;
+    l1 = sym.level1_num;
+    thread = sym.thread_num;
+    break;
+  case symbol2t::level2:
+    lev = symbol2t::level2;
+    l1 = sym.level1_num;
+    thread = sym.thread_num;
+    node = sym.node_num;
+    l2 = sym.level2_num;
+    break;
+  case symbol2t::level2_global:
+    lev = symbol2t::level2_global;
+    node = sym.node_num;
+    l2 = sym.level2_num;
+    break;
+  default:
+    std::cerr << "Unrecognized renaming level enum" << std::endl;
+    abort();
+  }
+}
+
+size_t symex_slicet::symbol_keyt::hash() const
+{
+  uint64_t h = name;
+  h = h * 0x9e3779b97f4a7c15ULL + l1;
+  h = h * 0x9e3779b97f4a7c15ULL + thread;
+  h = h * 0x9e3779b97f4a7c15ULL + node;
+  h = h * 0x9e3779b97f4a7c15ULL + l2;
+  h = h * 0x9e3779b97f4a7c15ULL + lev;
+  return h ^ (h >> 29);
+}
+
+symex_slicet::symbol_sett::symbol_sett() : count(0), peak(0)
+{
+  clear();
+}
+
+void symex_slicet::symbol_sett::clear()
+{
+  symbol_keyt empty;
+  empty.lev = empty_slot;
+  slots.assign(64, empty);
+  count = 0;
+  peak = std::max(peak, slots.size() * sizeof(symbol_keyt));
+}
+
+size_t symex_slicet::symbol_sett::find_slot(const symbol_keyt &key) const
+{
+  size_t mask = slots.size() - 1;
+  size_t i = key.hash() & mask;
+  while(slots[i].lev != empty_slot && !(slots[i] == key))
+    i = (i + 1) & mask;
+  return i;
+}
+
+bool symex_slicet::symbol_sett::contains(const symbol_keyt &key) const
+{
+  return slots[find_slot(key)].lev != empty_slot;
+}
+
+bool symex_slicet::symbol_sett::insert(const symbol_keyt &key)
+{
+  size_t i = find_slot(key);
+  if(slots[i].lev != empty_slot)
+    return false;
+
+  // Keep the load factor at or below one half.
+  if((count + 1) * 2 > slots.size())
+  {
+    grow();
+    i = find_slot(key);
+  }
+
+  slots[i] = key;
+  count++;
+  return true;
 }
 
-bool symex_slicet::get_symbols(
-  const expr2tc &expr,
-  std::function<bool(const symbol2t &)> fn)
+bool symex_slicet::symbol_sett::erase(const symbol_keyt &key)
+{
+  size_t mask = slots.size() - 1;
+  size_t i = find_slot(key);
+  if(slots[i].lev == empty_slot)
+    return false;
+
+  // Backward-shift deletion: pull later members of the probe run into the
+  // hole unless their home slot lies cyclically within (hole, position].
+  for(size_t j = i;;)
+  {
+    j = (j + 1) & mask;
+    if(slots[j].lev == empty_slot)
+      break;
+
+    size_t home = slots[j].hash() & mask;
+    bool stays = i <= j ? (i < home && home <= j) : (i < home || home <= j);
+    if(stays)
+      continue;
+
+    slots[i] = slots[j];
+    i = j;
+  }
+
+  slots[i].lev = empty_slot;
+  count--;
+  return true;
+}
+
+void symex_slicet::symbol_sett::grow()
+{
+  std::vector<symbol_keyt> old;
+  old.swap(slots);
+
+  symbol_keyt empty;
+  empty.lev = empty_slot;
+  slots.assign(old.size() * 2, empty);
+  peak = std::max(peak, slots.size() * sizeof(symbol_keyt));
+
+  for(const symbol_keyt &key : old)
+    if(key.lev != empty_slot)
+      slots[find_slot(key)] = key;
+}
+
+symex_slicet::symex_slicet(bool assume) : ignored(0), slice_assumes(assume)
+{
+}
+
+template <typename F>
+bool symex_slicet::get_symbols(const expr2tc &expr, F &&fn)
 {
   bool res = false;
   expr->foreach_operand([this, &fn, &res](const expr2tc &e) {
     if(!is_nil_expr(e))
       res = get_symbols(e, fn) || res;
-    return res;
   });
 
   if(!is_symbol2t(expr))
     return res;
 
-  const symbol2t &tmp = to_symbol2t(expr);
-  return fn(tmp) || res;
+  return fn(to_symbol2t(expr)) || res;
+}
+
+bool symex_slicet::add_to_deps(const expr2tc &expr)
+{
+  return get_symbols(expr, [this](const symbol2t &s) -> bool {
+    return depends.insert(symbol_keyt(s));
+  });
+}
+
+bool symex_slicet::any_in_deps(const expr2tc &expr) const
+{
+  if(is_symbol2t(expr))
+    return depends.contains(symbol_keyt(to_symbol2t(expr)));
+
+  // Stop descending as soon as one dependency has been found.
+  bool found = false;
+  expr->foreach_operand([this, &found](const expr2tc &e) {
+    if(!found && !is_nil_expr(e))
+      found = any_in_deps(e);
+  });
+  return found;
 }
 
 void symex_slicet::slice(std::shared_ptr<symex_target_equationt> &eq)
@@ -51,8 +200,8 @@ void symex_slicet::slice(symex_target_equationt::SSA_stept &SSA_step)
   switch(SSA_step.type)
   {
   case goto_trace_stept::ASSERT:
-    get_symbols(SSA_step.guard, add_to_deps);
-    get_symbols(SSA_step.cond, add_to_deps);
+    add_to_deps(SSA_step.guard);
+    add_to_deps(SSA_step.cond);
     break;
 
   case goto_trace_stept::ASSUME:
@@ -60,8 +209,8 @@ void symex_slicet::slice(symex_target_equationt::SSA_stept &SSA_step)
       slice_assume(SSA_step);
     else
     {
-      get_symbols(SSA_step.guard, add_to_deps);
-      get_symbols(SSA_step.cond, add_to_deps);
+      add_to_deps(SSA_step.guard);
+      add_to_deps(SSA_step.cond);
     }
     break;
 
@@ -83,11 +232,7 @@ void symex_slicet::slice(symex_target_equationt::SSA_stept &SSA_step)
 
 void symex_slicet::slice_assume(symex_target_equationt::SSA_stept &SSA_step)
 {
-  auto check_in_deps = [this](const symbol2t &s) -> bool {
-    return depends.find(s.get_symbol_name()) != depends.end();
-  };
-
-  if(!get_symbols(SSA_step.cond, check_in_deps))
+  if(!any_in_deps(SSA_step.cond))
   {
     // we don't really need it
     SSA_step.ignore = true;
@@ -96,8 +241,8 @@ void symex_slicet::slice_assume(symex_target_equationt::SSA_stept &SSA_step)
   else
   {
     // If we need it, add the symbols to dependency
-    get_symbols(SSA_step.guard, add_to_deps);
-    get_symbols(SSA_step.cond, add_to_deps);
+    add_to_deps(SSA_step.guard);
+    add_to_deps(SSA_step.cond);
   }
 }
 
@@ -105,11 +250,9 @@ void symex_slicet::slice_assignment(symex_target_equationt::SSA_stept &SSA_step)
 {
   assert(is_symbol2t(SSA_step.lhs));
 
-  auto check_in_deps = [this](const symbol2t &s) -> bool {
-    return depends.find(s.get_symbol_name()) != depends.end();
-  };
-
-  if(!get_symbols(SSA_step.lhs, check_in_deps))
+  // Remove this symbol as we won't be seeing any references to it further
+  // into the history; if it wasn't there, nothing later depends on it.
+  if(!depends.erase(symbol_keyt(to_symbol2t(SSA_step.lhs))))
   {
     // we don't really need it
     SSA_step.ignore = true;
@@ -117,12 +260,8 @@ void symex_slicet::slice_assignment(symex_target_equationt::SSA_stept &SSA_step)
   }
   else
   {
-    get_symbols(SSA_step.guard, add_to_deps);
-    get_symbols(SSA_step.rhs, add_to_deps);
-
-    // Remove this symbol as we won't be seeing any references to it further
-    // into the history.
-    depends.erase(to_symbol2t(SSA_step.lhs).get_symbol_name());
+    add_to_deps(SSA_step.guard);
+    add_to_deps(SSA_step.rhs);
   }
 }
 
@@ -130,11 +269,7 @@ void symex_slicet::slice_renumber(symex_target_equationt::SSA_stept &SSA_step)
 {
   assert(is_symbol2t(SSA_step.lhs));
 
-  auto check_in_deps = [this](const symbol2t &s) -> bool {
-    return depends.find(s.get_symbol_name()) != depends.end();
-  };
-
-  if(!get_symbols(SSA_step.lhs, check_in_deps))
+  if(!depends.contains(symbol_keyt(to_symbol2t(SSA_step.lhs))))
   {
     // we don't really need it
     SSA_step.ignore = true;
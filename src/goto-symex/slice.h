@@ -9,9 +9,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_GOTO_SYMEX_SLICE_H
 #define CPROVER_GOTO_SYMEX_SLICE_H
 
+#include <cstdint>
 #include <goto-symex/renaming.h>
 #include <goto-symex/symex_target_equation.h>
-#include <unordered_set>
+#include <vector>
 
 BigInt slice(std::shared_ptr<symex_target_equationt> &eq, bool slice_assume);
 BigInt simple_slice(std::shared_ptr<symex_target_equationt> &eq);
@@ -22,16 +23,82 @@ public:
   symex_slicet(bool assume);
   void slice(std::shared_ptr<symex_target_equationt> &eq);
 
-  typedef std::unordered_set<std::string> symbol_sett;
+  /**
+   *  Interned identity of an SSA symbol: the dstring number of its name plus
+   *  the renaming numbers that symbol2t::get_symbol_name would print. Two
+   *  symbols have equal keys exactly when their SSA names are equal.
+   */
+  struct symbol_keyt
+  {
+    symbol_keyt() = default;
+    explicit symbol_keyt(const symbol2t &sym);
+
+    bool operator==(const symbol_keyt &ref) const
+    {
+      return name == ref.name && l1 == ref.l1 && thread == ref.thread &&
+             node == ref.node && l2 == ref.l2 && lev == ref.lev;
+    }
+
+    size_t hash() const;
+
+    uint32_t name;
+    uint32_t l1;
+    uint32_t thread;
+    uint32_t node;
+    uint32_t l2;
+    uint8_t lev;
+  };
+
+  /**
+   *  Open-addressing set of symbol keys with linear probing. Erasure shifts
+   *  the following run back, so no tombstones accumulate during the backward
+   *  pass, which erases every assigned symbol it keeps.
+   */
+  class symbol_sett
+  {
+  public:
+    symbol_sett();
+
+    /** Returns true if key was not already present. */
+    bool insert(const symbol_keyt &key);
+    bool contains(const symbol_keyt &key) const;
+    /** Returns true if key was present. */
+    bool erase(const symbol_keyt &key);
+    void clear();
+
+    size_t size() const
+    {
+      return count;
+    }
+
+    /** Largest number of bytes the table has occupied since construction. */
+    size_t peak_bytes() const
+    {
+      return peak;
+    }
+
+  protected:
+    // Marks an unoccupied slot; never produced by symbol_keyt(symbol2t).
+    static const uint8_t empty_slot = 0xff;
+
+    size_t find_slot(const symbol_keyt &key) const;
+    void grow();
+
+    std::vector<symbol_keyt> slots;
+    size_t count;
+    size_t peak;
+  };
+
   symbol_sett depends;
   BigInt ignored;
 
 protected:
   bool slice_assumes;
-  std::function<bool(const symbol2t &)> add_to_deps;
 
-  bool
-  get_symbols(const expr2tc &expr, std::function<bool(const symbol2t &)> fn);
+  template <typename F>
+  bool get_symbols(const expr2tc &expr, F &&fn);
+  bool add_to_deps(const expr2tc &expr);
+  bool any_in_deps(const expr2tc &expr) const;
 
   void slice(symex_target_equationt::SSA_stept &SSA_step);
   void slice_assume(symex_target_equationt::SSA_stept &SSA_step);
@@ -41,6 +41,11 @@ goto_symext::goto_symext(
     inside_unexpected(false),
     no_return_value_opt(options.get_bool_option("no-return-value-opt")),
     stack_limit(atol(options.get_option("stack-limit").c_str())),
+    // A summarised call has no stack frame to check the size of
+    use_function_summaries(
+      options.get_bool_option("function-summaries") &&
+      atol(options.get_option("stack-limit").c_str()) <= 0),
+    function_summaries(std::make_shared<function_summariest>()),
     depth_limit(atol(options.get_option("depth").c_str())),
     break_insn(atol(options.get_option("break-at").c_str())),
     memory_leak_check(options.get_bool_option("memory-leak-check")),
@@ -113,6 +118,8 @@ goto_symext &goto_symext::operator=(const goto_symext &sym)
   forward_condition = sym.forward_condition;
   inductive_step = sym.inductive_step;
   first_loop = sym.first_loop;
+  use_function_summaries = sym.use_function_summaries;
+  function_summaries = sym.function_summaries;
 
   valid_ptr_arr_name = sym.valid_ptr_arr_name;
   alloc_size_arr_name = sym.alloc_size_arr_name;
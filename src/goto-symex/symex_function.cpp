@@ -245,6 +245,12 @@ void goto_symext::symex_function_call_code(const expr2tc &expr)
     return;
   }
 
+  // Functions that only compute a value needn't be entered
+  if(
+    use_function_summaries &&
+    symex_summarised_call(call, identifier, goto_function))
+    return;
+
   // read the arguments -- before the locality renaming
   std::vector<expr2tc> arguments = call.operands;
   for(auto &argument : arguments)
@@ -320,12 +320,10 @@ void goto_symext::phi_function(const statet::goto_statet &goto_state)
   if(goto_state.guard.is_false() && cur_state->guard.is_false())
     return;
 
-  // go over all variables to see what changed
+  // go over all variables to see what changed; names the branch deleted are
+  // not reported, so no assignment is created for them
   std::set<renaming::level2t::name_record> variables;
-  cur_state->level2.get_variables(variables);
-
-  std::set<renaming::level2t::name_record> goto_variables;
-  goto_state.level2.get_variables(goto_variables);
+  cur_state->level2.get_changed_variables(goto_state.level2, variables);
 
   guardt tmp_guard;
   if(
@@ -340,22 +338,12 @@ void goto_symext::phi_function(const statet::goto_statet &goto_state)
 
   for(const auto &variable : variables)
   {
-    if(
-      goto_state.level2.current_number(variable) ==
-      cur_state->level2.current_number(variable))
-      continue; // not changed
-
     if(variable.base_name == guard_identifier_s)
       continue; // just a guard
 
     if(has_prefix(variable.base_name.as_string(), "symex::invalid_object"))
       continue;
 
-    // If the variable was deleted in this branch, don't create an assignment
-    // for it
-    if(goto_variables.find(variable) == goto_variables.end())
-      continue;
-
     // changed!
     const symbolt &symbol = ns.lookup(variable.base_name);
 
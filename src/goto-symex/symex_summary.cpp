@@ -0,0 +1,379 @@
+/*******************************************************************\
+
+Module: Symbolic Execution of functions through summaries
+
+\*******************************************************************/
+
+#include <goto-symex/execution_state.h>
+#include <goto-symex/goto_symex.h>
+#include <goto-symex/reachability_tree.h>
+#include <unordered_set>
+#include <util/base_type.h>
+#include <util/irep2_utils.h>
+#include <util/migrate.h>
+#include <util/stats.h>
+
+typedef std::unordered_map<irep_idt, expr2tc, irep_id_hash> symbol_valuest;
+
+namespace
+{
+// One path, or merge of paths, through a function body being summarised:
+// the condition for taking it and the value of each local variable on it,
+// both over the parameters and the globals read.
+struct summary_patht
+{
+  expr2tc guard;
+  symbol_valuest values;
+};
+
+class summary_buildert
+{
+public:
+  summary_buildert(const namespacet &_ns, const goto_functiont &_function)
+    : reads_globals(false), ns(_ns), function(_function)
+  {
+  }
+
+  // Sets result to the value returned, or returns false if the function
+  // can't be summarised
+  bool build(expr2tc &result);
+
+  bool reads_globals;
+
+protected:
+  bool eval(expr2tc &expr);
+  void merge(summary_patht &dest, const summary_patht &src);
+
+  const namespacet &ns;
+  const goto_functiont &function;
+
+  // Parameters and everything declared in the body
+  std::unordered_set<irep_idt, irep_id_hash> locals;
+  summary_patht *path;
+};
+
+bool summary_buildert::eval(expr2tc &expr)
+{
+  if(is_nil_expr(expr))
+    return true;
+
+  // Side effects change more than the value returned
+  if(is_sideeffect2t(expr))
+    return false;
+
+  // The body writes no memory, so a read through a pointer sees what it
+  // would at the call. The dereference stays in the summary and is done at
+  // each call site, with the value sets of that call's arguments.
+  if(is_dereference2t(expr))
+  {
+    reads_globals = true;
+    return eval(to_dereference2t(expr).value);
+  }
+
+  // The address of a local isn't one the caller can see
+  if(is_address_of2t(expr))
+  {
+    expr2tc base = to_address_of2t(expr).ptr_obj;
+    while(is_member2t(base) || is_index2t(base))
+      base = is_member2t(base) ? to_member2t(base).source_value
+                               : to_index2t(base).source_value;
+
+    if(is_symbol2t(base) && locals.count(to_symbol2t(base).thename) != 0)
+      return false;
+  }
+
+  if(is_symbol2t(expr))
+  {
+    const irep_idt &name = to_symbol2t(expr).thename;
+    if(locals.count(name) != 0)
+    {
+      // Reading a local before it is assigned leaves it nondeterministic,
+      // which a summary can't repeat.
+      auto it = path->values.find(name);
+      if(it == path->values.end())
+        return false;
+
+      expr = it->second;
+      return true;
+    }
+
+    const symbolt *symbol;
+    if(ns.lookup(name, symbol) || !symbol->static_lifetime)
+      return false;
+
+    reads_globals = true;
+    return true;
+  }
+
+  bool ok = true;
+  expr->Foreach_operand([this, &ok](expr2tc &e) {
+    if(ok)
+      ok = eval(e);
+  });
+  return ok;
+}
+
+void summary_buildert::merge(summary_patht &dest, const summary_patht &src)
+{
+  // Locals missing on either side are out of scope after the join.
+  for(auto it = dest.values.begin(); it != dest.values.end();)
+  {
+    auto s = src.values.find(it->first);
+    if(s == src.values.end())
+    {
+      it = dest.values.erase(it);
+      continue;
+    }
+
+    if(s->second != it->second)
+      it->second = if2tc(it->second->type, src.guard, s->second, it->second);
+    ++it;
+  }
+
+  dest.guard = or2tc(dest.guard, src.guard);
+}
+
+bool summary_buildert::build(expr2tc &result)
+{
+  type2tc tmp_type;
+  migrate_type(function.type, tmp_type);
+  const code_type2t &type = to_code_type(tmp_type);
+  if(type.ellipsis || is_empty_type(type.ret_type))
+    return false;
+
+  summary_patht entry;
+  entry.guard = gen_true_expr();
+  for(unsigned int i = 0; i < type.arguments.size(); i++)
+  {
+    const irep_idt &name = type.argument_names[i];
+    if(name == "")
+      continue;
+
+    locals.insert(name);
+    entry.values[name] = symbol2tc(type.arguments[i], name);
+  }
+
+  forall_goto_program_instructions(it, function.body)
+    if(it->is_decl())
+      locals.insert(to_code_decl2t(it->code).value);
+
+  // Paths jumping forward, by the location they join at
+  std::map<unsigned, std::list<summary_patht>> joins;
+
+  summary_patht cur = entry;
+  bool live = true;
+  expr2tc ret;
+
+  forall_goto_program_instructions(it, function.body)
+  {
+    auto j = joins.find(it->location_number);
+    if(j != joins.end())
+    {
+      for(const summary_patht &p : j->second)
+      {
+        if(live)
+          merge(cur, p);
+        else
+          cur = p;
+        live = true;
+      }
+      joins.erase(j);
+    }
+
+    if(!live)
+      continue;
+
+    path = &cur;
+
+    switch(it->type)
+    {
+    case SKIP:
+    case LOCATION:
+      break;
+
+    case END_FUNCTION:
+      // Falling off the end of a non-void function returns garbage
+      return false;
+
+    case DECL:
+      cur.values.erase(to_code_decl2t(it->code).value);
+      break;
+
+    case DEAD:
+      cur.values.erase(to_code_dead2t(it->code).value);
+      break;
+
+    case ASSIGN:
+    {
+      const code_assign2t &assign = to_code_assign2t(it->code);
+      if(!is_symbol2t(assign.target))
+        return false;
+
+      const irep_idt &name = to_symbol2t(assign.target).thename;
+      if(locals.count(name) == 0)
+        return false;
+
+      expr2tc value = assign.source;
+      if(!eval(value))
+        return false;
+      cur.values[name] = value;
+      break;
+    }
+
+    case GOTO:
+    {
+      if(it->targets.size() != 1 || it->is_backwards_goto())
+        return false;
+
+      expr2tc cond = it->guard;
+      if(!eval(cond))
+        return false;
+
+      if(is_false(cond))
+        break;
+
+      summary_patht taken = cur;
+      if(!is_true(cond))
+      {
+        taken.guard = and2tc(cur.guard, cond);
+        cur.guard = and2tc(cur.guard, not2tc(cond));
+      }
+      else
+        live = false;
+
+      joins[it->targets.front()->location_number].push_back(taken);
+      break;
+    }
+
+    case RETURN:
+    {
+      expr2tc value = to_code_return2t(it->code).operand;
+      if(is_nil_expr(value) || !eval(value))
+        return false;
+
+      if(value->type != type.ret_type)
+        value = typecast2tc(type.ret_type, value);
+
+      // The paths returning are disjoint, so one if-then-else chain over
+      // their guards picks the value returned.
+      ret = is_nil_expr(ret) ? value
+                             : if2tc(value->type, cur.guard, value, ret);
+      live = false;
+      break;
+    }
+
+    default:
+      // Assertions, assumptions, calls, threads and exceptions all have
+      // effects beyond the value returned.
+      return false;
+    }
+  }
+
+  if(is_nil_expr(ret))
+    return false;
+
+  result = ret;
+  return true;
+}
+
+// Replace every symbol in expr that has a value in values
+void replace_symbols(expr2tc &expr, const symbol_valuest &values)
+{
+  if(is_nil_expr(expr))
+    return;
+
+  if(is_symbol2t(expr))
+  {
+    auto it = values.find(to_symbol2t(expr).thename);
+    if(it != values.end())
+      expr = it->second;
+    return;
+  }
+
+  expr->Foreach_operand(
+    [&values](expr2tc &e) { replace_symbols(e, values); });
+}
+} // namespace
+
+const goto_symext::function_summaryt &goto_symext::get_function_summary(
+  const irep_idt &identifier,
+  const goto_functiont &goto_function)
+{
+  auto it = function_summaries->find(identifier);
+  if(it != function_summaries->end())
+    return it->second;
+
+  function_summaryt &summary = (*function_summaries)[identifier];
+  summary_buildert builder(ns, goto_function);
+  summary.valid = builder.build(summary.value);
+  summary.reads_globals = builder.reads_globals;
+  return summary;
+}
+
+bool goto_symext::symex_summarised_call(
+  const code_function_call2t &call,
+  const irep_idt &identifier,
+  const goto_functiont &goto_function)
+{
+  const function_summaryt &summary =
+    get_function_summary(identifier, goto_function);
+  if(!summary.valid)
+    return false;
+
+  // Reading globals in one step would hide the context switches other
+  // threads could take while the body runs.
+  if(
+    summary.reads_globals && art1 != nullptr &&
+    art1->get_cur_state().threads_state.size() > 1)
+    return false;
+
+  type2tc tmp_type;
+  migrate_type(goto_function.type, tmp_type);
+  const code_type2t &type = to_code_type(tmp_type);
+  if(type.arguments.size() != call.operands.size())
+    return false;
+
+  // The summary is over the parameters; bind them to the arguments with the
+  // same conversions argument_assignments makes.
+  symbol_valuest args;
+  for(unsigned int i = 0; i < type.arguments.size(); i++)
+  {
+    const irep_idt &name = type.argument_names[i];
+    if(name == "")
+      continue;
+
+    expr2tc arg = call.operands[i];
+    if(is_nil_expr(arg))
+      return false;
+
+    const type2tc &arg_type = type.arguments[i];
+    if(!base_type_eq(arg_type, arg->type, ns))
+    {
+      if(
+        !(is_number_type(arg_type) || is_pointer_type(arg_type)) ||
+        !(is_number_type(arg->type) || is_pointer_type(arg->type)))
+        return false;
+
+      arg = typecast2tc(arg_type, arg);
+    }
+
+    args[name] = arg;
+  }
+
+  // A function with no effect but its value needs no code when the value is
+  // thrown away.
+  if(!is_nil_expr(call.ret) && !is_empty_type(call.ret->type))
+  {
+    expr2tc rhs = summary.value;
+    replace_symbols(rhs, args);
+
+    if(rhs->type != call.ret->type)
+      rhs = typecast2tc(call.ret->type, rhs);
+
+    symex_assign(code_assign2tc(call.ret, rhs));
+  }
+
+  stats.add_count("summarised-calls");
+  cur_state->source.pc++;
+  return true;
+}
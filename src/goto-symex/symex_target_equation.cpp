@@ -6,6 +6,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 \*******************************************************************/
 
+#include <algorithm>
 #include <cassert>
 #include <goto-symex/goto_symex.h>
 #include <goto-symex/goto_symex_state.h>
@@ -40,7 +41,7 @@ void symex_target_equationt::assignment(
   SSA_step.cond = equality2tc(lhs, rhs);
   SSA_step.type = goto_trace_stept::ASSIGNMENT;
   SSA_step.source = source;
-  SSA_step.stack_trace = stack_trace;
+  SSA_step.stack_trace = stack_traces.intern(std::move(stack_trace));
   SSA_step.loop_number = loop_number;
 
   if(debug_print)
@@ -59,7 +60,7 @@ void symex_target_equationt::output(
   SSA_step.guard = guard;
   SSA_step.type = goto_trace_stept::OUTPUT;
   SSA_step.source = source;
-  SSA_step.output_args = args;
+  SSA_step.output_args.assign(args.begin(), args.end());
   SSA_step.format_string = fmt;
 
   if(debug_print)
@@ -101,7 +102,7 @@ void symex_target_equationt::assertion(
   SSA_step.type = goto_trace_stept::ASSERT;
   SSA_step.source = source;
   SSA_step.comment = msg;
-  SSA_step.stack_trace = stack_trace;
+  SSA_step.stack_trace = stack_traces.intern(std::move(stack_trace));
   SSA_step.loop_number = loop_number;
 
   if(debug_print)
@@ -189,11 +190,9 @@ void symex_target_equationt::convert_internal_step(
   }
   else if(step.is_output())
   {
-    for(std::list<expr2tc>::const_iterator o_it = step.output_args.begin();
-        o_it != step.output_args.end();
-        o_it++)
+    step.converted_output_args.reserve(step.output_args.size());
+    for(const auto &tmp : step.output_args)
     {
-      const expr2tc &tmp = *o_it;
       if(is_constant_expr(tmp) || is_constant_string2t(tmp))
         step.converted_output_args.push_back(tmp);
       else
@@ -359,20 +358,42 @@ void symex_target_equationt::check_for_duplicate_assigns() const
 
 unsigned int symex_target_equationt::clear_assertions()
 {
-  unsigned int num_asserts = 0;
+  // Compact the surviving steps in a single pass rather than erasing from
+  // the middle of the arena once per assertion.
+  SSA_stepst::iterator new_end = std::remove_if(
+    SSA_steps.begin(), SSA_steps.end(), [](const SSA_stept &step) {
+      return step.is_assert();
+    });
+
+  unsigned int num_asserts = SSA_steps.end() - new_end;
+  SSA_steps.erase(new_end, SSA_steps.end());
+  return num_asserts;
+}
+
+symex_target_equationt::stack_tracet
+symex_target_equationt::stack_trace_tablet::intern(
+  std::vector<stack_framet> &&stack_trace)
+{
+  if(last && *last == stack_trace)
+    return last;
 
-  for(SSA_stepst::iterator it = SSA_steps.begin(); it != SSA_steps.end(); it++)
+  stack_tracet tmp =
+    std::make_shared<const std::vector<stack_framet>>(std::move(stack_trace));
+  last = *table.insert(tmp).first;
+  return last;
+}
+
+size_t symex_target_equationt::stack_trace_tablet::hasht::operator()(
+  const stack_tracet &s) const
+{
+  size_t h = s->size();
+  for(const auto &frame : *s)
   {
-    if(it->type == goto_trace_stept::ASSERT)
-    {
-      SSA_stepst::iterator it2 = it;
-      it--;
-      SSA_steps.erase(it2);
-      num_asserts++;
-    }
+    h = h * 31 + irep_id_hash()(frame.function);
+    if(frame.src != nullptr)
+      h = h * 31 + frame.src->pc->location_number;
   }
-
-  return num_asserts;
+  return h;
 }
 
 runtime_encoded_equationt::runtime_encoded_equationt(
@@ -382,42 +403,19 @@ runtime_encoded_equationt::runtime_encoded_equationt(
 {
   assert_vec_list.emplace_back();
   assumpt_chain.push_back(conv.convert_ast(gen_true_expr()));
-  cvt_progress = SSA_steps.end();
+  cvt_progress = 0;
 }
 
 void runtime_encoded_equationt::flush_latest_instructions()
 {
-  if(SSA_steps.size() == 0)
-    return;
-
-  SSA_stepst::iterator run_it = cvt_progress;
-  // Scenarios:
-  // * We're at the start of running, in which case cvt_progress == end
-  // * We're in the middle, but nothing is left to push, so run_it + 1 == end
-  // * We're in the middle, and there's more to convert.
-  if(run_it == SSA_steps.end())
-  {
-    run_it = SSA_steps.begin();
-  }
-  else
-  {
-    run_it++;
-    if(run_it == SSA_steps.end())
-    {
-      // There is in fact, nothing to do
-      return;
-    }
-
-    // Just roll on
-  }
-
-  // Now iterate from the start insn to convert, to the end of the list.
-  for(; run_it != SSA_steps.end(); ++run_it)
+  // Convert everything appended since the last flush. Steps are addressed by
+  // index, so the steps themselves may be appended to the arena meanwhile.
+  for(; cvt_progress < SSA_steps.size(); ++cvt_progress)
     convert_internal_step(
-      conv, assumpt_chain.back(), assert_vec_list.back(), *run_it);
-
-  run_it--;
-  cvt_progress = run_it;
+      conv,
+      assumpt_chain.back(),
+      assert_vec_list.back(),
+      SSA_steps[cvt_progress]);
 }
 
 void runtime_encoded_equationt::push_ctx()
@@ -433,13 +431,8 @@ void runtime_encoded_equationt::push_ctx()
 
 void runtime_encoded_equationt::pop_ctx()
 {
-  SSA_stepst::iterator it = scoped_end_points.back();
-  cvt_progress = it;
-
-  if(SSA_steps.size() != 0)
-    ++it;
-
-  SSA_steps.erase(it, SSA_steps.end());
+  cvt_progress = scoped_end_points.back();
+  SSA_steps.truncate(cvt_progress);
 
   conv.pop_ctx();
   scoped_end_points.pop_back();
@@ -473,7 +466,7 @@ std::shared_ptr<symex_targett> runtime_encoded_equationt::clone() const
     "cloned when it contains data");
   auto nthis = std::shared_ptr<runtime_encoded_equationt>(
     new runtime_encoded_equationt(*this));
-  nthis->cvt_progress = nthis->SSA_steps.end();
+  nthis->cvt_progress = 0;
   return nthis;
 }
 
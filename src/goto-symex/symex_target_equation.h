@@ -17,7 +17,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-symex/symex_target.h>
 #include <list>
 #include <map>
+#include <memory>
 #include <solvers/smt/smt_conv.h>
+#include <unordered_set>
+#include <util/chunked_vector.h>
 #include <util/config.h>
 #include <util/irep2.h>
 #include <util/namespace.h>
@@ -28,6 +31,10 @@ class symex_target_equationt : public symex_targett
 public:
   class SSA_stept;
 
+  // Stack traces are shared between all steps that were recorded under the
+  // same call stack, see stack_trace_tablet.
+  typedef std::shared_ptr<const std::vector<stack_framet>> stack_tracet;
+
   symex_target_equationt(const namespacet &_ns) : ns(_ns)
   {
     debug_print = config.options.get_bool_option("symex-ssa-trace");
@@ -93,8 +100,14 @@ public:
 
     // One stack trace recorded per function activation record. Valid for
     // assignment and assert steps only. In reverse order (most recent in idx
-    // 0).
-    std::vector<stack_framet> stack_trace;
+    // 0). Interned by the equation, so equal traces share one vector.
+    stack_tracet stack_trace;
+
+    const std::vector<stack_framet> &get_stack_trace() const
+    {
+      static const std::vector<stack_framet> empty;
+      return stack_trace ? *stack_trace : empty;
+    }
 
     bool is_assert() const
     {
@@ -132,11 +145,11 @@ public:
 
     // for OUTPUT
     std::string format_string;
-    std::list<expr2tc> output_args;
+    std::vector<expr2tc> output_args;
 
     // for conversion
     smt_astt guard_ast, cond_ast;
-    std::list<expr2tc> converted_output_args;
+    std::vector<expr2tc> converted_output_args;
 
     // for slicing
     bool ignore;
@@ -168,19 +181,55 @@ public:
     return i;
   }
 
-  typedef std::list<SSA_stept> SSA_stepst;
+  // Steps live in an arena of fixed size chunks: appending never moves a
+  // step and clear() hands the whole equation back in one go.
+  typedef chunked_vectort<SSA_stept> SSA_stepst;
   SSA_stepst SSA_steps;
 
   SSA_stepst::iterator get_SSA_step(unsigned s)
   {
-    SSA_stepst::iterator it = SSA_steps.begin();
-    for(; s != 0; s--)
+    assert(s <= SSA_steps.size());
+    return SSA_steps.begin() + s;
+  }
+
+  // Deduplicates the stack traces attached to SSA steps. Consecutive steps
+  // nearly always come from the same call stack, so the last trace is
+  // checked before the table is.
+  class stack_trace_tablet
+  {
+  public:
+    stack_tracet intern(std::vector<stack_framet> &&stack_trace);
+
+    void clear()
     {
-      assert(it != SSA_steps.end());
-      it++;
+      table.clear();
+      last.reset();
     }
-    return it;
-  }
+
+    size_t size() const
+    {
+      return table.size();
+    }
+
+  protected:
+    struct hasht
+    {
+      size_t operator()(const stack_tracet &s) const;
+    };
+
+    struct equalt
+    {
+      bool operator()(const stack_tracet &a, const stack_tracet &b) const
+      {
+        return *a == *b;
+      }
+    };
+
+    std::unordered_set<stack_tracet, hasht, equalt> table;
+    stack_tracet last;
+  };
+
+  stack_trace_tablet stack_traces;
 
   void output(std::ostream &out) const;
   void short_output(std::ostream &out, bool show_ignored = false) const;
@@ -190,6 +239,7 @@ public:
   void clear()
   {
     SSA_steps.clear();
+    stack_traces.clear();
   }
 
   unsigned int clear_assertions();
@@ -233,17 +283,11 @@ public:
   smt_convt &conv;
   std::list<smt_convt::ast_vec> assert_vec_list;
   std::list<smt_astt> assumpt_chain;
-  std::list<SSA_stepst::iterator> scoped_end_points;
-  SSA_stepst::iterator cvt_progress;
+  // Number of steps that have been converted, and its value at each push
+  std::list<size_t> scoped_end_points;
+  size_t cvt_progress;
 };
 
-extern inline bool operator<(
-  const symex_target_equationt::SSA_stepst::const_iterator a,
-  const symex_target_equationt::SSA_stepst::const_iterator b)
-{
-  return &(*a) < &(*b);
-}
-
 std::ostream &
 operator<<(std::ostream &out, const symex_target_equationt::SSA_stept &step);
 std::ostream &
@@ -0,0 +1,112 @@
+#include <cadical_conv.h>
+#include <sstream>
+
+smt_convt *create_new_cadical_solver(
+  bool int_encoding,
+  const namespacet &ns,
+  tuple_iface **tuple_api __attribute__((unused)),
+  array_iface **array_api __attribute__((unused)),
+  fp_convt **fp_api __attribute__((unused)))
+{
+  if(int_encoding)
+  {
+    std::cerr << "CaDiCaL can only be used with bit-vector arithmetic"
+              << std::endl;
+    abort();
+  }
+
+  // No native tuples, arrays or floats: the default flatteners lower all of
+  // them to bitvector operations, which end up here as clauses.
+  return new cadical_convt(int_encoding, ns);
+}
+
+cadical_convt::cadical_convt(bool int_encoding, const namespacet &_ns)
+  : cnf_iface(),
+    cnf_convt(static_cast<cnf_iface *>(this)),
+    bitblast_convt(int_encoding, _ns, static_cast<sat_iface *>(this)),
+    solver(),
+    num_vars(0)
+{
+}
+
+const std::string cadical_convt::solver_text()
+{
+  std::stringstream ss;
+  ss << "CaDiCaL " << CaDiCaL::Solver::version();
+  return ss.str();
+}
+
+literalt cadical_convt::new_variable()
+{
+  literalt l;
+  l.set(++num_vars, false);
+  return l;
+}
+
+void cadical_convt::lcnf(const bvt &bv)
+{
+  bvt new_bv;
+
+  if(process_clause(bv, new_bv))
+    return;
+
+  // An empty clause is added as such, making the formula unsatisfiable
+  for(const literalt &l : new_bv)
+    solver.add(to_lit(l));
+  solver.add(0);
+}
+
+void cadical_convt::setto(literalt a, bool val)
+{
+  assert_lit(val ? a : cnf_convt::lnot(a));
+}
+
+void cadical_convt::assert_lit(const literalt &l)
+{
+  if(l.is_true())
+    return;
+
+  if(l.is_false())
+  {
+    solver.add(0);
+    return;
+  }
+
+  solver.add(to_lit(l));
+  solver.add(0);
+}
+
+smt_convt::resultt cadical_convt::solve(const bvt &assumptions)
+{
+  // Assumptions only last for the next call, so push/pop can keep its
+  // activation literals in the solver without ever re-adding clauses.
+  for(const literalt &l : assumptions)
+    solver.assume(to_lit(l));
+
+  int res = solver.solve();
+  if(res == 10)
+    return smt_convt::P_SATISFIABLE;
+
+  if(res == 20)
+    return smt_convt::P_UNSATISFIABLE;
+
+  return smt_convt::P_ERROR;
+}
+
+tvt cadical_convt::l_get(const literalt &l)
+{
+  if(l.is_true())
+    return tvt(tvt::TV_TRUE);
+
+  if(l.is_false())
+    return tvt(tvt::TV_FALSE);
+
+  // Variables that never made it into a clause have no value
+  if(l.var_no() > (unsigned int)solver.vars())
+    return tvt(tvt::TV_UNKNOWN);
+
+  // Ask about the variable rather than the literal: whether val() answers
+  // with +/-1 or +/-lit differs between releases, its sign does not.
+  bool var_true = solver.val(l.var_no()) > 0;
+  return tvt(var_true != l.sign());
+}
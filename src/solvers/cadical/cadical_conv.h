@@ -0,0 +1,40 @@
+#ifndef _ESBMC_SOLVERS_CADICAL_CADICAL_CONV_H_
+#define _ESBMC_SOLVERS_CADICAL_CADICAL_CONV_H_
+
+#include <cadical.hpp>
+#include <solvers/sat/bitblast_conv.h>
+#include <solvers/sat/cnf_conv.h>
+#include <solvers/sat/cnf_iface.h>
+
+class cadical_convt : public cnf_iface, public cnf_convt, public bitblast_convt
+{
+public:
+  cadical_convt(bool int_encoding, const namespacet &_ns);
+  ~cadical_convt() override = default;
+
+  const std::string solver_text() override;
+
+  // sat_iface / cnf_iface, everything else is reduced to clauses by cnf_convt
+  tvt l_get(const literalt &l) override;
+  literalt new_variable() override;
+  void assert_lit(const literalt &l) override;
+  void lcnf(const bvt &bv) override;
+  void setto(literalt a, bool val) override;
+  smt_convt::resultt solve(const bvt &assumptions) override;
+
+  using smt_convt::l_get;
+
+  // CaDiCaL literals are non-zero ints, negative when negated
+  inline int to_lit(literalt l) const
+  {
+    assert(!l.is_constant());
+    int v = l.var_no();
+    return l.sign() ? -v : v;
+  }
+
+  // Members
+  CaDiCaL::Solver solver;
+  unsigned int num_vars;
+};
+
+#endif /* _ESBMC_SOLVERS_CADICAL_CADICAL_CONV_H_ */
@@ -1,5 +1,6 @@
 #include <set>
-#include <bitblast_conv.h>
+#include <solvers/sat/bitblast_conv.h>
+#include <util/mp_arith.h>
 
 bitblast_convt::bitblast_convt(
   bool int_encoding,
@@ -9,486 +10,429 @@ bitblast_convt::bitblast_convt(
 {
 }
 
-bitblast_convt::~bitblast_convt()
+void bitblast_smt_ast::dump() const
 {
+  // Most significant bit first, like a bitvector constant
+  for(bvt::const_reverse_iterator it = a.rbegin(); it != a.rend(); it++)
+  {
+    if(it->is_true())
+      std::cout << " 1";
+    else if(it->is_false())
+      std::cout << " 0";
+    else
+      std::cout << (it->sign() ? " -" : " ") << it->var_no();
+  }
+
+  std::cout << " (" << a.size() << " bits)" << std::endl;
+}
+
+smt_convt::resultt bitblast_convt::dec_solve()
+{
+  pre_solve();
+  return sat_api->solve(ctx_guards);
 }
 
 void bitblast_convt::assert_ast(smt_astt a)
 {
   assert(a->sort->id == SMT_SORT_BOOL);
-  const bitblast_smt_ast *ba = bitblast_ast_downcast(a);
-  sat_api->assert_lit(ba->bv[0]);
-  return;
+  literalt l = get_bits(a)[0];
+
+  if(ctx_guards.empty())
+  {
+    sat_api->assert_lit(l);
+    return;
+  }
+
+  bvt clause;
+  clause.push_back(sat_api->lnot(ctx_guards.back()));
+  clause.push_back(l);
+  sat_api->lcnf(clause);
 }
 
-smt_astt bitblast_convt::mk_func_app(
-  smt_sortt ressort,
-  smt_func_kind f,
-  const smt_ast *const *_args,
-  unsigned int numargs)
+void bitblast_convt::push_ctx()
 {
-  const bitblast_smt_ast *args[4];
-  bitblast_smt_ast *result = NULL;
-  unsigned int i;
+  smt_convt::push_ctx();
+  ctx_guards.push_back(sat_api->new_variable());
+}
 
-  assert(numargs < 4 && "Too many arguments to bitblast_convt::mk_func_app");
-  for(i = 0; i < numargs; i++)
-    args[i] = bitblast_ast_downcast(_args[i]);
+void bitblast_convt::pop_ctx()
+{
+  // Retire the level for good: clauses guarded by it become satisfied and
+  // the solver is free to simplify them away.
+  assert(!ctx_guards.empty());
+  sat_api->assert_lit(sat_api->lnot(ctx_guards.back()));
+  ctx_guards.pop_back();
+  smt_convt::pop_ctx();
+}
 
-  switch(f)
-  {
-  case SMT_FUNC_EQ:
-  {
-    assert(ressort->id == SMT_SORT_BOOL);
-    result = mk_ast_equality(args[0], args[1], ressort);
-    break;
-  }
-  case SMT_FUNC_NOTEQ:
-  {
-    assert(ressort->id == SMT_SORT_BOOL);
-    result = mk_ast_equality(args[0], args[1], ressort);
-    result->bv[0] = sat_api->lnot(result->bv[0]);
-    break;
-  }
-  case SMT_FUNC_NOT:
-  {
-    literalt res = sat_api->lnot(args[0]->bv[0]);
-    result = new_ast(ressort);
-    result->bv.push_back(res);
-    break;
-  }
-  case SMT_FUNC_OR:
-  {
-    literalt res = sat_api->lor(args[0]->bv[0], args[1]->bv[0]);
-    result = new_ast(ressort);
-    result->bv.push_back(res);
-    break;
-  }
-  case SMT_FUNC_IMPLIES:
-  {
-    result = new_ast(ressort);
-    result->bv.push_back(sat_api->limplies(args[0]->bv[0], args[1]->bv[0]));
-    break;
-  }
-  case SMT_FUNC_ITE:
-  {
-    if(ressort->id == SMT_SORT_ARRAY)
-    {
-      return _args[1]->ite(this, _args[0], _args[2]);
-    }
-    else
-    {
-      assert(args[1]->bv.size() == args[2]->bv.size());
-      result = new_ast(ressort);
-      for(unsigned int i = 0; i < args[1]->bv.size(); i++)
-        result->bv.push_back(
-          sat_api->lselect(args[0]->bv[0], args[1]->bv[i], args[2]->bv[i]));
-    }
-    break;
-  }
-  case SMT_FUNC_AND:
-  {
-    result = new_ast(ressort);
-    result->bv.push_back(sat_api->land(args[0]->bv[0], args[1]->bv[0]));
-    break;
-  }
-  case SMT_FUNC_XOR:
-  {
-    result = new_ast(ressort);
-    result->bv.push_back(sat_api->lxor(args[0]->bv[0], args[1]->bv[0]));
-    break;
-  }
-  case SMT_FUNC_BVADD:
-  {
-    literalt carry_in = const_literal(false);
-    literalt carry_out;
-    result = new_ast(ressort);
-    full_adder(args[0]->bv, args[1]->bv, result->bv, carry_in, carry_out);
-    break;
-  }
-  case SMT_FUNC_BVSUB:
-  {
-    literalt carry_in = const_literal(true);
-    literalt carry_out;
-    result = new_ast(ressort);
-    bvt op1 = args[1]->bv;
-    invert(op1);
-    full_adder(args[0]->bv, op1, result->bv, carry_in, carry_out);
-    break;
-  }
-  case SMT_FUNC_BVUGT:
-  {
-    // Same as LT flipped
-    smt_astt args2[2];
-    args2[0] = _args[1];
-    args2[1] = _args[0];
-    return mk_func_app(ressort, SMT_FUNC_BVULT, args2, 2);
-  }
-  case SMT_FUNC_BVUGTE:
-  {
-    // This is the negative of less-than
-    smt_astt a = mk_func_app(ressort, SMT_FUNC_BVULT, _args, 2);
-    a = mk_func_app(ressort, SMT_FUNC_NOT, &a, 1);
-    return a;
-  }
-  case SMT_FUNC_BVULT:
-  {
-    result = new_ast(ressort);
-    result->bv.push_back(unsigned_less_than(args[0]->bv, args[1]->bv));
-    break;
-  }
-  case SMT_FUNC_BVULTE:
-  {
-    result = new_ast(ressort);
-    result->bv.push_back(lt_or_le(true, args[0]->bv, args[1]->bv, false));
-    break;
-  }
-  case SMT_FUNC_BVSGTE:
-  {
-    // This is the negative of less-than
-    smt_astt a = mk_func_app(ressort, SMT_FUNC_BVSLT, _args, 2);
-    return mk_func_app(ressort, SMT_FUNC_NOT, &a, 1);
-  }
-  case SMT_FUNC_BVSLTE:
-  {
-    result = new_ast(ressort);
-    result->bv.push_back(lt_or_le(true, args[0]->bv, args[1]->bv, true));
-    break;
-  }
-  case SMT_FUNC_BVSGT:
-  {
-    // Same as LT flipped
-    smt_astt args2[2];
-    args2[0] = _args[1];
-    args2[1] = _args[0];
-    return mk_func_app(ressort, SMT_FUNC_BVSLT, args2, 2);
-  }
-  case SMT_FUNC_BVSLT:
-  {
-    result = new_ast(ressort);
-    result->bv.push_back(lt_or_le(false, args[0]->bv, args[1]->bv, true));
-    break;
-  }
-  case SMT_FUNC_BVMUL:
-  {
-    result = new_ast(ressort);
-    const bitblast_smt_sort *sort0 = bitblast_sort_downcast(args[0]->sort);
-    const bitblast_smt_sort *sort1 = bitblast_sort_downcast(args[1]->sort);
-    if(sort0->sign || sort1->sign)
-    {
-      signed_multiplier(args[0]->bv, args[1]->bv, result->bv);
-    }
-    else
-    {
-      unsigned_multiplier(args[0]->bv, args[1]->bv, result->bv);
-    }
-    break;
-  }
-  case SMT_FUNC_CONCAT:
-  {
-    result = new_ast(ressort);
-    result->bv.insert(
-      result->bv.begin(), args[0]->bv.begin(), args[0]->bv.end());
-    result->bv.insert(
-      result->bv.begin(), args[1]->bv.begin(), args[1]->bv.end());
-    break;
-  }
-  case SMT_FUNC_BVAND:
-  {
-    result = new_ast(ressort);
-    bvand(args[0]->bv, args[1]->bv, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVXOR:
-  {
-    result = new_ast(ressort);
-    bvxor(args[0]->bv, args[1]->bv, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVOR:
-  {
-    result = new_ast(ressort);
-    bvor(args[0]->bv, args[1]->bv, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVNOT:
-  {
-    result = new_ast(ressort);
-    bvnot(args[0]->bv, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVASHR:
-  {
-    result = new_ast(ressort);
-    barrel_shift(
-      args[0]->bv, bitblast_convt::shiftt::ARIGHT, args[1]->bv, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVLSHR:
-  {
-    result = new_ast(ressort);
-    barrel_shift(
-      args[0]->bv, bitblast_convt::shiftt::LRIGHT, args[1]->bv, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVSHL:
-  {
-    result = new_ast(ressort);
-    barrel_shift(
-      args[0]->bv, bitblast_convt::shiftt::LEFT, args[1]->bv, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVSDIV:
-  {
-    bvt rem;
-    result = new_ast(ressort);
-    signed_divider(args[0]->bv, args[1]->bv, result->bv, rem);
-    break;
-  }
-  case SMT_FUNC_BVUDIV:
-  {
-    bvt rem;
-    result = new_ast(ressort);
-    unsigned_divider(args[0]->bv, args[1]->bv, result->bv, rem);
-    break;
-  }
-  case SMT_FUNC_BVSMOD:
-  {
-    bvt res;
-    result = new_ast(ressort);
-    signed_divider(args[0]->bv, args[1]->bv, res, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVUMOD:
-  {
-    bvt res;
-    result = new_ast(ressort);
-    unsigned_divider(args[0]->bv, args[1]->bv, res, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVNEG:
-  {
-    result = new_ast(ressort);
-    negate(args[0]->bv, result->bv);
-    break;
-  }
-  default:
-    std::cerr << "Unimplemented SMT function \"" << smt_func_name_table[f]
-              << "\" in bitblast convt" << std::endl;
-    abort();
-  }
+smt_astt bitblast_convt::mk_bvadd(smt_astt a, smt_astt b)
+{
+  bvt res;
+  literalt carry_out;
+  full_adder(get_bits(a), get_bits(b), res, const_literal(false), carry_out);
+  return new_ast(res, a->sort);
+}
 
-  return result;
+smt_astt bitblast_convt::mk_bvsub(smt_astt a, smt_astt b)
+{
+  bvt res;
+  literalt carry_out;
+  bvt op1 = get_bits(b);
+  invert(op1);
+  full_adder(get_bits(a), op1, res, const_literal(true), carry_out);
+  return new_ast(res, a->sort);
 }
 
-smt_sort *bitblast_convt::mk_sort(smt_sort_kind k, ...)
+smt_astt bitblast_convt::mk_bvmul(smt_astt a, smt_astt b)
 {
-  va_list ap;
-  bitblast_smt_sort *s = NULL, *dom, *range;
-  unsigned long uint;
-  int thebool;
+  // Signedness doesn't matter for the low half of a product
+  bvt res;
+  unsigned_multiplier(get_bits(a), get_bits(b), res);
+  return new_ast(res, a->sort);
+}
 
-  va_start(ap, k);
-  switch(k)
-  {
-  case SMT_SORT_INT:
-    std::cerr << "Can't make Int sorts in bitblaster" << std::endl;
-    abort();
-  case SMT_SORT_REAL:
-    std::cerr << "Can't make Real sorts in bitblaster" << std::endl;
-    abort();
-  case SMT_SORT_BV:
-    uint = va_arg(ap, unsigned long);
-    thebool = va_arg(ap, int);
-    s = new bitblast_smt_sort(k, uint, thebool);
-    break;
-  case SMT_SORT_ARRAY:
-    dom = va_arg(ap, bitblast_smt_sort *); // Consider constness?
-    range = va_arg(ap, bitblast_smt_sort *);
-    s = new bitblast_smt_sort(k, range->data_width, dom->data_width);
-    break;
-  case SMT_SORT_BOOL:
-    s = new bitblast_smt_sort(k);
-    break;
-  default:
-    std::cerr << "Unimplemented SMT sort " << k << " in bitblaster conversion"
-              << std::endl;
-    abort();
-  }
+smt_astt bitblast_convt::mk_bvsmod(smt_astt a, smt_astt b)
+{
+  bvt res, rem;
+  signed_divider(get_bits(a), get_bits(b), res, rem);
+  return new_ast(rem, a->sort);
+}
+
+smt_astt bitblast_convt::mk_bvumod(smt_astt a, smt_astt b)
+{
+  bvt res, rem;
+  unsigned_divider(get_bits(a), get_bits(b), res, rem);
+  return new_ast(rem, a->sort);
+}
+
+smt_astt bitblast_convt::mk_bvsdiv(smt_astt a, smt_astt b)
+{
+  bvt res, rem;
+  signed_divider(get_bits(a), get_bits(b), res, rem);
+  return new_ast(res, a->sort);
+}
+
+smt_astt bitblast_convt::mk_bvudiv(smt_astt a, smt_astt b)
+{
+  bvt res, rem;
+  unsigned_divider(get_bits(a), get_bits(b), res, rem);
+  return new_ast(res, a->sort);
+}
+
+smt_astt bitblast_convt::mk_bvshl(smt_astt a, smt_astt b)
+{
+  bvt res;
+  barrel_shift(get_bits(a), LEFT, get_bits(b), res);
+  return new_ast(res, a->sort);
+}
+
+smt_astt bitblast_convt::mk_bvashr(smt_astt a, smt_astt b)
+{
+  bvt res;
+  barrel_shift(get_bits(a), ARIGHT, get_bits(b), res);
+  return new_ast(res, a->sort);
+}
+
+smt_astt bitblast_convt::mk_bvlshr(smt_astt a, smt_astt b)
+{
+  bvt res;
+  barrel_shift(get_bits(a), LRIGHT, get_bits(b), res);
+  return new_ast(res, a->sort);
+}
+
+smt_astt bitblast_convt::mk_bvneg(smt_astt a)
+{
+  bvt res;
+  negate(get_bits(a), res);
+  return new_ast(res, a->sort);
+}
+
+smt_astt bitblast_convt::mk_bvnot(smt_astt a)
+{
+  bvt res;
+  bvnot(get_bits(a), res);
+  return new_ast(res, a->sort);
+}
+
+smt_astt bitblast_convt::mk_bvnxor(smt_astt a, smt_astt b)
+{
+  bvt res;
+  bvxor(get_bits(a), get_bits(b), res);
+  invert(res);
+  return new_ast(res, a->sort);
+}
+
+smt_astt bitblast_convt::mk_bvnor(smt_astt a, smt_astt b)
+{
+  bvt res;
+  bvor(get_bits(a), get_bits(b), res);
+  invert(res);
+  return new_ast(res, a->sort);
+}
+
+smt_astt bitblast_convt::mk_bvnand(smt_astt a, smt_astt b)
+{
+  bvt res;
+  bvand(get_bits(a), get_bits(b), res);
+  invert(res);
+  return new_ast(res, a->sort);
+}
+
+smt_astt bitblast_convt::mk_bvxor(smt_astt a, smt_astt b)
+{
+  bvt res;
+  bvxor(get_bits(a), get_bits(b), res);
+  return new_ast(res, a->sort);
+}
+
+smt_astt bitblast_convt::mk_bvor(smt_astt a, smt_astt b)
+{
+  bvt res;
+  bvor(get_bits(a), get_bits(b), res);
+  return new_ast(res, a->sort);
+}
+
+smt_astt bitblast_convt::mk_bvand(smt_astt a, smt_astt b)
+{
+  bvt res;
+  bvand(get_bits(a), get_bits(b), res);
+  return new_ast(res, a->sort);
+}
+
+smt_astt bitblast_convt::mk_implies(smt_astt a, smt_astt b)
+{
+  assert(a->sort->id == SMT_SORT_BOOL && b->sort->id == SMT_SORT_BOOL);
+  return new_bool_ast(sat_api->limplies(get_bits(a)[0], get_bits(b)[0]));
+}
+
+smt_astt bitblast_convt::mk_xor(smt_astt a, smt_astt b)
+{
+  assert(a->sort->id == SMT_SORT_BOOL && b->sort->id == SMT_SORT_BOOL);
+  return new_bool_ast(sat_api->lxor(get_bits(a)[0], get_bits(b)[0]));
+}
+
+smt_astt bitblast_convt::mk_or(smt_astt a, smt_astt b)
+{
+  assert(a->sort->id == SMT_SORT_BOOL && b->sort->id == SMT_SORT_BOOL);
+  return new_bool_ast(sat_api->lor(get_bits(a)[0], get_bits(b)[0]));
+}
+
+smt_astt bitblast_convt::mk_and(smt_astt a, smt_astt b)
+{
+  assert(a->sort->id == SMT_SORT_BOOL && b->sort->id == SMT_SORT_BOOL);
+  return new_bool_ast(sat_api->land(get_bits(a)[0], get_bits(b)[0]));
+}
+
+smt_astt bitblast_convt::mk_not(smt_astt a)
+{
+  assert(a->sort->id == SMT_SORT_BOOL);
+  return new_bool_ast(sat_api->lnot(get_bits(a)[0]));
+}
+
+smt_astt bitblast_convt::mk_bvult(smt_astt a, smt_astt b)
+{
+  return new_bool_ast(lt_or_le(false, get_bits(a), get_bits(b), false));
+}
+
+smt_astt bitblast_convt::mk_bvslt(smt_astt a, smt_astt b)
+{
+  return new_bool_ast(lt_or_le(false, get_bits(a), get_bits(b), true));
+}
+
+smt_astt bitblast_convt::mk_bvugt(smt_astt a, smt_astt b)
+{
+  return new_bool_ast(lt_or_le(false, get_bits(b), get_bits(a), false));
+}
+
+smt_astt bitblast_convt::mk_bvsgt(smt_astt a, smt_astt b)
+{
+  return new_bool_ast(lt_or_le(false, get_bits(b), get_bits(a), true));
+}
+
+smt_astt bitblast_convt::mk_bvule(smt_astt a, smt_astt b)
+{
+  return new_bool_ast(lt_or_le(true, get_bits(a), get_bits(b), false));
+}
+
+smt_astt bitblast_convt::mk_bvsle(smt_astt a, smt_astt b)
+{
+  return new_bool_ast(lt_or_le(true, get_bits(a), get_bits(b), true));
+}
+
+smt_astt bitblast_convt::mk_bvuge(smt_astt a, smt_astt b)
+{
+  return new_bool_ast(lt_or_le(true, get_bits(b), get_bits(a), false));
+}
+
+smt_astt bitblast_convt::mk_bvsge(smt_astt a, smt_astt b)
+{
+  return new_bool_ast(lt_or_le(true, get_bits(b), get_bits(a), true));
+}
 
-  return s;
+smt_astt bitblast_convt::mk_eq(smt_astt a, smt_astt b)
+{
+  // Arrays and tuples never get here, the flatteners reduce them to
+  // equalities over their elements.
+  assert(a->sort->id != SMT_SORT_ARRAY && a->sort->id != SMT_SORT_STRUCT);
+
+  if(a->sort->id == SMT_SORT_BOOL)
+    return new_bool_ast(sat_api->lequal(get_bits(a)[0], get_bits(b)[0]));
+
+  return new_bool_ast(equal(get_bits(a), get_bits(b)));
+}
+
+smt_astt bitblast_convt::mk_neq(smt_astt a, smt_astt b)
+{
+  literalt l = get_bits(mk_eq(a, b))[0];
+  return new_bool_ast(sat_api->lnot(l));
+}
+
+smt_sortt bitblast_convt::mk_bool_sort()
+{
+  return new smt_sort(SMT_SORT_BOOL, 1);
+}
+
+smt_sortt bitblast_convt::mk_bv_sort(std::size_t width)
+{
+  return new smt_sort(SMT_SORT_BV, width);
 }
 
-smt_ast *bitblast_convt::mk_smt_int(const BigInt &intval
+smt_sortt bitblast_convt::mk_fbv_sort(std::size_t width)
+{
+  return new smt_sort(SMT_SORT_FIXEDBV, width);
+}
+
+smt_sortt bitblast_convt::mk_bvfp_sort(std::size_t ew, std::size_t sw)
+{
+  return new smt_sort(SMT_SORT_BVFP, ew + sw + 1, sw + 1);
+}
+
+smt_sortt bitblast_convt::mk_bvfp_rm_sort()
+{
+  return new smt_sort(SMT_SORT_BVFP_RM, 3);
+}
+
+smt_sortt bitblast_convt::mk_array_sort(smt_sortt domain, smt_sortt range)
+{
+  // Only ever used by the array flattener to describe the arrays it builds
+  return new smt_sort(SMT_SORT_ARRAY, domain->get_data_width(), range);
+}
+
+smt_astt bitblast_convt::mk_smt_int(const BigInt &theint
                                     __attribute__((unused)))
 {
   std::cerr << "Can't create integers in bitblast solver" << std::endl;
   abort();
 }
 
-smt_ast *bitblast_convt::mk_smt_real(const std::string &value
+smt_astt bitblast_convt::mk_smt_real(const std::string &str
                                      __attribute__((unused)))
 {
   std::cerr << "Can't create reals in bitblast solver" << std::endl;
   abort();
 }
 
-smt_ast *
-bitblast_convt::mk_smt_bvint(const BigInt &intval, bool sign, unsigned int w)
+smt_astt bitblast_convt::mk_smt_bv(const BigInt &theint, smt_sortt s)
 {
-  smt_sort *s = mk_sort(SMT_SORT_BV, w, sign);
-  bitblast_smt_ast *a = new_ast(s);
-  a->bv.resize(w);
-  int u = intval.to_int64();
-  for(unsigned int i = 0; i < w; i++)
-  {
-    int mask = (1ULL << i);
-    bool val = u & mask;
-    a->bv[i] = const_literal(val);
-  }
+  std::size_t w = s->get_data_width();
+  std::string bits = integer2binary(theint, w);
 
-  return a;
+  bvt bv(w);
+  for(std::size_t i = 0; i < w; i++)
+    bv[i] = const_literal(bits[w - 1 - i] == '1');
+
+  return new_ast(bv, s);
 }
 
-smt_ast *bitblast_convt::mk_smt_bool(bool boolval)
+smt_astt bitblast_convt::mk_smt_bool(bool val)
 {
-  literalt l = const_literal(boolval);
-
-  smt_sort *s = mk_sort(SMT_SORT_BOOL);
-  bitblast_smt_ast *a = new_ast(s);
-  a->bv.push_back(l);
-  return a;
+  return new_bool_ast(const_literal(val));
 }
 
-smt_astt bitblast_convt::mk_smt_symbol(const std::string &name, smt_sortt sort)
+smt_astt bitblast_convt::mk_smt_symbol(const std::string &name, smt_sortt s)
 {
-  // Otherwise, we need to build this AST ourselves.
-  bitblast_smt_ast *a = new_ast(sort);
-  smt_astt result = a;
-  const bitblast_smt_sort *s = bitblast_sort_downcast(sort);
-  switch(sort->id)
-  {
-  case SMT_SORT_BOOL:
-  {
-    literalt l = sat_api->new_variable();
-    a->bv.push_back(l);
-    break;
-  }
-  case SMT_SORT_BV:
+  assert(s->id != SMT_SORT_ARRAY && s->id != SMT_SORT_STRUCT);
+
+  symtable_typet::const_iterator it = symtable.find(name);
+  if(it != symtable.end())
   {
-    // Bunch of fresh variables
-    for(unsigned int i = 0; i < s->data_width; i++)
-      a->bv.push_back(sat_api->new_variable());
-    break;
-  }
-  default:
-    std::cerr << "Unimplemented symbol type " << sort->id
-              << " in bitblast symbol creation" << std::endl;
-    abort();
+    assert(it->second.size() == s->get_data_width());
+    return new_ast(it->second, s);
   }
 
-  return result;
+  // Bunch of fresh variables
+  bvt bv(s->get_data_width());
+  for(literalt &l : bv)
+    l = sat_api->new_variable();
+
+  symtable.emplace(name, bv);
+  return new_ast(bv, s);
 }
 
-smt_sort *bitblast_convt::mk_struct_sort(const type2tc &t
-                                         __attribute__((unused)))
+smt_astt
+bitblast_convt::mk_extract(smt_astt a, unsigned int high, unsigned int low)
 {
-  abort();
+  const bvt &src = get_bits(a);
+  assert(high < src.size() && low <= high);
+  bvt res(src.begin() + low, src.begin() + high + 1);
+  return new_ast(res, mk_bv_sort(res.size()));
 }
 
-smt_ast *bitblast_convt::mk_extract(
-  smt_astt src,
-  unsigned int high,
-  unsigned int low,
-  smt_sortt s)
+smt_astt bitblast_convt::mk_sign_ext(smt_astt a, unsigned int topwidth)
 {
-  const bitblast_smt_ast *mast = bitblast_ast_downcast(src);
-  bitblast_smt_ast *result = new_ast(s);
-  for(unsigned int i = low; i <= high; i++)
-    result->bv.push_back(mast->bv[i]);
-
-  return result;
+  bvt res = get_bits(a);
+  literalt sign = res.back();
+  res.insert(res.end(), topwidth, sign);
+  return new_ast(res, mk_bv_sort(res.size()));
 }
 
-bitblast_smt_ast *
-bitblast_convt::mk_ast_equality(smt_astt _a, smt_astt _b, smt_sortt ressort)
+smt_astt bitblast_convt::mk_zero_ext(smt_astt a, unsigned int topwidth)
 {
-  const bitblast_smt_ast *a = bitblast_ast_downcast(_a);
-  const bitblast_smt_ast *b = bitblast_ast_downcast(_b);
+  bvt res = get_bits(a);
+  res.insert(res.end(), topwidth, const_literal(false));
+  return new_ast(res, mk_bv_sort(res.size()));
+}
 
-  switch(a->sort->id)
-  {
-  case SMT_SORT_BOOL:
-  {
-    literalt res = sat_api->lequal(a->bv[0], b->bv[0]);
-    bitblast_smt_ast *n = new_ast(a->sort);
-    n->bv.push_back(res);
-    return n;
-  }
-  case SMT_SORT_BV:
-  {
-    bitblast_smt_ast *n = new_ast(ressort);
-    n->bv.push_back(equal(a->bv, b->bv));
-    return n;
-  }
-  case SMT_SORT_ARRAY:
-  {
-    // XXX - so, if we have different array encodings in the future then this
-    // might get quite funky. Leave it until then, though.
-    std::cerr << "No direct array equality support in bitblast converter"
-              << std::endl;
-    abort();
-  }
-  default:
-    std::cerr << "Invalid sort " << a->sort->id << " for equality in bitblast"
-              << std::endl;
-    abort();
-  }
+smt_astt bitblast_convt::mk_concat(smt_astt a, smt_astt b)
+{
+  // a provides the top bits
+  bvt res = get_bits(b);
+  const bvt &top = get_bits(a);
+  res.insert(res.end(), top.begin(), top.end());
+  return new_ast(res, mk_bv_sort(res.size()));
 }
 
-expr2tc bitblast_convt::get_bool(smt_astt a)
+smt_astt bitblast_convt::mk_ite(smt_astt cond, smt_astt t, smt_astt f)
 {
-  tvt t = l_get(a);
-  if(t.is_true())
-    return gen_true_expr();
-  else if(t.is_false())
-    return gen_false_expr();
-  else
-    return expr2tc();
+  literalt c = get_bits(cond)[0];
+  const bvt &tv = get_bits(t);
+  const bvt &fv = get_bits(f);
+  assert(tv.size() == fv.size());
+
+  bvt res(tv.size());
+  for(std::size_t i = 0; i < tv.size(); i++)
+    res[i] = sat_api->lselect(c, tv[i], fv[i]);
+
+  return new_ast(res, t->sort);
 }
 
-tvt bitblast_convt::l_get(smt_astt a)
+bool bitblast_convt::get_bool(smt_astt a)
 {
-  const bitblast_smt_ast *mast = bitblast_ast_downcast(a);
-  return sat_api->l_get(mast->bv[0]);
+  // Literals the solver never saw are unconstrained, so false is as good an
+  // answer as any.
+  return sat_api->l_get(get_bits(a)[0]).is_true();
 }
 
-expr2tc bitblast_convt::get_bv(const type2tc &t, smt_astt a)
+BigInt bitblast_convt::get_bv(smt_astt a)
 {
-  const bitblast_smt_ast *mast = bitblast_ast_downcast(a);
-  unsigned int sz = t->get_width();
-  assert(sz <= 64 && "Your integers are larger than a uint64_t");
-  assert(mast->bv.size() == sz);
-  uint64_t accuml = 0;
-  for(unsigned int i = 0; i < sz; i++)
-  {
-    uint64_t mask = 1 << i;
-    tvt t = sat_api->l_get(mast->bv[i]);
-    if(t.is_true())
-    {
-      accuml |= mask;
-    }
-    else if(t.is_false())
-    {
-      ; // It's zero
-    }
-    else
-    {
-      ; // It's undefined in this model. So may as well be zero.
-    }
-  }
+  const bvt &bv = get_bits(a);
 
-  return constant_int2tc(t, BigInt(accuml));
+  std::string bits(bv.size(), '0');
+  for(std::size_t i = 0; i < bv.size(); i++)
+    if(sat_api->l_get(bv[i]).is_true())
+      bits[bv.size() - 1 - i] = '1';
+
+  return string2integer(bits, 2);
 }
 
 // ******************************  Bitblast foo *******************************
@@ -547,6 +491,7 @@ void bitblast_convt::full_adder(
   literalt &carry_out)
 {
   assert(op0.size() == op1.size());
+  output.clear();
   output.reserve(op0.size());
 
   carry_out = carry_in;
@@ -556,8 +501,6 @@ void bitblast_convt::full_adder(
     output.push_back(sat_api->lxor(sat_api->lxor(op0[i], op1[i]), carry_out));
     carry_out = carry(op0[i], op1[i], carry_out);
   }
-
-  return;
 }
 
 literalt bitblast_convt::carry(literalt a, literalt b, literalt c)
@@ -570,22 +513,13 @@ literalt bitblast_convt::carry(literalt a, literalt b, literalt c)
   return lor(tmp);
 }
 
-literalt bitblast_convt::unsigned_less_than(const bvt &arg0, const bvt &arg1)
-{
-  bvt tmp = arg1;
-  invert(tmp);
-  return sat_api->lnot(carry_out(arg0, tmp, const_literal(true)));
-}
-
 void bitblast_convt::unsigned_multiplier(
   const bvt &op0,
   const bvt &op1,
   bvt &output)
 {
-  output.resize(op0.size());
-
-  for(unsigned int i = 0; i < op0.size(); i++)
-    output[i] = const_literal(false);
+  assert(op0.size() == op1.size());
+  output.assign(op0.size(), const_literal(false));
 
   for(unsigned int i = 0; i < op0.size(); i++)
   {
@@ -603,32 +537,11 @@ void bitblast_convt::unsigned_multiplier(
       bvt tmpadd;
       literalt dummy;
       full_adder(output, tmpop, tmpadd, const_literal(false), dummy);
-      output = tmpadd;
+      output.swap(tmpadd);
     }
   }
 }
 
-void bitblast_convt::signed_multiplier(
-  const bvt &op0,
-  const bvt &op1,
-  bvt &output)
-{
-  assert(op0.size() == op1.size() && op0.size() != 0);
-  literalt sign0 = op0[op0.size() - 1];
-  literalt sign1 = op1[op1.size() - 1];
-
-  bvt neg0, neg1;
-  cond_negate(op0, neg0, sign0);
-  cond_negate(op1, neg1, sign1);
-
-  bvt tmp;
-  unsigned_multiplier(neg0, neg1, tmp);
-
-  literalt res_sign = sat_api->lxor(sign0, sign1);
-
-  cond_negate(tmp, output, res_sign);
-}
-
 void bitblast_convt::cond_negate(const bvt &vals, bvt &out, literalt cond)
 {
   bvt inv;
@@ -638,37 +551,24 @@ void bitblast_convt::cond_negate(const bvt &vals, bvt &out, literalt cond)
 
   for(unsigned int i = 0; i < vals.size(); i++)
     out[i] = sat_api->lselect(cond, inv[i], vals[i]);
-
-  return;
 }
 
 void bitblast_convt::negate(const bvt &inp, bvt &oup)
 {
-  oup.resize(inp.size());
   bvt inv = inp;
   invert(inv);
-
-  literalt dummy;
-  incrementer(inv, const_literal(true), dummy, oup);
-  return;
+  incrementer(inv, const_literal(true), oup);
 }
 
-void bitblast_convt::incrementer(
-  const bvt &inp,
-  const literalt &carryin,
-  literalt carryout,
-  bvt &oup)
+void bitblast_convt::incrementer(const bvt &inp, literalt carry_in, bvt &oup)
 {
-  carryout = carryin;
+  oup.resize(inp.size());
 
   for(unsigned int i = 0; i < inp.size(); i++)
   {
-    literalt new_carry = sat_api->land(carryout, inp[i]);
-    oup[i] = sat_api->lxor(inp[i], carryout);
-    carryout = new_carry;
+    oup[i] = sat_api->lxor(inp[i], carry_in);
+    carry_in = sat_api->land(carry_in, inp[i]);
   }
-
-  return;
 }
 
 void bitblast_convt::signed_divider(
@@ -677,43 +577,22 @@ void bitblast_convt::signed_divider(
   bvt &res,
   bvt &rem)
 {
-  assert(op0.size() == op1.size());
-
-  bvt _op0;
-  bvt _op1;
-  _op0.resize(op0.size());
-  _op1.resize(op1.size());
-
-  literalt sign0 = op0[op0.size() - 1];
-  literalt sign1 = op1[op1.size() - 1];
-
-  bvt neg0;
-  bvt neg1;
-  negate(op0, neg0);
-  negate(op1, neg1);
-
-  for(unsigned int i = 0; i < op0.size(); i++)
-    _op0[i] = sat_api->lselect(sign0, neg0[i], op0[i]);
-
-  for(unsigned int i = 0; i < op1.size(); i++)
-    _op1[i] = sat_api->lselect(sign1, neg1[i], op1[i]);
+  assert(op0.size() == op1.size() && !op0.empty());
 
-  unsigned_divider(_op0, _op1, res, rem);
+  literalt sign0 = op0.back();
+  literalt sign1 = op1.back();
 
-  bvt neg_res;
-  bvt neg_rem;
-  negate(res, neg_res);
-  negate(rem, neg_rem);
+  bvt abs0, abs1;
+  cond_negate(op0, abs0, sign0);
+  cond_negate(op1, abs1, sign1);
 
-  literalt result_sign = sat_api->lxor(sign0, sign1);
+  bvt ures, urem;
+  unsigned_divider(abs0, abs1, ures, urem);
 
-  for(unsigned int i = 0; i < res.size(); i++)
-    res[i] = sat_api->lselect(result_sign, neg_res[i], res[i]);
-
-  for(unsigned int i = 0; i < rem.size(); i++)
-    rem[i] = sat_api->lselect(result_sign, neg_rem[i], rem[i]);
-
-  return;
+  // The quotient is negative when the signs differ, the remainder takes the
+  // sign of the dividend: bvsdiv and bvsrem.
+  cond_negate(ures, res, sat_api->lxor(sign0, sign1));
+  cond_negate(urem, rem, sign0);
 }
 
 void bitblast_convt::unsigned_divider(
@@ -722,151 +601,36 @@ void bitblast_convt::unsigned_divider(
   bvt &res,
   bvt &rem)
 {
+  // Restoring long division, producing one quotient bit per step from the
+  // top. A zero divisor gives an all-ones quotient and op0 as the remainder,
+  // which is exactly what bvudiv and bvurem are defined to do.
   assert(op0.size() == op1.size());
   unsigned int width = op0.size();
   res.resize(width);
-  rem.resize(width);
-
-  literalt is_not_zero = lor(op1);
-
-  for(unsigned int i = 0; i < width; i++)
-  {
-    res[i] = sat_api->new_variable();
-    rem[i] = sat_api->new_variable();
-  }
-
-  bvt product;
-  unsigned_multiplier_no_overflow(res, op1, product);
-
-  // "res*op1 + rem = op0"
-
-  bvt sum;
-  adder_no_overflow(product, rem, sum);
-
-  literalt is_equal = equal(sum, op0);
-
-  sat_api->assert_lit(sat_api->limplies(is_not_zero, is_equal));
-
-  // "op1 != 0 => rem < op1"
-
-  sat_api->assert_lit(
-    sat_api->limplies(is_not_zero, lt_or_le(false, rem, op1, false)));
-
-  // "op1 != 0 => res <= op0"
-
-  sat_api->assert_lit(
-    sat_api->limplies(is_not_zero, lt_or_le(true, rem, op0, false)));
-}
-
-void bitblast_convt::unsigned_multiplier_no_overflow(
-  const bvt &op0,
-  const bvt &op1,
-  bvt &res)
-{
-  assert(op0.size() == op1.size());
-  bvt _op0 = op0, _op1 = op1;
-
-  if(is_constant(_op1))
-    std::swap(_op0, _op1);
-
-  res.resize(op0.size());
 
-  for(unsigned int i = 0; i < res.size(); i++)
-    res[i] = const_literal(false);
+  // The partial remainder is below twice the divisor after each shift, so
+  // one extra bit is enough.
+  bvt neg_divisor = op1;
+  neg_divisor.push_back(const_literal(false));
+  invert(neg_divisor);
 
-  for(unsigned int sum = 0; sum < op0.size(); sum++)
-  {
-    if(op0[sum] != const_literal(false))
-    {
-      bvt tmpop;
-
-      tmpop.reserve(res.size());
-
-      for(unsigned int idx = 0; idx < sum; idx++)
-        tmpop.push_back(const_literal(false));
-
-      for(unsigned int idx = sum; idx < res.size(); idx++)
-        tmpop.push_back(sat_api->land(op1[idx - sum], op0[sum]));
-
-      bvt copy = res;
-      adder_no_overflow(copy, tmpop, res);
-
-      for(unsigned int idx = op1.size() - sum; idx < op1.size(); idx++)
-      {
-        literalt tmp = sat_api->land(op1[idx], op0[sum]);
-        tmp.invert();
-        sat_api->assert_lit(tmp);
-      }
-    }
-  }
-}
-
-void bitblast_convt::adder_no_overflow(
-  const bvt &op0,
-  const bvt &op1,
-  bvt &res,
-  bool subtract,
-  bool is_signed)
-{
-  assert(op0.size() == op1.size());
-  unsigned int width = op0.size();
-  bvt tmp_op1 = op1;
-  if(subtract)
-    negate(op1, tmp_op1);
-
-  if(is_signed)
+  bvt r(width + 1, const_literal(false));
+  for(unsigned int i = width; i-- > 0;)
   {
-    literalt old_sign = op0[width - 1];
-    literalt sign_the_same =
-      sat_api->lequal(op0[width - 1], tmp_op1[width - 1]);
-    literalt carry;
-    full_adder(op0, tmp_op1, res, const_literal(subtract), carry);
-    literalt stop_overflow =
-      sat_api->land(sign_the_same, sat_api->lxor(op0[width - 1], old_sign));
-    stop_overflow.invert();
-    sat_api->assert_lit(stop_overflow);
-  }
-  else
-  {
-    literalt carry_out;
-    full_adder(op0, tmp_op1, res, const_literal(subtract), carry_out);
-    if(subtract)
-    {
-      sat_api->assert_lit(carry_out);
-    }
-    else
-    {
-      carry_out.invert();
-      sat_api->assert_lit(carry_out);
-    }
-  }
-
-  return;
-}
+    r.pop_back();
+    r.insert(r.begin(), op0[i]);
 
-void bitblast_convt::adder_no_overflow(const bvt &op0, const bvt &op1, bvt &res)
-{
-  res.resize(op0.size());
+    bvt diff;
+    literalt no_borrow;
+    full_adder(r, neg_divisor, diff, const_literal(true), no_borrow);
 
-  literalt carry_out = const_literal(false);
-  for(unsigned int i = 0; i < op0.size(); i++)
-  {
-    literalt op0_bit = op0[i];
-
-    res[i] = sat_api->lxor(sat_api->lxor(op0_bit, op1[i]), carry_out);
-    carry_out = carry(op0_bit, op1[i], carry_out);
+    res[i] = no_borrow;
+    for(unsigned int j = 0; j < r.size(); j++)
+      r[j] = sat_api->lselect(no_borrow, diff[j], r[j]);
   }
 
-  carry_out.invert();
-  sat_api->assert_lit(carry_out);
-}
-
-bool bitblast_convt::is_constant(const bvt &bv)
-{
-  for(unsigned int i = 0; i < bv.size(); i++)
-    if(!bv[i].is_constant())
-      return false;
-  return true;
+  r.pop_back();
+  rem.swap(r);
 }
 
 literalt bitblast_convt::carry_out(const bvt &a, const bvt &b, literalt c)
@@ -888,8 +652,7 @@ literalt bitblast_convt::equal(const bvt &op0, const bvt &op1)
   for(unsigned int i = 0; i < op0.size(); i++)
     tmp.push_back(sat_api->lequal(op0[i], op1[i]));
 
-  literalt res = land(tmp);
-  return res;
+  return land(tmp);
 }
 
 literalt bitblast_convt::lt_or_le(
@@ -898,23 +661,23 @@ literalt bitblast_convt::lt_or_le(
   const bvt &bv1,
   bool is_signed)
 {
-  assert(bv0.size() == bv1.size());
-  literalt top0 = bv0[bv0.size() - 1], top1 = bv1[bv1.size() - 1];
+  assert(bv0.size() == bv1.size() && !bv0.empty());
+
+  // a <= b is !(b < a), which is cheaper than or'ing in an equality
+  if(or_equal)
+    return sat_api->lnot(lt_or_le(false, bv1, bv0, is_signed));
 
+  literalt top0 = bv0.back(), top1 = bv1.back();
+
+  // bv0 - bv1 carries out iff bv0 >= bv1, unsigned
   bvt inv_op1 = bv1;
   invert(inv_op1);
   literalt carry = carry_out(bv0, inv_op1, const_literal(true));
 
-  literalt result;
   if(is_signed)
-    result = sat_api->lxor(sat_api->lequal(top0, top1), carry);
-  else
-    result = sat_api->lnot(carry);
+    return sat_api->lxor(sat_api->lequal(top0, top1), carry);
 
-  if(or_equal)
-    result = sat_api->lor(result, equal(bv0, bv1));
-
-  return result;
+  return sat_api->lnot(carry);
 }
 
 void bitblast_convt::invert(bvt &bv)
@@ -929,22 +692,23 @@ void bitblast_convt::barrel_shift(
   const bvt &dist,
   bvt &out)
 {
-  unsigned long d = 1;
   out = op;
 
-  // FIXME: clip this on oversized shifts?
   for(unsigned int pos = 0; pos < dist.size(); pos++)
   {
-    if(dist[pos] != const_literal(false))
-    {
-      bvt tmp;
-      shift(out, s, d, tmp);
+    if(dist[pos] == const_literal(false))
+      continue;
 
-      for(unsigned int i = 0; i < op.size(); i++)
-        out[i] = sat_api->lselect(dist[pos], tmp[i], out[i]);
-    }
+    // Any distance of the width or more shifts every bit out
+    unsigned long d = op.size();
+    if(pos < sizeof(unsigned long) * 8 - 1 && (1UL << pos) < d)
+      d = 1UL << pos;
+
+    bvt tmp;
+    shift(out, s, d, tmp);
 
-    d <<= 1;
+    for(unsigned int i = 0; i < op.size(); i++)
+      out[i] = sat_api->lselect(dist[pos], tmp[i], out[i]);
   }
 }
 
@@ -975,8 +739,6 @@ void bitblast_convt::shift(
 
     out[i] = l;
   }
-
-  return;
 }
 
 void bitblast_convt::bvand(const bvt &bv0, const bvt &bv1, bvt &output)
@@ -987,8 +749,6 @@ void bitblast_convt::bvand(const bvt &bv0, const bvt &bv1, bvt &output)
 
   for(unsigned int i = 0; i < bv0.size(); i++)
     output.push_back(sat_api->land(bv0[i], bv1[i]));
-
-  return;
 }
 
 void bitblast_convt::bvor(const bvt &bv0, const bvt &bv1, bvt &output)
@@ -999,19 +759,16 @@ void bitblast_convt::bvor(const bvt &bv0, const bvt &bv1, bvt &output)
 
   for(unsigned int i = 0; i < bv0.size(); i++)
     output.push_back(sat_api->lor(bv0[i], bv1[i]));
-
-  return;
 }
 
 void bitblast_convt::bvxor(const bvt &bv0, const bvt &bv1, bvt &output)
 {
+  assert(bv0.size() == bv1.size());
   output.clear();
   output.reserve(bv0.size());
 
   for(unsigned int i = 0; i < bv0.size(); i++)
     output.push_back(sat_api->lxor(bv0[i], bv1[i]));
-
-  return;
 }
 
 void bitblast_convt::bvnot(const bvt &bv0, bvt &output)
@@ -1021,8 +778,6 @@ void bitblast_convt::bvnot(const bvt &bv0, bvt &output)
 
   for(unsigned int i = 0; i < bv0.size(); i++)
     output.push_back(sat_api->lnot(bv0[i]));
-
-  return;
 }
 
 literalt bitblast_convt::land(const bvt &bv)
@@ -1034,34 +789,35 @@ literalt bitblast_convt::land(const bvt &bv)
   else if(bv.size() == 2)
     return sat_api->land(bv[0], bv[1]);
 
-  unsigned int trues = 0;
+  // Constants either decide the result or drop out of it
+  bvt lits;
+  lits.reserve(bv.size());
   for(unsigned int i = 0; i < bv.size(); i++)
   {
     if(bv[i] == const_literal(false))
       return const_literal(false);
-    else if(bv[i] == const_literal(true))
-      trues++;
+    else if(bv[i] != const_literal(true))
+      lits.push_back(bv[i]);
   }
 
-  if(trues == bv.size())
-    return const_literal(true);
-
   bvt new_bv;
+  eliminate_duplicates(lits, new_bv);
 
-  eliminate_duplicates(bv, new_bv);
+  if(new_bv.size() <= 2)
+    return land(new_bv);
 
   literalt lit = sat_api->new_variable();
 
   for(unsigned int i = 0; i < new_bv.size(); i++)
   {
-    bvt lits;
-    lits.reserve(2);
-    lits.push_back(pos(new_bv[i]));
-    lits.push_back(neg(lit));
-    sat_api->lcnf(lits);
+    bvt clause;
+    clause.reserve(2);
+    clause.push_back(pos(new_bv[i]));
+    clause.push_back(neg(lit));
+    sat_api->lcnf(clause);
   }
 
-  bvt lits;
+  lits.clear();
   lits.reserve(new_bv.size() + 1);
 
   for(unsigned int i = 0; i < new_bv.size(); i++)
@@ -1082,24 +838,34 @@ literalt bitblast_convt::lor(const bvt &bv)
   else if(bv.size() == 2)
     return sat_api->lor(bv[0], bv[1]);
 
+  // Constants either decide the result or drop out of it
+  bvt lits;
+  lits.reserve(bv.size());
   for(unsigned int i = 0; i < bv.size(); i++)
+  {
     if(bv[i] == const_literal(true))
       return const_literal(true);
+    else if(bv[i] != const_literal(false))
+      lits.push_back(bv[i]);
+  }
 
   bvt new_bv;
-  eliminate_duplicates(bv, new_bv);
+  eliminate_duplicates(lits, new_bv);
+
+  if(new_bv.size() <= 2)
+    return lor(new_bv);
 
   literalt literal = sat_api->new_variable();
   for(unsigned int i = 0; i < new_bv.size(); i++)
   {
-    bvt lits;
-    lits.reserve(2);
-    lits.push_back(neg(new_bv[i]));
-    lits.push_back(pos(literal));
-    sat_api->lcnf(lits);
+    bvt clause;
+    clause.reserve(2);
+    clause.push_back(neg(new_bv[i]));
+    clause.push_back(pos(literal));
+    sat_api->lcnf(clause);
   }
 
-  bvt lits;
+  lits.clear();
   lits.reserve(new_bv.size() + 1);
 
   for(unsigned int i = 0; i < new_bv.size(); i++)
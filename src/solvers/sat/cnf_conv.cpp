@@ -1,4 +1,4 @@
-#include <cnf_conv.h>
+#include <solvers/sat/cnf_conv.h>
 
 cnf_convt::cnf_convt(cnf_iface *_cnf_api) : sat_iface(), cnf_api(_cnf_api)
 {
@@ -23,8 +23,6 @@ literalt cnf_convt::lselect(literalt a, literalt b, literalt c)
   if(b == c)
     return b;
 
-  bvt bv;
-  bv.reserve(2);
   literalt one = land(a, b);
   literalt two = land(lnot(a), c);
   return lor(one, two);
@@ -1,9 +1,8 @@
 #ifndef _ESBMC_SOLVERS_SMT_CNF_CONV_H_
 #define _ESBMC_SOLVERS_SMT_CNF_CONV_H_
 
-#include <solvers/smt/smt_conv.h>
-#include <bitblast_conv.h>
-#include <cnf_iface.h>
+#include <solvers/sat/cnf_iface.h>
+#include <solvers/sat/sat_iface.h>
 
 class cnf_convt : public sat_iface
 {
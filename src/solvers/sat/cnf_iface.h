@@ -1,6 +1,8 @@
 #ifndef _ESBMC_SOLVERS_SAT_CNF_IFACE_H_
 #define _ESBMC_SOLVERS_SAT_CNF_IFACE_H_
 
+#include <solvers/prop/literal.h>
+
 class cnf_iface
 {
 public:
@@ -1,6 +1,10 @@
 #ifndef _ESBMC_SOLVERS_SAT_SAT_IFACE_H_
 #define _ESBMC_SOLVERS_SAT_SAT_IFACE_H_
 
+#include <solvers/prop/literal.h>
+#include <solvers/smt/smt_conv.h>
+#include <util/threeval.h>
+
 // An interface for defining a SAT interface within ESBMC, as used by the
 // SAT bitblaster. I anticipate that nothing else actually needs to use this
 // interface, except perhaps sat solvers that have non-cnf inputs.
@@ -20,6 +24,10 @@ public:
   virtual void assert_lit(const literalt &a) = 0;
   virtual tvt l_get(const literalt &a) = 0;
   virtual literalt new_variable() = 0;
+
+  /** Solve the clauses added so far, with every literal in assumptions
+   *  forced to true for this call only. */
+  virtual smt_convt::resultt solve(const bvt &assumptions) = 0;
 };
 
 #endif /* _ESBMC_SOLVERS_SAT_SAT_IFACE_H_ */
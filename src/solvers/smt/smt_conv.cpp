@@ -61,11 +61,17 @@ smt_convt::get_member_name_field(const type2tc &t, const expr2tc &name) const
 }
 
 smt_convt::smt_convt(bool intmode, const namespacet &_ns)
-  : ctx_level(0), boolean_sort(nullptr), int_encoding(intmode), ns(_ns)
+  : cache_hits(0),
+    ctx_level(0),
+    model_batch_depth(0),
+    boolean_sort(nullptr),
+    int_encoding(intmode),
+    ns(_ns)
 {
   tuple_api = nullptr;
   array_api = nullptr;
   fp_api = nullptr;
+  ordered_addr_space = config.options.get_bool_option("ordered-address-space");
 
   std::vector<type2tc> members;
   std::vector<irep_idt> names;
@@ -100,6 +106,7 @@ smt_convt::smt_convt(bool intmode, const namespacet &_ns)
     type2tc(new array_type2t(addr_space_type, expr2tc(), true));
 
   addr_space_data.emplace_back();
+  addr_space_tail.push_back(0);
 
   machine_int = type2tc(new signedbv_type2t(config.ansi_c.int_width));
   machine_uint = type2tc(new unsignedbv_type2t(config.ansi_c.int_width));
@@ -175,6 +182,7 @@ void smt_convt::push_ctx()
   array_api->push_array_ctx();
 
   addr_space_data.push_back(addr_space_data.back());
+  addr_space_tail.push_back(addr_space_tail.back());
   addr_space_sym_num.push_back(addr_space_sym_num.back());
   pointer_logic.push_back(pointer_logic.back());
   renumber_map.push_back(renumber_map.back());
@@ -193,6 +201,7 @@ void smt_convt::pop_ctx()
   pointer_logic.pop_back();
   addr_space_sym_num.pop_back();
   addr_space_data.pop_back();
+  addr_space_tail.pop_back();
   renumber_map.pop_back();
 
   ctx_level--;
@@ -251,7 +260,86 @@ smt_astt smt_convt::convert_ast(const expr2tc &expr)
 {
   smt_cachet::const_iterator cache_result = smt_cache.find(expr);
   if(cache_result != smt_cache.end())
+  {
+    ++cache_hits;
     return (cache_result->ast);
+  }
+
+  // Deep expressions (long chains of with/if from unwound loops) would
+  // overflow the C stack if every operand was converted by recursing. So
+  // walk the expression with an explicit stack and convert it bottom-up:
+  // every expression is only converted once the operands its conversion
+  // starts from are in the cache, and convert_ast_node finds them there.
+  typedef std::pair<const expr2tc *, bool> framet; // expr, operands pushed
+  std::vector<framet> stack;
+  stack.emplace_back(&expr, false);
+
+  auto push = [this, &stack](const expr2tc &e) {
+    if(is_nil_expr(e))
+      return;
+
+    if(smt_cache.find(e) == smt_cache.end())
+      stack.emplace_back(&e, false);
+    else
+      ++cache_hits;
+  };
+
+  smt_astt a = nullptr;
+  while(!stack.empty())
+  {
+    const expr2tc &e = *stack.back().first;
+
+    if(stack.back().second)
+    {
+      stack.pop_back();
+      cache_result = smt_cache.find(e);
+      a = (cache_result != smt_cache.end()) ? cache_result->ast
+                                            : convert_ast_node(e);
+      continue;
+    }
+
+    // Shared subexpressions may have been converted since being pushed
+    if(stack.size() > 1 && smt_cache.find(e) != smt_cache.end())
+    {
+      stack.pop_back();
+      continue;
+    }
+
+    stack.back().second = true;
+    switch(e->expr_id)
+    {
+    case expr2t::with_id:
+      // Struct and array updates both start from the source value
+      push(to_with2t(e).source_value);
+      break;
+
+    case expr2t::index_id:
+      // Nested selects are decomposed, anything else selects from the source
+      if(!is_index2t(to_index2t(e).source_value))
+        push(to_index2t(e).source_value);
+      break;
+
+    case expr2t::constant_array_id:
+    case expr2t::constant_array_of_id:
+    case expr2t::address_of_id:
+    case expr2t::ieee_add_id:
+    case expr2t::ieee_sub_id:
+    case expr2t::ieee_mul_id:
+    case expr2t::ieee_div_id:
+    case expr2t::ieee_fma_id:
+    case expr2t::ieee_sqrt_id:
+      break; // Converted in their own way
+
+    default:
+      e->foreach_operand(push);
+    }
+  }
+
+  return a;
+}
+
+smt_astt smt_convt::convert_ast_node(const expr2tc &expr)
+{
   std::vector<smt_astt> args;
   args.reserve(expr->get_num_sub_exprs());
 
@@ -272,7 +360,8 @@ smt_astt smt_convt::convert_ast(const expr2tc &expr)
 
   default:
   {
-    // Convert /all the arguments/. Via magical delegates.
+    // Convert /all the arguments/. Via magical delegates. convert_ast has
+    // put them in the cache already.
     unsigned int i = 0;
     expr->foreach_operand(
       [this, &args, &i](const expr2tc &e) { args[i++] = convert_ast(e); });
@@ -2018,13 +2107,136 @@ void smt_convt::pre_solve()
 
 expr2tc smt_convt::get(const expr2tc &expr)
 {
-  if(is_constant_number(expr))
-    return expr;
+  if(model_batch_depth == 0)
+    return get_uncached(expr);
 
-  if(is_symbol2t(expr) && to_symbol2t(expr).thename == "NULL")
-    return expr;
+  auto it = model_expr_cache.find(expr);
+  if(it != model_expr_cache.end())
+    return it->second;
+
+  expr2tc res = get_uncached(expr);
+  model_expr_cache.emplace(expr, res);
+  return res;
+}
+
+expr2tc smt_convt::get_uncached(const expr2tc &expr)
+{
+  // Fetching the value of a deep expression means rebuilding it bottom-up.
+  // Do that with an explicit stack of partially rebuilt expressions rather
+  // than by recursing on operands.
+  struct framet
+  {
+    expr2tc res;
+    std::vector<expr2tc *> ops;
+    size_t next;
+  };
+  std::vector<framet> stack;
+
+  auto push = [&stack](expr2tc &&res) {
+    stack.emplace_back();
+    framet &f = stack.back();
+    f.res = std::move(res);
+    f.next = 0;
+    f.res->Foreach_operand([&f](expr2tc &e) { f.ops.push_back(&e); });
+  };
+
+  expr2tc res;
+  if(get_shallow(expr, res))
+    return res;
+  push(std::move(res));
+
+  for(;;)
+  {
+    framet &f = stack.back();
+    if(f.next < f.ops.size())
+    {
+      expr2tc &op = *f.ops[f.next];
+      expr2tc tmp;
+      if(get_shallow(op, tmp))
+      {
+        op = tmp;
+        f.next++;
+      }
+      else
+        push(std::move(tmp)); // f is dangling from here on
+      continue;
+    }
 
-  expr2tc res = expr;
+    // All operands are values now, simplify and hand the result up
+    simplify(f.res);
+    expr2tc done = std::move(f.res);
+    stack.pop_back();
+    if(stack.empty())
+      return done;
+
+    framet &parent = stack.back();
+    *parent.ops[parent.next++] = done;
+  }
+}
+
+bool smt_convt::get_shallow(const expr2tc &expr, expr2tc &res)
+{
+  res = expr;
+
+  // Value-preserving tail cases replace res and go around again
+  for(;;)
+  {
+    if(is_constant_number(res))
+      return true;
+
+    if(is_symbol2t(res) && to_symbol2t(res).thename == "NULL")
+      return true;
+
+    if(is_with2t(res))
+    {
+      // This will be converted
+      with2t with = to_with2t(res);
+      expr2tc update_val = with.update_value;
+
+      if(
+        is_array_type(with.type) &&
+        is_array_type(to_array_type(with.type).subtype))
+      {
+        decompose_store_chain(res, update_val);
+      }
+
+      res = update_val;
+      continue;
+    }
+
+    if(is_if2t(res))
+    {
+      // Special case for ternary if, for cases when we are updating the
+      // member of a struct (SSA indexes are omitted):
+      //
+      // d2 == (!(SAME-OBJECT(pd, &d1)) ? (d2 WITH [a:=0]) : d2)
+      //
+      // i.e., update the field 'a' of 'd2', if a given condition holds,
+      // otherwise, do nothing.
+
+      // The problem of relying on the simplification code is because the type
+      // of the ternary is a struct, and if the condition holds, we extract the
+      // update value from the WITH expression, in this case '0', and cast it
+      // to struct. So now we try to query the solver for which side is used
+      // and we return it, without casting to the ternary if type.
+      const if2t &i = to_if2t(res);
+
+      expr2tc c = get(i.cond);
+      if(is_true(c))
+      {
+        res = expr2tc(i.true_value);
+        continue;
+      }
+
+      if(is_false(c))
+      {
+        res = expr2tc(i.false_value);
+        continue;
+      }
+    }
+
+    break;
+  }
 
   // Special cases:
   switch(res->expr_id)
@@ -2040,7 +2252,7 @@ expr2tc smt_convt::get(const expr2tc &expr)
     expr2tc newidx;
     if(is_index2t(index.source_value))
     {
-      newidx = decompose_select_chain(expr, src_value);
+      newidx = decompose_select_chain(res, src_value);
     }
     else
     {
@@ -2050,7 +2262,10 @@ expr2tc smt_convt::get(const expr2tc &expr)
     // if the source value is a constant, there's no need to
     // call the array api
     if(is_constant_number(src_value))
-      return src_value;
+    {
+      res = src_value;
+      return true;
+    }
 
     // Convert the idx, it must be an integer
     expr2tc idx = get(newidx);
@@ -2070,59 +2285,19 @@ expr2tc smt_convt::get(const expr2tc &expr)
     break;
   }
 
-  case expr2t::with_id:
-  {
-    // This will be converted
-    with2t with = to_with2t(res);
-    expr2tc update_val = with.update_value;
-
-    if(
-      is_array_type(with.type) &&
-      is_array_type(to_array_type(with.type).subtype))
-    {
-      decompose_store_chain(expr, update_val);
-    }
-
-    return get(update_val);
-  }
-
   case expr2t::address_of_id:
-    return res;
+    return true;
 
   case expr2t::pointer_offset_id:
   case expr2t::same_object_id:
   case expr2t::symbol_id:
-    return get_by_type(res);
-
-  case expr2t::if_id:
-  {
-    // Special case for ternary if, for cases when we are updating the member
-    // of a struct (SSA indexes are omitted):
-    //
-    // d2 == (!(SAME-OBJECT(pd, &d1)) ? (d2 WITH [a:=0]) : d2)
-    //
-    // i.e., update the field 'a' of 'd2', if a given condition holds,
-    // otherwise, do nothing.
-
-    // The problem of relying on the simplification code is because the type of
-    // the ternary is a struct, and if the condition holds, we extract the
-    // update value from the WITH expression, in this case '0', and cast it to
-    // struct. So now we try to query the solver for which side is used and
-    // we return it, without casting to the ternary if type.
-    if2t i = to_if2t(res);
-
-    expr2tc c = get(i.cond);
-    if(is_true(c))
-      return get(i.true_value);
-
-    if(is_false(c))
-      return get(i.false_value);
-  }
+    res = get_by_type(res);
+    return true;
 
   default:;
   }
 
-  if(is_array_type(expr->type))
+  if(is_array_type(res->type))
   {
     expr2tc &arr_size = to_array_type(res->type).array_size;
     if(!is_nil_expr(arr_size) && is_symbol2t(arr_size))
@@ -2138,15 +2313,8 @@ expr2tc smt_convt::get(const expr2tc &expr)
     });
   }
 
-  // Recurse on operands
-  res->Foreach_operand([this](expr2tc &e) {
-    expr2tc new_e = get(e);
-    e = new_e;
-  });
-
-  // And simplify
-  simplify(res);
-  return res;
+  // The operands still have to be fetched, and the result simplified
+  return false;
 }
 
 expr2tc smt_convt::get_by_ast(const type2tc &type, smt_astt a)
@@ -2545,7 +2713,16 @@ void smt_convt::print_model()
 
 tvt smt_convt::l_get(smt_astt a)
 {
-  return get_bool(a) ? tvt(true) : tvt(false);
+  if(model_batch_depth == 0)
+    return get_bool(a) ? tvt(true) : tvt(false);
+
+  auto it = model_bool_cache.find(a);
+  if(it != model_bool_cache.end())
+    return it->second;
+
+  tvt res = get_bool(a) ? tvt(true) : tvt(false);
+  model_bool_cache.emplace(a, res);
+  return res;
 }
 
 expr2tc smt_convt::build_bv(const type2tc &type, BigInt value)
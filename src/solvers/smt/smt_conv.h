@@ -8,6 +8,7 @@
 #include <cstdint>
 #include <solvers/prop/literal.h>
 #include <solvers/prop/pointer_logic.h>
+#include <unordered_map>
 #include <util/irep2_utils.h>
 #include <util/message.h>
 #include <util/namespace.h>
@@ -175,6 +176,12 @@ public:
   virtual void push_ctx();
   /** Pop one context on the SMT assertion stack. */
   virtual void pop_ctx();
+  /** Whether push_ctx and pop_ctx also push and pop the assertions held by
+   *  the underlying solver, and not just this converter's own caches. */
+  virtual bool solver_push_pop() const
+  {
+    return false;
+  }
 
   /** Main interface to SMT conversion.
    *  Takes one expression, and converts it into the underlying SMT solver,
@@ -185,6 +192,10 @@ public:
    *  @return The resulting handle to the SMT value. */
   smt_astt convert_ast(const expr2tc &expr);
 
+  /** Convert a single expression whose operands have already been converted
+   *  and cached, as arranged by convert_ast. */
+  smt_astt convert_ast_node(const expr2tc &expr);
+
   /** Interface to specifig SMT conversion.
    *  Takes one expression, and converts it into the underlying SMT solver,
    *  depending on the type of the expression.
@@ -272,11 +283,35 @@ public:
    *          reason. */
   virtual expr2tc get(const expr2tc &expr);
 
+  /** get, bypassing the cache of an open model_batcht. */
+  expr2tc get_uncached(const expr2tc &expr);
+
+  /** One step of get: resolve expr as far as possible without looking at its
+   *  operands. Returns true if res is the final value, false if res still
+   *  needs its operands fetched and then simplifying. */
+  bool get_shallow(const expr2tc &expr, expr2tc &res);
+
   /** Solver name fetcher. Returns a string naming the solver being used, and
    *  potentially it's version, if available.
    *  @return The name of the solver this smt_convt uses. */
   virtual const std::string solver_text() = 0;
 
+  /** Solver statistics about the last call to dec_solve, as name / value
+   *  pairs, for --stats-json. Solvers that report none return nothing. */
+  virtual std::vector<std::pair<std::string, std::string>> solver_statistics()
+  {
+    return {};
+  }
+
+  /** Number of smt_asts alive in the converter */
+  size_t live_ast_count() const
+  {
+    return live_asts.size();
+  }
+
+  /** Number of times convert_ast found an expression already converted */
+  unsigned long long cache_hits;
+
   /** Fetch the value of a boolean sorted smt_ast. (The 'l' is for literal, and
    *  is historic). Returns a three valued result, of true, false, or
    *  unassigned.
@@ -284,6 +319,46 @@ public:
    *  @return A three-valued return val, of the assignment to a. */
   virtual tvt l_get(smt_astt a);
 
+  /** Scope in which many values are read back from one model, e.g. while a
+   *  counterexample is built. The same guards, indexes and expressions are
+   *  queried over and over then, so l_get and get remember their answers by
+   *  ast / expression until the outermost batch closes, and solvers may keep
+   *  hold of their model object instead of fetching it per value. Nothing
+   *  may be asserted, solved, pushed or popped while a batch is open. */
+  class model_batcht
+  {
+  public:
+    explicit model_batcht(smt_convt &_conv) : conv(_conv)
+    {
+      if(conv.model_batch_depth++ == 0)
+        conv.begin_model_batch();
+    }
+
+    ~model_batcht()
+    {
+      if(--conv.model_batch_depth == 0)
+      {
+        conv.end_model_batch();
+        conv.model_bool_cache.clear();
+        conv.model_expr_cache.clear();
+      }
+    }
+
+    model_batcht(const model_batcht &) = delete;
+    model_batcht &operator=(const model_batcht &) = delete;
+
+  protected:
+    smt_convt &conv;
+  };
+
+  /** Hooks for solvers that can pin the current model for a batch. */
+  virtual void begin_model_batch()
+  {
+  }
+  virtual void end_model_batch()
+  {
+  }
+
   /** @} */
 
   /** @{
@@ -653,7 +728,9 @@ public:
   std::string get_cur_addrspace_ident();
   /** Create and assert address space constraints on the given object ID
    *  number. Essentially, this asserts that all the objects to date don't
-   *  overlap with /this/ one. */
+   *  overlap with /this/ one. With ordered_addr_space this is a single
+   *  constraint placing the object after the last one allocated, otherwise
+   *  one constraint per object allocated so far. */
   void finalize_pointer_chain(unsigned int obj_num);
 
   /** Typecast data to bools */
@@ -783,6 +860,11 @@ public:
   /** Number of un-popped context pushes encountered so far. */
   unsigned int ctx_level;
 
+  /** Number of open model_batcht scopes, and the values they cached. */
+  unsigned int model_batch_depth;
+  std::unordered_map<smt_astt, tvt> model_bool_cache;
+  std::unordered_map<expr2tc, expr2tc, irep2_hash> model_expr_cache;
+
   /** A cache mapping expressions to converted SMT ASTs. */
   smt_cachet smt_cache;
   /** A cache of converted type2tc's to smt sorts */
@@ -846,6 +928,13 @@ public:
    *  the nubmer of bytes allocated. In a list to support pushing and
    *  popping. */
   std::list<std::map<unsigned, unsigned>> addr_space_data;
+  /** Lay objects out in allocation order (--ordered-address-space). Each
+   *  object then only needs to start after the previous one ends, which
+   *  keeps the disjointness constraints linear in the number of objects,
+   *  at the price of fixing the relative order of unrelated objects. */
+  bool ordered_addr_space;
+  /** Last object placed in the ordered address space, per context level. */
+  std::list<unsigned int> addr_space_tail;
 
   // XXX - push-pop will break here.
   typedef std::map<std::string, smt_astt> renumber_mapt;
@@ -423,6 +423,21 @@ void smt_convt::finalize_pointer_chain(unsigned int objnum)
   symbol2tc start_i(inttype, start1.str());
   symbol2tc end_i(inttype, end1.str());
 
+  if(ordered_addr_space)
+  {
+    // Start after the most recently placed object; every object before it
+    // already lies below that one, and start <= end holds for all of them.
+    // Object 1 is designed to overlap and takes no part in the chain.
+    unsigned int prev = addr_space_tail.back();
+    addr_space_tail.back() = objnum;
+
+    std::stringstream endp;
+    endp << "__ESBMC_ptr_obj_end_" << prev;
+    symbol2tc end_prev(inttype, endp.str());
+    assert_expr(greaterthan2tc(start_i, end_prev));
+    return;
+  }
+
   for(unsigned int j = 0; j < objnum; j++)
   {
     // Obj1 is designed to overlap
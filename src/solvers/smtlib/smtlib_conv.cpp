@@ -1,11 +1,15 @@
 // "Standards" workaround
 #define __STDC_FORMAT_MACROS
 
+#include <algorithm>
+#include <cctype>
 #include <cinttypes>
+#include <csignal>
 #include <smtlib_conv.h>
 #include <smtlib.hpp>
 #include <smtlib_tok.hpp>
 #include <sstream>
+#include <sys/wait.h>
 #include <unistd.h>
 
 const std::string smtlib_convt::smt_func_name_table[expr2t::end_expr_id] = {
@@ -110,9 +114,14 @@ smt_convt *create_new_smtlib_solver(
 }
 
 smtlib_convt::smtlib_convt(bool int_encoding, const namespacet &_ns)
-  : smt_convt(int_encoding, _ns), array_iface(false, false), fp_convt(this)
+  : smt_convt(int_encoding, _ns),
+    array_iface(false, false),
+    fp_convt(this),
+    ctx_guard_count(0),
+    model_fetched(false)
 {
   temp_sym_count.push_back(1);
+  assume_contexts = config.options.get_bool_option("smtlib-assume-contexts");
   std::string cmd;
 
   std::string logic = (int_encoding) ? "QF_AUFLIRA" : "QF_AUFBV";
@@ -135,6 +144,7 @@ smtlib_convt::smtlib_convt(bool int_encoding, const namespacet &_ns)
       std::cerr << "Failed to open \"" << cmd << "\"" << std::endl;
       abort();
     }
+    setvbuf(out_stream, nullptr, _IOFBF, 1 << 16);
 
     in_stream = nullptr;
     solver_name = "Text output";
@@ -173,6 +183,20 @@ smtlib_convt::smtlib_convt(bool int_encoding, const namespacet &_ns)
     abort();
   }
 
+  // The program may come with its own arguments, e.g. "z3 -in"
+  std::vector<std::string> args;
+  {
+    std::istringstream ss(cmd);
+    std::string arg;
+    while(ss >> arg)
+      args.push_back(arg);
+  }
+
+  std::vector<char *> argv;
+  for(std::string &arg : args)
+    argv.push_back(&arg[0]);
+  argv.push_back(nullptr);
+
   solver_proc_pid = fork();
   if(solver_proc_pid == 0)
   {
@@ -186,7 +210,7 @@ smtlib_convt::smtlib_convt(bool int_encoding, const namespacet &_ns)
     close(inpipe[1]);
 
     // Voila
-    execlp(cmd.c_str(), cmd.c_str(), NULL);
+    execvp(argv[0], argv.data());
     std::cerr << "Exec of smtlib solver failed" << std::endl;
     abort();
   }
@@ -196,6 +220,10 @@ smtlib_convt::smtlib_convt(bool int_encoding, const namespacet &_ns)
     close(inpipe[1]);
     out_stream = fdopen(outpipe[1], "w");
     in_stream = fdopen(inpipe[0], "r");
+
+    // Commands are only flushed when we wait for an answer, so the solver
+    // takes a formula in a few large writes rather than one per assert.
+    setvbuf(out_stream, nullptr, _IOFBF, 1 << 16);
   }
 
   // Execution continues as the parent ESBMC process. Child dying will
@@ -264,6 +292,21 @@ smtlib_convt::smtlib_convt(bool int_encoding, const namespacet &_ns)
 smtlib_convt::~smtlib_convt()
 {
   delete_all_asts();
+
+  if(in_stream != nullptr)
+  {
+    // Let the solver process go, and reap it. It may have died already, and
+    // writing to it then must not take ESBMC down with a SIGPIPE.
+    void (*old_handler)(int) = signal(SIGPIPE, SIG_IGN);
+    if(!ferror(out_stream))
+      fprintf(out_stream, "(exit)\n");
+    fclose(out_stream);
+    fclose(in_stream);
+    waitpid(solver_proc_pid, nullptr, 0);
+    signal(SIGPIPE, old_handler);
+  }
+  else if(out_stream != nullptr)
+    fclose(out_stream);
 }
 
 std::string smtlib_convt::sort_to_string(const smt_sort *s) const
@@ -414,7 +457,17 @@ smt_convt::resultt smtlib_convt::dec_solve()
   // Emit constraints
   // check-sat
 
-  fprintf(out_stream, "(check-sat)\n");
+  if(ctx_guards.empty())
+  {
+    fprintf(out_stream, "(check-sat)\n");
+  }
+  else
+  {
+    std::string guards;
+    for(const std::string &g : ctx_guards)
+      guards += " " + g;
+    fprintf(out_stream, "(check-sat-assuming (%s))\n", guards.c_str() + 1);
+  }
 
   // Flush out command, starting model check
   fflush(out_stream);
@@ -450,74 +503,266 @@ smt_convt::resultt smtlib_convt::dec_solve()
   }
 }
 
-BigInt smtlib_convt::get_bv(smt_astt a)
+// Atoms of get-value answers, tokenised as the smtlib lexer would have
+static unsigned int classify_atom(const std::string &atom)
 {
-  // This should always be a symbol.
-  const smtlib_smt_ast *sa = static_cast<const smtlib_smt_ast *>(a);
-  assert(sa->kind == SMT_FUNC_SYMBOL && "Non-symbol in smtlib expr get_bv()");
-  std::string name = sa->symname;
+  if(atom.compare(0, 2, "#b") == 0)
+    return TOK_BINNUM;
+  if(atom.compare(0, 2, "#x") == 0)
+    return TOK_HEXNUM;
+  if(atom == "true")
+    return TOK_KW_TRUE;
+  if(atom == "false")
+    return TOK_KW_FALSE;
+  if(isdigit(static_cast<unsigned char>(atom[0])))
+    return (atom.find('.') == std::string::npos) ? TOK_NUMERAL : TOK_DECIMAL;
+  if(atom[0] == ':')
+    return TOK_KEYWORD;
+  return TOK_SIMPLESYM;
+}
 
-  fprintf(out_stream, "(get-value (|%s|))\n", name.c_str());
-  fflush(out_stream);
-  smtlib_send_start_code = 1;
-  smtlibparse(TOK_START_VALUE);
+// Interpret a value as an integer: a binary, hex or decimal literal, an
+// indexed bitvector constant (_ bvN w), or a negated numeral (- N).
+static bool sexpr_to_integer(const sexpr &v, BigInt &m)
+{
+  switch(v.token)
+  {
+  case TOK_BINNUM:
+    m = string2integer(v.data.substr(2), 2);
+    return true;
+  case TOK_HEXNUM:
+    m = string2integer(v.data.substr(2), 16);
+    return true;
+  case TOK_NUMERAL:
+    m = string2integer(v.data);
+    return true;
+  case 0:
+    break;
+  default:
+    return false;
+  }
+
+  if(v.sexpr_list.empty() || v.sexpr_list.front().token != TOK_SIMPLESYM)
+    return false;
+
+  std::list<sexpr>::const_iterator it = v.sexpr_list.begin();
+  const std::string &head = (it++)->data;
+  if(
+    head == "_" && v.sexpr_list.size() == 3 && it->token == TOK_SIMPLESYM &&
+    it->data.compare(0, 2, "bv") == 0)
+  {
+    m = string2integer(it->data.substr(2));
+    return true;
+  }
+
+  if(head == "-" && v.sexpr_list.size() == 2 && sexpr_to_integer(*it, m))
+  {
+    m.negate();
+    return true;
+  }
+
+  return false;
+}
 
-  if(smtlib_output->token == TOK_KW_ERROR)
+sexpr smtlib_convt::read_sexpr()
+{
+  // Lists still open, innermost last. Deep values such as chains of array
+  // stores are built without recursing.
+  std::vector<sexpr> open;
+
+  while(true)
   {
-    std::cerr << "Error from smtlib solver when fetching literal value: \""
-              << smtlib_output->data << "\"" << std::endl;
+    int c = getc(in_stream);
+    if(c == EOF)
+    {
+      std::cerr << "smtlib solver closed its output unexpectedly" << std::endl;
+      abort();
+    }
+
+    if(isspace(c))
+      continue;
+
+    if(c == '(')
+    {
+      open.emplace_back();
+      continue;
+    }
+
+    sexpr e;
+    if(c == ')')
+    {
+      if(open.empty())
+      {
+        std::cerr << "Unbalanced response from smtlib solver" << std::endl;
+        abort();
+      }
+      e = std::move(open.back());
+      open.pop_back();
+    }
+    else if(c == '|' || c == '"')
+    {
+      // Quoted symbol or string literal; "" escapes a quote in a string.
+      int quote = c;
+      while(true)
+      {
+        c = getc(in_stream);
+        if(c == EOF)
+          break;
+        if(c == quote && quote == '"')
+        {
+          c = getc(in_stream);
+          if(c != '"')
+          {
+            ungetc(c, in_stream);
+            break;
+          }
+        }
+        else if(c == quote)
+          break;
+        e.data.push_back(c);
+      }
+      e.token = (quote == '|') ? TOK_QUOTEDSYM : TOK_STRINGLIT;
+    }
+    else
+    {
+      while(c != EOF && !isspace(c) && c != '(' && c != ')')
+      {
+        e.data.push_back(c);
+        c = getc(in_stream);
+      }
+      ungetc(c, in_stream);
+      e.token = classify_atom(e.data);
+    }
+
+    if(open.empty())
+      return e;
+    open.back().sexpr_list.push_back(std::move(e));
+  }
+}
+
+void smtlib_convt::read_values(std::size_t count, std::vector<sexpr> &values)
+{
+  sexpr response = read_sexpr();
+
+  if(
+    response.token == 0 && !response.sexpr_list.empty() &&
+    response.sexpr_list.front().token == TOK_SIMPLESYM &&
+    response.sexpr_list.front().data == "error")
+  {
+    std::cerr << "Error from smtlib solver when fetching values: \""
+              << response.sexpr_list.back().data << "\"" << std::endl;
     abort();
   }
-  else if(smtlib_output->token != 0)
+
+  if(response.token != 0 || response.sexpr_list.size() != count)
   {
     std::cerr << "Unrecognized response to get-value from smtlib solver"
               << std::endl;
+    abort();
   }
 
-  // Unpack our value from response list.
-  assert(
-    smtlib_output->sexpr_list.size() == 1 &&
-    "More than one response to "
-    "get-value from smtlib solver");
-  sexpr &response = *smtlib_output->sexpr_list.begin();
-  // Now we have a valuation pair. First is the symbol
-  assert(
-    response.sexpr_list.size() == 2 &&
-    "Expected 2 operands in "
-    "valuation_pair_list from smtlib solver");
-  std::list<sexpr>::iterator it = response.sexpr_list.begin();
-  sexpr &symname = *it++;
-  sexpr &respval = *it++;
-  if(!(symname.token == TOK_SIMPLESYM && symname.data == name))
+  // Pairs of an echo of the term and its value
+  for(sexpr &pair : response.sexpr_list)
   {
-    std::cerr << "smtlib solver returned different symbol from get-value";
-    abort();
+    if(pair.token != 0 || pair.sexpr_list.size() != 2)
+    {
+      std::cerr << "Malformed valuation pair from smtlib solver" << std::endl;
+      abort();
+    }
+    values.push_back(std::move(pair.sexpr_list.back()));
   }
+}
 
-  // Attempt to read an integer.
-  BigInt m;
-  if(respval.token == TOK_DECIMAL)
+void smtlib_convt::fetch_model()
+{
+  // Round trips through the pipe dominate reading a model value by value,
+  // so ask for a chunk of symbols at a time. The chunk bounds what either
+  // side must buffer before the other reads.
+  const std::size_t chunk = 1024;
+
+  std::vector<std::string> names;
+  for(const symbol_table_rec &rec : symbol_table)
   {
-    m = string2integer(respval.data);
+    switch(rec.sort->id)
+    {
+    case SMT_SORT_INT:
+    case SMT_SORT_REAL:
+    case SMT_SORT_BV:
+    case SMT_SORT_FIXEDBV:
+    case SMT_SORT_BOOL:
+      names.push_back(rec.ident);
+      break;
+    default:
+      break;
+    }
   }
-  else if(respval.token == TOK_NUMERAL)
+
+  std::vector<sexpr> values;
+  for(std::size_t i = 0; i < names.size(); i += chunk)
   {
-    std::cerr << "Numeral value for integer symbol from smtlib solver"
-              << std::endl;
-    abort();
+    std::size_t end = std::min(i + chunk, names.size());
+
+    fprintf(out_stream, "(get-value (");
+    for(std::size_t j = i; j < end; j++)
+      fprintf(out_stream, " |%s|", names[j].c_str());
+    fprintf(out_stream, "))\n");
+    fflush(out_stream);
+
+    values.clear();
+    read_values(end - i, values);
+    for(std::size_t j = i; j < end; j++)
+      model_values[names[j]] = std::move(values[j - i]);
   }
-  else if(respval.token == TOK_HEXNUM)
+
+  model_fetched = true;
+}
+
+void smtlib_convt::begin_model_batch()
+{
+  // The model is fetched on the first value asked for
+  model_fetched = false;
+}
+
+void smtlib_convt::end_model_batch()
+{
+  model_fetched = false;
+  model_values.clear();
+}
+
+sexpr smtlib_convt::get_symbol_value(const std::string &name)
+{
+  if(model_batch_depth != 0)
   {
-    std::string data = respval.data.substr(2);
-    m = string2integer(data, 16);
+    if(!model_fetched)
+      fetch_model();
+
+    auto it = model_values.find(name);
+    if(it != model_values.end())
+      return it->second;
   }
-  else if(respval.token == TOK_BINNUM)
+
+  fprintf(out_stream, "(get-value (|%s|))\n", name.c_str());
+  fflush(out_stream);
+
+  std::vector<sexpr> values;
+  read_values(1, values);
+  return values.front();
+}
+
+BigInt smtlib_convt::get_bv(smt_astt a)
+{
+  // This should always be a symbol.
+  const smtlib_smt_ast *sa = static_cast<const smtlib_smt_ast *>(a);
+  assert(sa->kind == SMT_FUNC_SYMBOL && "Non-symbol in smtlib expr get_bv()");
+
+  BigInt m;
+  if(!sexpr_to_integer(get_symbol_value(sa->symname), m))
   {
-    std::string data = respval.data.substr(2);
-    m = string2integer(data, 2);
+    std::cerr << "Unrecognized value for integer symbol from smtlib solver"
+              << std::endl;
+    abort();
   }
 
-  delete smtlib_output;
   return m;
 }
 
@@ -538,63 +783,14 @@ smtlib_convt::get_array_elem(smt_astt array, uint64_t index, const type2tc &t)
     index,
     domain_width);
   fflush(out_stream);
-  smtlib_send_start_code = 1;
-  smtlibparse(TOK_START_VALUE);
-
-  if(smtlib_output->token == TOK_KW_ERROR)
-  {
-    std::cerr << "Error from smtlib solver when fetching literal value: \""
-              << smtlib_output->data << "\"" << std::endl;
-    abort();
-  }
-  else if(smtlib_output->token != 0)
-  {
-    std::cerr << "Unrecognized response to get-value from smtlib solver"
-              << std::endl;
-  }
 
-  // Unpack our value from response list.
-  assert(
-    smtlib_output->sexpr_list.size() == 1 &&
-    "More than one response to "
-    "get-value from smtlib solver");
-  sexpr &response = *smtlib_output->sexpr_list.begin();
-  // Now we have a valuation pair. First is the symbol
-  assert(
-    response.sexpr_list.size() == 2 &&
-    "Expected 2 operands in "
-    "valuation_pair_list from smtlib solver");
-  std::list<sexpr>::iterator it = response.sexpr_list.begin();
-  it++; // Echo of what we selected
-  sexpr &respval = *it++;
+  std::vector<sexpr> values;
+  read_values(1, values);
+  const sexpr &respval = values.front();
 
   // Attempt to read an integer.
   BigInt m;
-  bool was_integer = true;
-  if(respval.token == TOK_DECIMAL)
-  {
-    m = string2integer(respval.data);
-  }
-  else if(respval.token == TOK_NUMERAL)
-  {
-    std::cerr << "Numeral value for integer symbol from smtlib solver"
-              << std::endl;
-    abort();
-  }
-  else if(respval.token == TOK_HEXNUM)
-  {
-    std::string data = respval.data.substr(2);
-    m = string2integer(data, 16);
-  }
-  else if(respval.token == TOK_BINNUM)
-  {
-    std::string data = respval.data.substr(2);
-    m = string2integer(data, 2);
-  }
-  else
-  {
-    was_integer = false;
-  }
+  bool was_integer = sexpr_to_integer(respval, m);
 
   // Generate the appropriate expr.
   expr2tc result;
@@ -666,70 +862,47 @@ smtlib_convt::get_array_elem(smt_astt array, uint64_t index, const type2tc &t)
     abort();
   }
 
-  delete smtlib_output;
   return result;
 }
 
 bool smtlib_convt::get_bool(smt_astt a)
 {
-  fprintf(out_stream, "(get-value (");
+  const smtlib_smt_ast *sa = static_cast<const smtlib_smt_ast *>(a);
 
-  std::string output;
-  unsigned int brace_level =
-    emit_ast(static_cast<const smtlib_smt_ast *>(a), output);
-  fprintf(out_stream, "%s", output.c_str());
+  sexpr value;
+  if(sa->kind == SMT_FUNC_SYMBOL)
+  {
+    value = get_symbol_value(sa->symname);
+  }
+  else
+  {
+    fprintf(out_stream, "(get-value (");
 
-  // Emit a ton of end braces.
-  for(unsigned int i = 0; i < brace_level; i++)
-    fputc(')', out_stream);
+    std::string output;
+    unsigned int brace_level = emit_ast(sa, output);
+    fprintf(out_stream, "%s", output.c_str());
 
-  fprintf(out_stream, "))\n");
+    // Emit a ton of end braces.
+    for(unsigned int i = 0; i < brace_level; i++)
+      fputc(')', out_stream);
 
-  fflush(out_stream);
-  smtlib_send_start_code = 1;
-  smtlibparse(TOK_START_VALUE);
+    fprintf(out_stream, "))\n");
+    fflush(out_stream);
 
-  if(smtlib_output->token == TOK_KW_ERROR)
-  {
-    std::cerr << "Error from smtlib solver when fetching literal value: \""
-              << smtlib_output->data << "\"" << std::endl;
-    abort();
-  }
-  else if(smtlib_output->token != 0)
-  {
-    std::cerr << "Unrecognized response to get-value from smtlib solver"
-              << std::endl;
+    std::vector<sexpr> values;
+    read_values(1, values);
+    value = std::move(values.front());
   }
 
-  // First layer: valuation pair list. Should have one item.
-  assert(
-    smtlib_output->sexpr_list.size() == 1 &&
-    "Unexpected number of "
-    "responses to get-value from smtlib solver");
-  sexpr &pair = *smtlib_output->sexpr_list.begin();
-  // Should have two entries
-  assert(
-    pair.sexpr_list.size() == 2 &&
-    "Valuation pair in smtlib get-value "
-    "output without two operands");
-  std::list<sexpr>::const_iterator it = pair.sexpr_list.begin();
-  const sexpr &first = *it++;
-  (void)first;
-  const sexpr &second = *it++;
-  //  assert(first.token == TOK_SIMPLESYM && first.data == ss.str() &&
-  //         "Unexpected valuation variable from smtlib solver");
-
-  // And finally we have our value. It should be true or false.
-  bool result;
-  if(second.token == TOK_KW_TRUE)
-    result = true;
-  else if(second.token == TOK_KW_FALSE)
-    result = false;
-  else
-    abort();
+  // It should be true or false.
+  if(value.token == TOK_KW_TRUE)
+    return true;
+  if(value.token == TOK_KW_FALSE)
+    return false;
 
-  delete smtlib_output;
-  return result;
+  std::cerr << "Unrecognized value for boolean from smtlib solver"
+            << std::endl;
+  abort();
 }
 
 const std::string smtlib_convt::solver_text()
@@ -747,8 +920,11 @@ void smtlib_convt::assert_ast(smt_astt a)
 {
   const smtlib_smt_ast *sa = static_cast<const smtlib_smt_ast *>(a);
 
-  // Encode an assertion
-  fprintf(out_stream, "(assert\n");
+  // Encode an assertion, implied by the innermost guard if there is one.
+  if(ctx_guards.empty())
+    fprintf(out_stream, "(assert\n");
+  else
+    fprintf(out_stream, "(assert (=> %s\n", ctx_guards.back().c_str());
 
   // The algorithm: descend through the AST operands, binding values to
   // temporary symbols, then emit functions on those temporary symbols.
@@ -766,7 +942,7 @@ void smtlib_convt::assert_ast(smt_astt a)
     fputc(')', out_stream);
 
   // Final brace for closing the 'assert'.
-  fprintf(out_stream, ")\n");
+  fprintf(out_stream, ctx_guards.empty() ? ")\n" : "))\n");
 }
 
 smt_astt smtlib_convt::mk_smt_int(const BigInt &theint)
@@ -912,7 +1088,16 @@ void smtlib_convt::push_ctx()
   smt_convt::push_ctx();
   temp_sym_count.push_back(temp_sym_count.back());
 
-  fprintf(out_stream, "(push 1)\n");
+  if(!assume_contexts)
+  {
+    fprintf(out_stream, "(push 1)\n");
+    return;
+  }
+
+  std::stringstream ss;
+  ss << "|__ESBMC_ctx_" << ctx_guard_count++ << "|";
+  ctx_guards.push_back(ss.str());
+  fprintf(out_stream, "(declare-fun %s () Bool)\n", ctx_guards.back().c_str());
 }
 
 smt_astt smtlib_convt::mk_add(smt_astt a, smt_astt b)
@@ -1412,11 +1597,20 @@ smt_astt smtlib_convt::mk_isint(smt_astt a)
 
 void smtlib_convt::pop_ctx()
 {
-  fprintf(out_stream, "(pop 1)\n");
+  if(assume_contexts)
+  {
+    // Retire the level's guard for good. Its declarations stay in the solver.
+    fprintf(out_stream, "(assert (not %s))\n", ctx_guards.back().c_str());
+    ctx_guards.pop_back();
+  }
+  else
+  {
+    fprintf(out_stream, "(pop 1)\n");
 
-  // Wipe this level of symbol table.
-  symbol_tablet::nth_index<1>::type &syms_numindex = symbol_table.get<1>();
-  syms_numindex.erase(ctx_level);
+    // Wipe this level of symbol table.
+    symbol_tablet::nth_index<1>::type &syms_numindex = symbol_table.get<1>();
+    syms_numindex.erase(ctx_level);
+  }
   temp_sym_count.pop_back();
 
   smt_convt::pop_ctx();
@@ -5,7 +5,9 @@
 #include <solvers/smt/smt_conv.h>
 #include <string>
 #include <unistd.h>
+#include <unordered_map>
 #include <util/irep2.h>
+#include <vector>
 
 /** Identifiers for SMT functions.
  *  Each SMT function gets a unique identifier, representing its interpretation
@@ -268,6 +270,25 @@ public:
 
   void push_ctx() override;
   void pop_ctx() override;
+  bool solver_push_pop() const override
+  {
+    // Only a live solver process keeps assertions between two dec_solves
+    return in_stream != nullptr;
+  }
+
+  void begin_model_batch() override;
+  void end_model_batch() override;
+
+  /** Read one complete s-expression answer off the solver pipe. */
+  sexpr read_sexpr();
+  /** Read the answer to a get-value of count terms, one value per term and
+   *  in the order they were asked for. */
+  void read_values(std::size_t count, std::vector<sexpr> &values);
+  /** Fetch the value of every declared scalar symbol, a chunk of symbols per
+   *  get-value, for the model batch currently open. */
+  void fetch_model();
+  /** Value of one symbol: from the batch, if open, or from a get-value. */
+  sexpr get_symbol_value(const std::string &name);
 
   // Members
   pid_t solver_proc_pid;
@@ -300,6 +321,18 @@ public:
   std::vector<unsigned long> temp_sym_count;
   static const std::string temp_prefix;
 
+  // With --smtlib-assume-contexts, contexts are not pushed in the solver:
+  // asserts are implied by one guard symbol per level instead, every live
+  // guard is passed to check-sat-assuming, and popping a level asserts its
+  // guard false for good.
+  bool assume_contexts;
+  std::vector<std::string> ctx_guards;
+  unsigned int ctx_guard_count;
+
+  // Symbol values read for the open model batch
+  bool model_fetched;
+  std::unordered_map<std::string, sexpr> model_values;
+
   /** Mapping of SMT function IDs to their names. XXX, incorrect size. */
   static const std::string smt_func_name_table[expr2t::end_expr_id];
 };
@@ -8,20 +8,17 @@
 
 solver_creator create_new_smtlib_solver;
 solver_creator create_new_z3_solver;
-solver_creator create_new_minisat_solver;
 solver_creator create_new_boolector_solver;
 solver_creator create_new_cvc_solver;
 solver_creator create_new_mathsat_solver;
 solver_creator create_new_yices_solver;
+solver_creator create_new_cadical_solver;
 
 const struct esbmc_solver_config esbmc_solvers[] = {
   {"smtlib", create_new_smtlib_solver},
 #ifdef Z3
   {"z3", create_new_z3_solver},
 #endif
-#ifdef MINISAT
-  {"minisat", create_new_minisat_solver},
-#endif
 #ifdef BOOLECTOR
   {"boolector", create_new_boolector_solver},
 #endif
@@ -32,12 +29,15 @@ const struct esbmc_solver_config esbmc_solvers[] = {
   {"mathsat", create_new_mathsat_solver},
 #endif
 #ifdef YICES
-  {"yices", create_new_yices_solver}
+  {"yices", create_new_yices_solver},
+#endif
+#ifdef CADICAL
+  {"cadical", create_new_cadical_solver}
 #endif
 };
 
 const std::string list_of_all_solvers[] =
-  {"z3", "smtlib", "minisat", "boolector", "mathsat", "cvc", "yices"};
+  {"z3", "smtlib", "boolector", "mathsat", "cvc", "yices", "cadical"};
 
 const unsigned int total_num_of_solvers =
   sizeof(list_of_all_solvers) / sizeof(std::string);
@@ -779,11 +779,36 @@ yices_convt::convert_array_of(smt_astt init_val, unsigned long domain_width)
   return default_convert_array_of(init_val, domain_width, this);
 }
 
+void yices_convt::end_model_batch()
+{
+  if(batch_model != nullptr)
+    yices_free_model(batch_model);
+  batch_model = nullptr;
+}
+
+model_t *yices_convt::get_model()
+{
+  if(model_batch_depth == 0)
+    return yices_get_model(yices_ctx, 1);
+
+  if(batch_model == nullptr)
+    batch_model = yices_get_model(yices_ctx, 1);
+  return batch_model;
+}
+
+void yices_convt::release_model(model_t *model)
+{
+  if(model != batch_model)
+    yices_free_model(model);
+}
+
 bool yices_convt::get_bool(smt_astt a)
 {
   int32_t val;
   const yices_smt_ast *ast = to_solver_smt_ast<yices_smt_ast>(a);
-  auto res = yices_get_bool_value(yices_get_model(yices_ctx, 1), ast->a, &val);
+  model_t *model = get_model();
+  auto res = yices_get_bool_value(model, ast->a, &val);
+  release_model(model);
   assert(!res && "Can't get boolean value from Yices");
   return val ? true : false;
 }
@@ -793,9 +818,11 @@ BigInt yices_convt::get_bv(smt_astt a)
   const yices_smt_ast *ast = to_solver_smt_ast<yices_smt_ast>(a);
 
   int64_t val = 0;
+  model_t *model = get_model();
   if(int_encoding)
   {
-    yices_get_int64_value(yices_get_model(yices_ctx, 1), ast->a, &val);
+    yices_get_int64_value(model, ast->a, &val);
+    release_model(model);
     return BigInt(val);
   }
 
@@ -803,7 +830,8 @@ BigInt yices_convt::get_bv(smt_astt a)
   assert(width <= 64);
 
   int32_t data[64];
-  yices_get_bv_value(yices_get_model(yices_ctx, 1), ast->a, data);
+  yices_get_bv_value(model, ast->a, data);
+  release_model(model);
 
   int i;
   for(i = width - 1; i >= 0; i--)
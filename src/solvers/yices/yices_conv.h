@@ -125,6 +125,10 @@ public:
 
   void push_ctx() override;
   void pop_ctx() override;
+  bool solver_push_pop() const override
+  {
+    return true;
+  }
 
   smt_astt
   convert_array_of(smt_astt init_val, unsigned long domain_width) override;
@@ -150,7 +154,16 @@ public:
 
   void print_model() override;
 
+  void end_model_batch() override;
+
+  // Either the pinned batch model or a fresh one to hand to release_model
+  model_t *get_model();
+  void release_model(model_t *model);
+
   context_t *yices_ctx;
+
+  // The model of the last check, fetched once per model batch
+  model_t *batch_model = nullptr;
 };
 
 #endif /* _ESBMC_SOLVERS_YICES_YICES_CONV_H_ */
@@ -94,6 +94,39 @@ smt_convt::resultt z3_convt::dec_solve()
   return smt_convt::P_ERROR;
 }
 
+std::vector<std::pair<std::string, std::string>> z3_convt::solver_statistics()
+{
+  std::vector<std::pair<std::string, std::string>> values;
+
+  z3::stats st = solver.statistics();
+  for(unsigned i = 0; i < st.size(); i++)
+  {
+    std::ostringstream value;
+    if(st.is_uint(i))
+      value << st.uint_value(i);
+    else
+      value << st.double_value(i);
+    values.emplace_back(st.key(i), value.str());
+  }
+
+  return values;
+}
+
+void z3_convt::end_model_batch()
+{
+  batch_model.reset();
+}
+
+z3::model z3_convt::get_model()
+{
+  if(model_batch_depth == 0)
+    return solver.get_model();
+
+  if(!batch_model)
+    batch_model.reset(new z3::model(solver.get_model()));
+  return *batch_model;
+}
+
 void z3_convt::assert_ast(smt_astt a)
 {
   z3::expr theval = to_solver_smt_ast<z3_smt_ast>(a)->a;
@@ -1140,7 +1173,7 @@ expr2tc z3_convt::tuple_get(const expr2tc &expr)
 bool z3_convt::get_bool(smt_astt a)
 {
   const z3_smt_ast *za = to_solver_smt_ast<z3_smt_ast>(a);
-  z3::expr e = solver.get_model().eval(za->a, false);
+  z3::expr e = get_model().eval(za->a, false);
 
   if(Z3_get_bool_value(z3_ctx, e) == Z3_L_TRUE)
     return true;
@@ -1151,7 +1184,7 @@ bool z3_convt::get_bool(smt_astt a)
 BigInt z3_convt::get_bv(smt_astt a)
 {
   const z3_smt_ast *za = to_solver_smt_ast<z3_smt_ast>(a);
-  z3::expr e = solver.get_model().eval(za->a, false);
+  z3::expr e = get_model().eval(za->a, false);
 
   // Not a numeral? Let's not try to convert it
   return string2integer(Z3_get_numeral_string(z3_ctx, e));
@@ -1160,7 +1193,7 @@ BigInt z3_convt::get_bv(smt_astt a)
 ieee_floatt z3_convt::get_fpbv(smt_astt a)
 {
   const z3_smt_ast *za = to_solver_smt_ast<z3_smt_ast>(a);
-  z3::expr e = solver.get_model().eval(za->a, false);
+  z3::expr e = get_model().eval(za->a, false);
 
   assert(Z3_get_ast_kind(z3_ctx, e) == Z3_APP_AST);
 
@@ -1186,7 +1219,7 @@ ieee_floatt z3_convt::get_fpbv(smt_astt a)
   {
     Z3_ast v;
     if(Z3_model_eval(
-         z3_ctx, solver.get_model(), Z3_mk_fpa_to_ieee_bv(z3_ctx, e), 1, &v))
+         z3_ctx, get_model(), Z3_mk_fpa_to_ieee_bv(z3_ctx, e), 1, &v))
       number.unpack(BigInt(Z3_get_numeral_string(z3_ctx, v)));
   }
 
@@ -1205,7 +1238,7 @@ z3_convt::get_array_elem(smt_astt array, uint64_t index, const type2tc &subtype)
     idx = to_solver_smt_ast<z3_smt_ast>(
       mk_smt_bv(BigInt(index), mk_bv_sort(array_bound)));
 
-  z3::expr e = solver.get_model().eval(select(za->a, idx->a), false);
+  z3::expr e = get_model().eval(select(za->a, idx->a), false);
   return get_by_ast(subtype, new_ast(e, convert_sort(subtype)));
 }
 
@@ -1276,7 +1309,7 @@ smt_astt z3_convt::mk_smt_fpbv_neg(smt_astt op)
 
 void z3_convt::print_model()
 {
-  std::cout << Z3_model_to_string(z3_ctx, solver.get_model());
+  std::cout << Z3_model_to_string(z3_ctx, get_model());
 }
 
 smt_sortt z3_convt::mk_fpbv_sort(const unsigned ew, const unsigned sw)
@@ -9,6 +9,7 @@ Author: Lucas Cordeiro, lcc08r@ecs.soton.ac.uk
 #ifndef _ESBMC_SOLVERS_Z3_Z3_CONV_H
 #define _ESBMC_SOLVERS_Z3_Z3_CONV_H
 
+#include <memory>
 #include <solvers/smt/smt_conv.h>
 #include <z3++.h>
 
@@ -39,6 +40,10 @@ public:
 public:
   void push_ctx() override;
   void pop_ctx() override;
+  bool solver_push_pop() const override
+  {
+    return true;
+  }
   smt_convt::resultt dec_solve() override;
 
   bool get_bool(smt_astt a) override;
@@ -200,13 +205,22 @@ public:
     return ss.str();
   }
 
+  std::vector<std::pair<std::string, std::string>>
+  solver_statistics() override;
+
   void dump_smt() override;
   void print_model() override;
 
+  void end_model_batch() override;
+
+  // The model of the last check, fetched once per model batch
+  z3::model get_model();
+
 public:
   //  Must be first member; that way it's the last to be destroyed.
   z3::context z3_ctx;
   z3::solver solver;
+  std::unique_ptr<z3::model> batch_model;
 };
 
 #endif /* _ESBMC_SOLVERS_Z3_Z3_CONV_H_ */
@@ -0,0 +1,398 @@
+/*******************************************************************\
+
+Module: Chunked vector, an append-only arena with stable references
+
+\*******************************************************************/
+
+#ifndef CPROVER_CHUNKED_VECTOR_H
+#define CPROVER_CHUNKED_VECTOR_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// A sequence container that stores its elements in fixed size chunks of
+// 2^chunk_bits slots. Appending never moves an element, so references stay
+// valid as the container grows, while the allocator only sees one request
+// per chunk instead of one per element. Iterators are (container, index)
+// pairs: they survive appends, and an iterator taken at end() becomes an
+// iterator to the next appended element, as with indices into a vector.
+// clear() destroys every element and hands all chunks back at once.
+template <class T, unsigned chunk_bits = 10>
+class chunked_vectort
+{
+  static_assert(chunk_bits > 0 && chunk_bits < 24, "unreasonable chunk size");
+
+public:
+  typedef T value_type;
+  typedef T &reference;
+  typedef const T &const_reference;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+  static constexpr size_type chunk_size = size_type(1) << chunk_bits;
+
+  template <bool is_const>
+  class iteratort
+  {
+  public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef typename std::conditional<is_const, const T *, T *>::type pointer;
+    typedef typename std::conditional<is_const, const T &, T &>::type reference;
+    typedef typename std::
+      conditional<is_const, const chunked_vectort *, chunked_vectort *>::type
+        containert;
+
+    iteratort() : c(nullptr), idx(0)
+    {
+    }
+
+    iteratort(containert _c, size_type _idx) : c(_c), idx(_idx)
+    {
+    }
+
+    // iterator -> const_iterator
+    template <
+      bool other_const,
+      class = typename std::enable_if<is_const && !other_const>::type>
+    iteratort(const iteratort<other_const> &ref) : c(ref.c), idx(ref.idx)
+    {
+    }
+
+    reference operator*() const
+    {
+      return (*c)[idx];
+    }
+
+    pointer operator->() const
+    {
+      return &(*c)[idx];
+    }
+
+    reference operator[](difference_type n) const
+    {
+      return (*c)[idx + n];
+    }
+
+    iteratort &operator++()
+    {
+      ++idx;
+      return *this;
+    }
+
+    iteratort operator++(int)
+    {
+      iteratort tmp(*this);
+      ++idx;
+      return tmp;
+    }
+
+    iteratort &operator--()
+    {
+      --idx;
+      return *this;
+    }
+
+    iteratort operator--(int)
+    {
+      iteratort tmp(*this);
+      --idx;
+      return tmp;
+    }
+
+    iteratort &operator+=(difference_type n)
+    {
+      idx += n;
+      return *this;
+    }
+
+    iteratort &operator-=(difference_type n)
+    {
+      idx -= n;
+      return *this;
+    }
+
+    iteratort operator+(difference_type n) const
+    {
+      return iteratort(c, idx + n);
+    }
+
+    iteratort operator-(difference_type n) const
+    {
+      return iteratort(c, idx - n);
+    }
+
+    difference_type operator-(const iteratort &ref) const
+    {
+      return difference_type(idx) - difference_type(ref.idx);
+    }
+
+    // Comparisons take the const flavour so that iterators and
+    // const_iterators can be mixed freely.
+    bool operator==(const iteratort<true> &ref) const
+    {
+      assert(c == ref.c);
+      return idx == ref.idx;
+    }
+
+    bool operator!=(const iteratort<true> &ref) const
+    {
+      return !(*this == ref);
+    }
+
+    bool operator<(const iteratort<true> &ref) const
+    {
+      assert(c == ref.c);
+      return idx < ref.idx;
+    }
+
+    bool operator>(const iteratort<true> &ref) const
+    {
+      return ref < *this;
+    }
+
+    bool operator<=(const iteratort<true> &ref) const
+    {
+      return !(ref < *this);
+    }
+
+    bool operator>=(const iteratort<true> &ref) const
+    {
+      return !(*this < ref);
+    }
+
+    size_type index() const
+    {
+      return idx;
+    }
+
+  protected:
+    template <bool>
+    friend class iteratort;
+
+    containert c;
+    size_type idx;
+  };
+
+  typedef iteratort<false> iterator;
+  typedef iteratort<true> const_iterator;
+  typedef std::reverse_iterator<iterator> reverse_iterator;
+  typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+  chunked_vectort() : count(0)
+  {
+  }
+
+  chunked_vectort(const chunked_vectort &ref) : count(0)
+  {
+    for(const T &e : ref)
+      emplace_back(e);
+  }
+
+  chunked_vectort(chunked_vectort &&ref) noexcept
+    : chunks(std::move(ref.chunks)), count(ref.count)
+  {
+    ref.chunks.clear();
+    ref.count = 0;
+  }
+
+  chunked_vectort &operator=(const chunked_vectort &ref)
+  {
+    if(this != &ref)
+    {
+      clear();
+      for(const T &e : ref)
+        emplace_back(e);
+    }
+    return *this;
+  }
+
+  chunked_vectort &operator=(chunked_vectort &&ref) noexcept
+  {
+    if(this != &ref)
+    {
+      clear();
+      chunks.swap(ref.chunks);
+      std::swap(count, ref.count);
+    }
+    return *this;
+  }
+
+  ~chunked_vectort()
+  {
+    clear();
+  }
+
+  template <class... Args>
+  T &emplace_back(Args &&... args)
+  {
+    if((count >> chunk_bits) == chunks.size())
+      chunks.emplace_back(new slott[chunk_size]);
+
+    T *p = slot(count);
+    new(p) T(std::forward<Args>(args)...);
+    ++count;
+    return *p;
+  }
+
+  void push_back(const T &e)
+  {
+    emplace_back(e);
+  }
+
+  void pop_back()
+  {
+    assert(count != 0);
+    slot(--count)->~T();
+  }
+
+  // Destroys the elements from new_size on, keeping the chunks for reuse
+  void truncate(size_type new_size)
+  {
+    assert(new_size <= count);
+    while(count > new_size)
+      pop_back();
+  }
+
+  iterator erase(const_iterator first, const_iterator last)
+  {
+    size_type f = first.index(), l = last.index();
+    assert(f <= l && l <= count);
+    std::move(begin() + l, end(), begin() + f);
+    truncate(count - (l - f));
+    return begin() + f;
+  }
+
+  iterator erase(const_iterator pos)
+  {
+    return erase(pos, pos + 1);
+  }
+
+  // Destroys every element and releases all chunks in one go
+  void clear()
+  {
+    truncate(0);
+    chunks.clear();
+    chunks.shrink_to_fit();
+  }
+
+  T &operator[](size_type i)
+  {
+    assert(i < count);
+    return *slot(i);
+  }
+
+  const T &operator[](size_type i) const
+  {
+    assert(i < count);
+    return *slot(i);
+  }
+
+  T &front()
+  {
+    return (*this)[0];
+  }
+
+  const T &front() const
+  {
+    return (*this)[0];
+  }
+
+  T &back()
+  {
+    return (*this)[count - 1];
+  }
+
+  const T &back() const
+  {
+    return (*this)[count - 1];
+  }
+
+  size_type size() const
+  {
+    return count;
+  }
+
+  bool empty() const
+  {
+    return count == 0;
+  }
+
+  // Bytes reserved for element storage, not counting what T itself owns
+  size_type allocated_bytes() const
+  {
+    return chunks.size() * chunk_size * sizeof(T);
+  }
+
+  iterator begin()
+  {
+    return iterator(this, 0);
+  }
+
+  iterator end()
+  {
+    return iterator(this, count);
+  }
+
+  const_iterator begin() const
+  {
+    return const_iterator(this, 0);
+  }
+
+  const_iterator end() const
+  {
+    return const_iterator(this, count);
+  }
+
+  const_iterator cbegin() const
+  {
+    return begin();
+  }
+
+  const_iterator cend() const
+  {
+    return end();
+  }
+
+  reverse_iterator rbegin()
+  {
+    return reverse_iterator(end());
+  }
+
+  reverse_iterator rend()
+  {
+    return reverse_iterator(begin());
+  }
+
+  const_reverse_iterator rbegin() const
+  {
+    return const_reverse_iterator(end());
+  }
+
+  const_reverse_iterator rend() const
+  {
+    return const_reverse_iterator(begin());
+  }
+
+protected:
+  typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type slott;
+
+  T *slot(size_type i) const
+  {
+    return reinterpret_cast<T *>(
+      &chunks[i >> chunk_bits][i & (chunk_size - 1)]);
+  }
+
+  std::vector<std::unique_ptr<slott[]>> chunks;
+  size_type count;
+};
+
+#endif
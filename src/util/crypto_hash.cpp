@@ -15,9 +15,13 @@ public:
   boost::uuids::detail::sha1 s;
 };
 
-bool crypto_hash::operator<(const crypto_hash h2) const
+static_assert(
+  sizeof(crypto_hash::hash) == CRYPTO_HASH_SIZE,
+  "Digest storage must match the SHA-1 digest size");
+
+bool crypto_hash::operator<(const crypto_hash &h2) const
 {
-  if(memcmp(hash, h2.hash, CRYPTO_HASH_SIZE) < 0)
+  if(memcmp(hash, h2.hash, sizeof(hash)) < 0)
     return true;
 
   return false;
@@ -6,15 +6,16 @@
 
 class crypto_hash_private;
 
-#define CRYPTO_HASH_SIZE 32
+// SHA-1 digest size, in bytes
+#define CRYPTO_HASH_SIZE 20
 
 class crypto_hash
 {
 public:
   std::shared_ptr<crypto_hash_private> p_crypto;
-  unsigned int hash[5];
+  unsigned int hash[CRYPTO_HASH_SIZE / sizeof(unsigned int)];
 
-  bool operator<(const crypto_hash h2) const;
+  bool operator<(const crypto_hash &h2) const;
 
   std::string to_string() const;
 
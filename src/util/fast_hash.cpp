@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <util/fast_hash.h>
+
+static const uint64_t c1 = 0x87c37b91114253d5ULL;
+static const uint64_t c2 = 0x4cf5ad432745937fULL;
+
+static inline uint64_t rotl64(uint64_t x, int8_t r)
+{
+  return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t fmix64(uint64_t k)
+{
+  k ^= k >> 33;
+  k *= 0xff51afd7ed558ccdULL;
+  k ^= k >> 33;
+  k *= 0xc4ceb9fe1a85ec53ULL;
+  k ^= k >> 33;
+  return k;
+}
+
+static inline uint64_t read64(const uint8_t *p)
+{
+  // memcpy rather than a cast: no alignment requirement on the input
+  uint64_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+fast_hash::fast_hash() : hash{{0, 0}}, h1(0), h2(0), length(0), tail_size(0)
+{
+}
+
+void fast_hash::mix_block(const uint8_t *block)
+{
+  uint64_t k1 = read64(block);
+  uint64_t k2 = read64(block + 8);
+
+  k1 *= c1;
+  k1 = rotl64(k1, 31);
+  k1 *= c2;
+  h1 ^= k1;
+
+  h1 = rotl64(h1, 27);
+  h1 += h2;
+  h1 = h1 * 5 + 0x52dce729;
+
+  k2 *= c2;
+  k2 = rotl64(k2, 33);
+  k2 *= c1;
+  h2 ^= k2;
+
+  h2 = rotl64(h2, 31);
+  h2 += h1;
+  h2 = h2 * 5 + 0x38495ab5;
+}
+
+void fast_hash::ingest(void const *data, unsigned int size)
+{
+  const uint8_t *bytes = static_cast<const uint8_t *>(data);
+  length += size;
+
+  // Top up a block left over from the previous call first
+  if(tail_size != 0)
+  {
+    unsigned int fill = std::min(size, 16 - tail_size);
+    memcpy(tail + tail_size, bytes, fill);
+    tail_size += fill;
+    bytes += fill;
+    size -= fill;
+
+    if(tail_size < 16)
+      return;
+
+    mix_block(tail);
+    tail_size = 0;
+  }
+
+  for(; size >= 16; bytes += 16, size -= 16)
+    mix_block(bytes);
+
+  memcpy(tail, bytes, size);
+  tail_size = size;
+}
+
+void fast_hash::fin()
+{
+  uint64_t k1 = 0, k2 = 0;
+
+  switch(tail_size)
+  {
+  case 15:
+    k2 ^= ((uint64_t)tail[14]) << 48;
+    /* fallthrough */
+  case 14:
+    k2 ^= ((uint64_t)tail[13]) << 40;
+    /* fallthrough */
+  case 13:
+    k2 ^= ((uint64_t)tail[12]) << 32;
+    /* fallthrough */
+  case 12:
+    k2 ^= ((uint64_t)tail[11]) << 24;
+    /* fallthrough */
+  case 11:
+    k2 ^= ((uint64_t)tail[10]) << 16;
+    /* fallthrough */
+  case 10:
+    k2 ^= ((uint64_t)tail[9]) << 8;
+    /* fallthrough */
+  case 9:
+    k2 ^= ((uint64_t)tail[8]);
+    k2 *= c2;
+    k2 = rotl64(k2, 33);
+    k2 *= c1;
+    h2 ^= k2;
+    /* fallthrough */
+  case 8:
+    k1 ^= ((uint64_t)tail[7]) << 56;
+    /* fallthrough */
+  case 7:
+    k1 ^= ((uint64_t)tail[6]) << 48;
+    /* fallthrough */
+  case 6:
+    k1 ^= ((uint64_t)tail[5]) << 40;
+    /* fallthrough */
+  case 5:
+    k1 ^= ((uint64_t)tail[4]) << 32;
+    /* fallthrough */
+  case 4:
+    k1 ^= ((uint64_t)tail[3]) << 24;
+    /* fallthrough */
+  case 3:
+    k1 ^= ((uint64_t)tail[2]) << 16;
+    /* fallthrough */
+  case 2:
+    k1 ^= ((uint64_t)tail[1]) << 8;
+    /* fallthrough */
+  case 1:
+    k1 ^= ((uint64_t)tail[0]);
+    k1 *= c1;
+    k1 = rotl64(k1, 31);
+    k1 *= c2;
+    h1 ^= k1;
+    break;
+
+  default:
+    break;
+  }
+
+  uint64_t a = h1 ^ length, b = h2 ^ length;
+  a += b;
+  b += a;
+  a = fmix64(a);
+  b = fmix64(b);
+  a += b;
+  b += a;
+
+  hash[0] = a;
+  hash[1] = b;
+}
+
+std::string fast_hash::to_string() const
+{
+  std::ostringstream buf;
+  for(uint64_t i : hash)
+    buf << std::hex << std::setfill('0') << std::setw(16) << i;
+
+  return buf.str();
+}
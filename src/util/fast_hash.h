@@ -0,0 +1,56 @@
+#ifndef _CPROVER_SRC_UTIL_FAST_HASH_H_
+#define _CPROVER_SRC_UTIL_FAST_HASH_H_
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+/** 128 bit non-cryptographic hash.
+ *  Same interface as crypto_hash, so that anything that can be fed to one can
+ *  be fed to the other, but meant for telling apart huge numbers of program
+ *  states quickly rather than for digests shown to the outside world. It's
+ *  MurmurHash3 (x64, 128 bit) made incremental: all of its state lives in the
+ *  object and nothing is heap allocated. */
+class fast_hash
+{
+public:
+  typedef std::array<uint64_t, 2> digestt;
+
+  /** Hashing functor so that digests can key unordered containers */
+  struct digest_hash
+  {
+    size_t operator()(const digestt &d) const
+    {
+      return d[0] ^ d[1];
+    }
+  };
+
+  /** Result, valid once fin has been called */
+  digestt hash;
+
+  fast_hash();
+  void ingest(void const *data, unsigned int size);
+  void fin();
+
+  bool operator<(const fast_hash &h2) const
+  {
+    return hash < h2.hash;
+  }
+
+  bool operator==(const fast_hash &h2) const
+  {
+    return hash == h2.hash;
+  }
+
+  std::string to_string() const;
+
+protected:
+  void mix_block(const uint8_t *block);
+
+  uint64_t h1, h2;
+  uint64_t length;
+  uint8_t tail[16];
+  unsigned int tail_size;
+};
+
+#endif /* _CPROVER_SRC_UTIL_FAST_HASH_H_ */
@@ -7,20 +7,129 @@ Author: Daniel Kroening, kroening@kroening.com
 \*******************************************************************/
 
 #include <algorithm>
+#include <unordered_map>
 #include <util/guard.h>
 #include <util/irep2_utils.h>
 #include <util/std_expr.h>
 
+class guardt::nodet : public std::enable_shared_from_this<nodet>
+{
+public:
+  nodet(const node_ptrt &_parent, const expr2tc &_expr, size_t _hash)
+    : parent(_parent),
+      expr(_expr),
+      depth(_parent ? _parent->depth + 1 : 1),
+      hash(_hash)
+  {
+  }
+
+  ~nodet();
+
+  node_ptrt parent;
+  expr2tc expr;
+  size_t depth;
+  size_t hash;
+
+  // The chain of ands up to and including this node, built on first use and
+  // shared with every guard extending this one
+  expr2tc conjunction;
+
+  // Every live node, by hash
+  typedef std::unordered_multimap<size_t, nodet *> tablet;
+  static tablet &table()
+  {
+    // Never freed, guards in static storage may outlive any static table
+    static tablet *t = new tablet;
+    return *t;
+  }
+};
+
+guardt::nodet::~nodet()
+{
+  auto range = table().equal_range(hash);
+  for(auto it = range.first; it != range.second; ++it)
+    if(it->second == this)
+    {
+      table().erase(it);
+      break;
+    }
+
+  // Release the ancestors only this node kept alive one at a time, rather
+  // than recursing through one destructor per conjunct.
+  node_ptrt p = std::move(parent);
+  while(p && p.use_count() == 1)
+  {
+    node_ptrt next = std::move(p->parent);
+    p = std::move(next);
+  }
+}
+
+guardt::node_ptrt guardt::mk_node(const node_ptrt &parent, const expr2tc &expr)
+{
+  size_t h = parent ? parent->hash : 0;
+  h ^= expr->crc() + 0x9e3779b9 + (h << 6) + (h >> 2);
+
+  auto range = nodet::table().equal_range(h);
+  for(auto it = range.first; it != range.second; ++it)
+    if(it->second->parent == parent && it->second->expr == expr)
+      return it->second->shared_from_this();
+
+  node_ptrt n = std::make_shared<nodet>(parent, expr, h);
+  nodet::table().emplace(h, n.get());
+  return n;
+}
+
+guardt::nodet *guardt::common_prefix(nodet *a, nodet *b)
+{
+  // Nodes are unique, so the longest common prefix of two guards is their
+  // deepest shared node.
+  while(a != nullptr && b != nullptr && a != b)
+  {
+    if(a->depth >= b->depth)
+      a = a->parent.get();
+    else
+      b = b->parent.get();
+  }
+
+  return a == b ? a : nullptr;
+}
+
+void guardt::append_suffix(const nodet *from, const nodet *prefix)
+{
+  std::vector<const nodet *> suffix;
+  for(; from != prefix; from = from->parent.get())
+    suffix.push_back(from);
+
+  for(auto it = suffix.rbegin(); it != suffix.rend(); ++it)
+    last = mk_node(last, (*it)->expr);
+}
+
 expr2tc guardt::as_expr() const
 {
   if(is_true())
     return gen_true_expr();
 
   if(is_single_symbol())
-    return *guard_list.begin();
+    return last->expr;
 
-  assert(!is_nil_expr(g_expr));
-  return g_expr;
+  if(!is_nil_expr(last->conjunction))
+    return last->conjunction;
+
+  // Build the chain of ands from the deepest node that already has one, so
+  // that each prefix is built once however many guards extend it.
+  std::vector<nodet *> pending;
+  nodet *n = last.get();
+  for(; n->depth > 1 && is_nil_expr(n->conjunction); n = n->parent.get())
+    pending.push_back(n);
+
+  expr2tc res = n->depth == 1 ? n->expr : n->conjunction;
+  for(auto it = pending.rbegin(); it != pending.rend(); ++it)
+  {
+    res = and2tc(res, (*it)->expr);
+    (*it)->conjunction = res;
+  }
+
+  return res;
 }
 
 void guardt::add(const expr2tc &expr)
@@ -40,21 +149,7 @@ void guardt::add(const expr2tc &expr)
     return;
   }
 
-  guard_list.push_back(expr);
-
-  // Update the chain of ands
-
-  // Easy case, there is no g_expr
-  if(is_nil_expr(g_expr))
-  {
-    g_expr = expr;
-  }
-  else
-  {
-    // Otherwise, just update the chain of ands
-    and2tc new_g_expr(g_expr, expr);
-    g_expr.swap(new_g_expr);
-  }
+  last = mk_node(last, expr);
 }
 
 void guardt::guard_expr(expr2tc &dest) const
@@ -73,54 +168,34 @@ void guardt::guard_expr(expr2tc &dest) const
   dest = expr2tc(new implies2t(as_expr(), dest));
 }
 
-void guardt::build_guard_expr()
+void guardt::append(const guardt &guard)
 {
-  // This method closely related to guardt::add and guardt::guard_expr
-  // We need to build the chain of ands, to avoid memory bloat on as_expr
-
-  // if the guard is true, or a single symbol, we don't need to build it
-  if(is_true() || is_single_symbol())
+  if(guard.is_true())
     return;
 
-  // This method will only be used, when the guard is nil, for instance,
-  // guardt &operator -= and guardt &operator |=, all other cases should
-  // be handled by guardt::add
-  assert(is_nil_expr(g_expr));
-
-  // We can assume at least two operands
-  auto it = guard_list.begin();
-
-  expr2tc arg1, arg2;
-  arg1 = *it++;
-  arg2 = *it++;
-  and2tc res(arg1, arg2);
-  while(it != guard_list.end())
-    res = and2tc(res, *it++);
+  // Adding another guard's conjuncts to true rebuilds that guard
+  if(is_true())
+  {
+    last = guard.last;
+    return;
+  }
 
-  g_expr.swap(res);
-}
+  std::vector<const nodet *> conjuncts;
+  for(const nodet *n = guard.last.get(); n != nullptr; n = n->parent.get())
+    conjuncts.push_back(n);
 
-void guardt::append(const guardt &guard)
-{
-  for(auto const &it : guard.guard_list)
-    add(it);
+  for(auto it = conjuncts.rbegin(); it != conjuncts.rend(); ++it)
+    add((*it)->expr);
 }
 
 guardt &operator-=(guardt &g1, const guardt &g2)
 {
-  guardt::guard_listt diff;
-  std::set_difference(
-    g1.guard_list.begin(),
-    g1.guard_list.end(),
-    g2.guard_list.begin(),
-    g2.guard_list.end(),
-    std::back_inserter(diff));
-
-  // Clear g1 and build the guard's list and expr
-  g1.clear();
+  // Keep what g1 adds after the prefix it shares with g2
+  guardt::nodet *common = guardt::common_prefix(g1.last.get(), g2.last.get());
 
-  g1.guard_list.swap(diff);
-  g1.build_guard_expr();
+  guardt::node_ptrt from;
+  from.swap(g1.last);
+  g1.append_suffix(from.get(), common);
 
   return g1;
 }
@@ -140,7 +215,7 @@ guardt &operator|=(guardt &g1, const guardt &g2)
   {
     // Both guards have one symbol, so check if we opposite symbols, e.g,
     // g1 == sym1 and g2 == !sym1
-    expr2tc or_expr(new or2t(*g1.guard_list.begin(), *g2.guard_list.begin()));
+    expr2tc or_expr(new or2t(g1.last->expr, g2.last->expr));
     simplify(or_expr);
 
     if(::is_true(or_expr))
@@ -161,36 +236,16 @@ guardt &operator|=(guardt &g1, const guardt &g2)
     // res = g1 || g2 = (!guard3 && !guard2 && !guard1) || (guard2 && !guard1)
 
     // Simplify equation: everything that's common in both guards, will not
-    // be or'd
-
-    // Common guards
-    guardt common;
-    std::set_intersection(
-      g1.guard_list.begin(),
-      g1.guard_list.end(),
-      g2.guard_list.begin(),
-      g2.guard_list.end(),
-      std::back_inserter(common.guard_list));
-    common.build_guard_expr();
+    // be or'd. Sibling states share the guard they branched from, so that is
+    // their common prefix.
+    guardt::nodet *common = guardt::common_prefix(g1.last.get(), g2.last.get());
 
     // New g1 and g2, without the common guards
     guardt new_g1;
-    std::set_difference(
-      g1.guard_list.begin(),
-      g1.guard_list.end(),
-      common.guard_list.begin(),
-      common.guard_list.end(),
-      std::back_inserter(new_g1.guard_list));
-    new_g1.build_guard_expr();
+    new_g1.append_suffix(g1.last.get(), common);
 
     guardt new_g2;
-    std::set_difference(
-      g2.guard_list.begin(),
-      g2.guard_list.end(),
-      common.guard_list.begin(),
-      common.guard_list.end(),
-      std::back_inserter(new_g2.guard_list));
-    new_g2.build_guard_expr();
+    new_g2.append_suffix(g2.last.get(), common);
 
     // Get the and expression from both guards
     expr2tc or_expr(new or2t(new_g1.as_expr(), new_g2.as_expr()));
@@ -199,7 +254,9 @@ guardt &operator|=(guardt &g1, const guardt &g2)
     if(new_g1.is_single_symbol() && new_g2.is_single_symbol())
       simplify(or_expr);
 
-    g1.clear_append(common);
+    // common is a node of g1, so it is alive until g1 is overwritten
+    g1.last =
+      common == nullptr ? guardt::node_ptrt() : common->shared_from_this();
     g1.add(or_expr);
   }
 
@@ -208,20 +265,23 @@ guardt &operator|=(guardt &g1, const guardt &g2)
 
 void guardt::dump() const
 {
-  for(auto const &it : guard_list)
-    it->dump();
+  std::vector<const nodet *> conjuncts;
+  for(const nodet *n = last.get(); n != nullptr; n = n->parent.get())
+    conjuncts.push_back(n);
+
+  for(auto it = conjuncts.rbegin(); it != conjuncts.rend(); ++it)
+    (*it)->expr->dump();
 }
 
 bool operator==(const guardt &g1, const guardt &g2)
 {
-  // Very simple: the guard list should be identical.
-  return g1.guard_list == g2.guard_list;
+  // Nodes are hash-consed, so equal lists of conjuncts are the same node
+  return g1.last == g2.last;
 }
 
 void guardt::swap(guardt &g)
 {
-  guard_list.swap(g.guard_list);
-  g_expr.swap(g.g_expr);
+  last.swap(g.last);
 }
 
 bool guardt::disjunction_may_simplify(const guardt &other_guard) const
@@ -242,21 +302,21 @@ bool guardt::disjunction_may_simplify(const guardt &other_guard) const
 
 bool guardt::is_true() const
 {
-  return guard_list.empty();
+  return last == nullptr;
 }
 
 bool guardt::is_false() const
 {
   // Never false
-  if(guard_list.size() != 1)
+  if(!is_single_symbol())
     return false;
 
-  return (*guard_list.begin() == gen_false_expr());
+  return (last->expr == gen_false_expr());
 }
 
 void guardt::make_true()
 {
-  guard_list.clear();
+  last.reset();
 }
 
 void guardt::make_false()
@@ -266,13 +326,12 @@ void guardt::make_false()
 
 bool guardt::is_single_symbol() const
 {
-  return (guard_list.size() == 1);
+  return last != nullptr && last->depth == 1;
 }
 
 void guardt::clear()
 {
-  guard_list.clear();
-  g_expr.reset();
+  last.reset();
 }
 
 void guardt::clear_append(const guardt &guard)
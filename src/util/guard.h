@@ -10,6 +10,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_GUARD_H
 
 #include <iostream>
+#include <memory>
 #include <util/expr.h>
 #include <util/irep2.h>
 #include <util/migrate.h>
@@ -19,12 +20,8 @@ class guardt
 public:
   // Default constructors
   guardt() = default;
-  guardt(const guardt &ref)
-  {
-    *this = ref;
-  }
-
-  typedef std::vector<expr2tc> guard_listt;
+  guardt(const guardt &ref) = default;
+  guardt &operator=(const guardt &ref) = default;
 
   void add(const expr2tc &expr);
   void append(const guardt &guard);
@@ -47,15 +44,25 @@ public:
   void dump() const;
 
 protected:
-  guard_listt guard_list;
-  expr2tc g_expr;
+  // A guard is a conjunction, kept as a chain of nodes from its last conjunct
+  // back to its first. Nodes are immutable and hash-consed on (parent,
+  // conjunct), so copying a guard copies one pointer, states branching from
+  // the same guard share everything before the branch, and two guards are
+  // equal exactly when they point at the same node.
+  class nodet;
+  typedef std::shared_ptr<nodet> node_ptrt;
+
+  // Null for the true guard
+  node_ptrt last;
+
+  static node_ptrt mk_node(const node_ptrt &parent, const expr2tc &expr);
+  static nodet *common_prefix(nodet *a, nodet *b);
+  void append_suffix(const nodet *from, const nodet *prefix);
 
   bool is_single_symbol() const;
   void clear();
   void clear_append(const guardt &guard);
   void clear_insert(const expr2tc &expr);
-
-  void build_guard_expr();
 };
 
 #endif
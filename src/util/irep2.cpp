@@ -1,6 +1,7 @@
 #include <memory>
 #include <ac_config.h>
 #include <boost/functional/hash.hpp>
+#include <unordered_set>
 #include <util/fixedbv.h>
 #include <util/i2string.h>
 #include <util/ieee_float.h>
@@ -142,6 +143,12 @@ void type2t::hash(crypto_hash &hash) const
   hash.ingest(&tid, sizeof(tid));
 }
 
+void type2t::hash(fast_hash &hash) const
+{
+  uint8_t tid = type_id;
+  hash.ingest(&tid, sizeof(tid));
+}
+
 unsigned int bool_type2t::get_width() const
 {
   // For the purpose of the byte representating memory model
@@ -302,6 +309,94 @@ auto type2t_traits<Args...>::make_contained(typename Args::result_type... args)
 }
 } // namespace esbmct
 
+/******************************* Hash-consing *******************************/
+
+bool irep2_hash_consing = false;
+
+namespace
+{
+/* Canonical instances of the ireps built while hash-consing is enabled. The
+ * table owns a reference to each of them; whenever it has doubled in size,
+ * entries that nobody else refers to any more are swept. */
+template <typename T>
+class intern_tablet
+{
+public:
+  void intern(std::shared_ptr<T> &p)
+  {
+    auto it = table.find(p);
+    if(it != table.end())
+    {
+      p = *it;
+      return;
+    }
+
+    if(table.size() >= sweep_at)
+      sweep();
+    table.insert(p);
+  }
+
+  size_t size() const
+  {
+    return table.size();
+  }
+
+protected:
+  struct hasht
+  {
+    size_t operator()(const std::shared_ptr<T> &p) const
+    {
+      return p->crc();
+    }
+  };
+
+  struct eqt
+  {
+    bool operator()(const std::shared_ptr<T> &a, const std::shared_ptr<T> &b)
+      const
+    {
+      return a == b || *a == *b;
+    }
+  };
+
+  void sweep()
+  {
+    for(auto it = table.begin(); it != table.end();)
+    {
+      if(it->use_count() == 1)
+        it = table.erase(it);
+      else
+        ++it;
+    }
+
+    sweep_at = std::max(table.size() * 2, sweep_at);
+  }
+
+  std::unordered_set<std::shared_ptr<T>, hasht, eqt> table;
+  size_t sweep_at = 1 << 16;
+};
+
+// Deliberately never destroyed: tearing down every interned irep at exit
+// would only cost time.
+intern_tablet<type2t> &type_intern_table = *new intern_tablet<type2t>();
+intern_tablet<expr2t> &expr_intern_table = *new intern_tablet<expr2t>();
+} // namespace
+
+void irep2_intern(std::shared_ptr<type2t> &p)
+{
+  type_intern_table.intern(p);
+}
+
+void irep2_intern(std::shared_ptr<expr2t> &p)
+{
+  expr_intern_table.intern(p);
+}
+
+size_t irep2_interned_count()
+{
+  return type_intern_table.size() + expr_intern_table.size();
+}
+
 /*************************** Base expr2t definitions **************************/
 
 expr2t::expr2t(const type2tc &_type, expr_ids id)
@@ -424,6 +519,13 @@ void expr2t::hash(crypto_hash &hash) const
   type->hash(hash);
 }
 
+void expr2t::hash(fast_hash &hash) const
+{
+  uint8_t eid = expr_id;
+  hash.ingest(&eid, sizeof(eid));
+  type->hash(hash);
+}
+
 static const char *expr_names[] = {
   "constant_int",
   "constant_fixedbv",
@@ -1326,8 +1428,9 @@ do_type_crc(const bool &theval)
   return boost::hash<bool>()(theval);
 }
 
+template <typename H>
 static inline __attribute__((always_inline)) void
-do_type_hash(const bool &thebool, crypto_hash &hash)
+do_type_hash(const bool &thebool, H &hash)
 {
   if(thebool)
   {
@@ -1347,8 +1450,9 @@ do_type_crc(const unsigned int &theval)
   return boost::hash<unsigned int>()(theval);
 }
 
+template <typename H>
 static inline __attribute__((always_inline)) void
-do_type_hash(const unsigned int &theval, crypto_hash &hash)
+do_type_hash(const unsigned int &theval, H &hash)
 {
   hash.ingest((void *)&theval, sizeof(theval));
 }
@@ -1359,8 +1463,9 @@ do_type_crc(const sideeffect_data::allockind &theval)
   return boost::hash<uint8_t>()(theval);
 }
 
+template <typename H>
 static inline __attribute__((always_inline)) void
-do_type_hash(const sideeffect_data::allockind &theval, crypto_hash &hash)
+do_type_hash(const sideeffect_data::allockind &theval, H &hash)
 {
   hash.ingest((void *)&theval, sizeof(theval));
 }
@@ -1371,8 +1476,9 @@ do_type_crc(const symbol_data::renaming_level &theval)
   return boost::hash<uint8_t>()(theval);
 }
 
+template <typename H>
 static inline __attribute__((always_inline)) void
-do_type_hash(const symbol_data::renaming_level &theval, crypto_hash &hash)
+do_type_hash(const symbol_data::renaming_level &theval, H &hash)
 {
   hash.ingest((void *)&theval, sizeof(theval));
 }
@@ -1400,8 +1506,9 @@ do_type_crc(const BigInt &theint)
   return crc;
 }
 
+template <typename H>
 static inline __attribute__((always_inline)) void
-do_type_hash(const BigInt &theint, crypto_hash &hash)
+do_type_hash(const BigInt &theint, H &hash)
 {
   // Zero has no data in bigints.
   if(theint.is_zero())
@@ -1431,8 +1538,9 @@ do_type_crc(const fixedbvt &theval)
   return do_type_crc(BigInt(theval.to_ansi_c_string().c_str()));
 }
 
+template <typename H>
 static inline __attribute__((always_inline)) void
-do_type_hash(const fixedbvt &theval, crypto_hash &hash)
+do_type_hash(const fixedbvt &theval, H &hash)
 {
   do_type_hash(BigInt(theval.to_ansi_c_string().c_str()), hash);
 }
@@ -1443,8 +1551,9 @@ do_type_crc(const ieee_floatt &theval)
   return do_type_crc(theval.pack());
 }
 
+template <typename H>
 static inline __attribute__((always_inline)) void
-do_type_hash(const ieee_floatt &theval, crypto_hash &hash)
+do_type_hash(const ieee_floatt &theval, H &hash)
 {
   do_type_hash(theval.pack(), hash);
 }
@@ -1459,8 +1568,9 @@ do_type_crc(const std::vector<expr2tc> &theval)
   return crc;
 }
 
+template <typename H>
 static inline __attribute__((always_inline)) void
-do_type_hash(const std::vector<expr2tc> &theval, crypto_hash &hash)
+do_type_hash(const std::vector<expr2tc> &theval, H &hash)
 {
   for(auto const &it : theval)
     it->hash(hash);
@@ -1476,8 +1586,9 @@ do_type_crc(const std::vector<type2tc> &theval)
   return crc;
 }
 
+template <typename H>
 static inline __attribute__((always_inline)) void
-do_type_hash(const std::vector<type2tc> &theval, crypto_hash &hash)
+do_type_hash(const std::vector<type2tc> &theval, H &hash)
 {
   for(auto const &it : theval)
     it->hash(hash);
@@ -1493,8 +1604,9 @@ do_type_crc(const std::vector<irep_idt> &theval)
   return crc;
 }
 
+template <typename H>
 static inline __attribute__((always_inline)) void
-do_type_hash(const std::vector<irep_idt> &theval, crypto_hash &hash)
+do_type_hash(const std::vector<irep_idt> &theval, H &hash)
 {
   for(auto const &it : theval)
     hash.ingest((void *)it.as_string().c_str(), it.as_string().size());
@@ -1508,8 +1620,9 @@ do_type_crc(const expr2tc &theval)
   return boost::hash<uint8_t>()(0);
 }
 
+template <typename H>
 static inline __attribute__((always_inline)) void
-do_type_hash(const expr2tc &theval, crypto_hash &hash)
+do_type_hash(const expr2tc &theval, H &hash)
 {
   if(theval.get() != nullptr)
     theval->hash(hash);
@@ -1523,8 +1636,9 @@ do_type_crc(const type2tc &theval)
   return boost::hash<uint8_t>()(0);
 }
 
+template <typename H>
 static inline __attribute__((always_inline)) void
-do_type_hash(const type2tc &theval, crypto_hash &hash)
+do_type_hash(const type2tc &theval, H &hash)
 {
   if(theval.get() != nullptr)
     theval->hash(hash);
@@ -1536,8 +1650,9 @@ do_type_crc(const irep_idt &theval)
   return boost::hash<std::string>()(theval.as_string());
 }
 
+template <typename H>
 static inline __attribute__((always_inline)) void
-do_type_hash(const irep_idt &theval, crypto_hash &hash)
+do_type_hash(const irep_idt &theval, H &hash)
 {
   hash.ingest((void *)theval.as_string().c_str(), theval.as_string().size());
 }
@@ -1548,9 +1663,10 @@ do_type_crc(const type2t::type_ids &i)
   return boost::hash<uint8_t>()(i);
 }
 
+template <typename H>
 static inline __attribute__((always_inline)) void do_type_hash(
   const type2t::type_ids &i __attribute__((unused)),
-  crypto_hash &hash __attribute__((unused)))
+  H &hash __attribute__((unused)))
 {
   // Dummy field crc
 }
@@ -1561,9 +1677,10 @@ do_type_crc(const expr2t::expr_ids &i __attribute__((unused)))
   return boost::hash<uint8_t>()(i);
 }
 
+template <typename H>
 static inline __attribute__((always_inline)) void do_type_hash(
   const expr2t::expr_ids &i __attribute__((unused)),
-  crypto_hash &hash __attribute__((unused)))
+  H &hash __attribute__((unused)))
 {
   // Dummy field crc
 }
@@ -2019,6 +2136,20 @@ void esbmct::
   hash_rec(hash); // _includes_ type_id / expr_id
 }
 
+template <
+  class derived,
+  class baseclass,
+  typename traits,
+  typename container,
+  typename enable,
+  typename fields>
+void esbmct::
+  irep_methods2<derived, baseclass, traits, container, enable, fields>::hash(
+    fast_hash &hash) const
+{
+  hash_rec(hash); // _includes_ type_id / expr_id
+}
+
 // The, *actual* recursive defs
 
 template <
@@ -2137,6 +2268,24 @@ void esbmct::
   superclass::hash_rec(hash);
 }
 
+template <
+  class derived,
+  class baseclass,
+  typename traits,
+  typename container,
+  typename enable,
+  typename fields>
+void esbmct::
+  irep_methods2<derived, baseclass, traits, container, enable, fields>::
+    hash_rec(fast_hash &hash) const
+{
+  const derived *derived_this = static_cast<const derived *>(this);
+  auto m_ptr = membr_ptr::value;
+  do_type_hash(derived_this->*m_ptr, hash);
+
+  superclass::hash_rec(hash);
+}
+
 template <
   class derived,
   class baseclass,
@@ -30,6 +30,7 @@
 #include <util/config.h>
 #include <util/crypto_hash.h>
 #include <util/dstring.h>
+#include <util/fast_hash.h>
 #include <util/irep.h>
 #include <vector>
 
@@ -291,6 +292,19 @@ public:
 typedef irep_container<type2t> type2tc;
 typedef irep_container<expr2t> expr2tc;
 
+/** Hash-consing of irep2 objects, off by default (see --hash-consing).
+ *  While enabled, every type and expression built through one of the
+ *  something2tc constructors is replaced by a canonical instance shared with
+ *  every structurally equal one built before it, so that equal ireps are
+ *  usually the same object and compare equal by pointer. Canonical instances
+ *  are never modified in place: as they are always shared with the intern
+ *  table, irep_container::detach copies them before any write. */
+extern bool irep2_hash_consing;
+void irep2_intern(std::shared_ptr<type2t> &p);
+void irep2_intern(std::shared_ptr<expr2t> &p);
+/** Number of canonical types and expressions currently held. */
+size_t irep2_interned_count();
+
 typedef std::pair<std::string, std::string> member_entryt;
 typedef std::list<member_entryt> list_of_memberst;
 
@@ -465,6 +479,12 @@ public:
    */
   virtual void hash(crypto_hash &hash) const;
 
+  /** Perform hash operation accumulating into a fast_hash.
+   *  Identical to the crypto_hash version, for state hashing.
+   *  @param hash Object to accumulate hash data into.
+   */
+  virtual void hash(fast_hash &hash) const;
+
   /** Clone method. Self explanatory.
    *  @return New container, containing a duplicate of this object.
    */
@@ -667,6 +687,12 @@ public:
    */
   virtual void hash(crypto_hash &hash) const;
 
+  /** Perform hash operation accumulating into a fast_hash.
+   *  Identical to the crypto_hash version, for state hashing.
+   *  @param hash Object to accumulate hash data into.
+   */
+  virtual void hash(fast_hash &hash) const;
+
   /** Fetch a sub-operand.
    *  These can come out of any field that is an expr2tc, or contains them.
    *  No particular numbering order is promised.
@@ -1102,6 +1128,7 @@ public:
   int lt(const base2t &ref) const override;
   size_t do_crc() const override;
   void hash(crypto_hash &hash) const override;
+  void hash(fast_hash &hash) const override;
 
 protected:
   // Fetch the type information about the field we are concerned with out
@@ -1119,6 +1146,7 @@ protected:
   int lt_rec(const base2t &ref) const;
   void do_crc_rec() const;
   void hash_rec(crypto_hash &hash) const;
+  void hash_rec(fast_hash &hash) const;
 
   // These methods are specific to expressions rather than types, and are
   // placed here to avoid un-necessary recursion in expr_methods2.
@@ -1201,6 +1229,11 @@ protected:
     (void)hash;
   }
 
+  void hash_rec(fast_hash &hash) const
+  {
+    (void)hash;
+  }
+
   const expr2tc *
   get_sub_expr_rec(unsigned int cur_idx, unsigned int desired) const
   {
@@ -1399,6 +1432,8 @@ public:
   template <typename... Args>
   something2tc(Args... args) : base2tc(new contained(args...))
   {
+    if(irep2_hash_consing)
+      irep2_intern(*this);
   }
 
   typedef irep_container<base> base_container;
@@ -1446,6 +1481,10 @@ inline bool operator==(const type2tc &a, const type2tc &b)
   if(is_nil_type(a) || is_nil_type(b))
     return false;
 
+  // Shared (and, when hash-consing, canonical) objects are trivially equal.
+  if(a.get() == b.get())
+    return true;
+
   return (*a.get() == *b.get());
 }
 
@@ -1479,6 +1518,10 @@ inline bool operator==(const expr2tc &a, const expr2tc &b)
   if(is_nil_expr(a) || is_nil_expr(b))
     return false;
 
+  // Shared (and, when hash-consing, canonical) objects are trivially equal.
+  if(a.get() == b.get())
+    return true;
+
   return (*a.get() == *b.get());
 }
 
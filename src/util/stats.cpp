@@ -0,0 +1,326 @@
+/*******************************************************************\
+
+Module: Resource accounting
+
+\*******************************************************************/
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <istream>
+#include <ostream>
+#include <util/stats.h>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+statst stats;
+
+static fine_timet cpu_time()
+{
+#ifndef _WIN32
+  struct rusage usage;
+  if(getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+
+  return (fine_timet)(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000 +
+         (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000;
+#else
+  return 0;
+#endif
+}
+
+/// A field of /proc/self/status in kilobytes, zero if there is none
+static unsigned long proc_status_kb(const std::string &field)
+{
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while(std::getline(status, line))
+    if(line.compare(0, field.size(), field) == 0 && line[field.size()] == ':')
+      return strtoul(line.c_str() + field.size() + 1, nullptr, 10);
+
+  return 0;
+}
+
+/// The peak resident set size since the last reset_peak_rss
+static unsigned long peak_rss()
+{
+  unsigned long peak = proc_status_kb("VmHWM");
+#ifndef _WIN32
+  if(peak == 0)
+  {
+    // No procfs: the peak of the whole process is the best there is
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) == 0)
+      peak = usage.ru_maxrss;
+  }
+#endif
+  return peak;
+}
+
+/// Makes the kernel's high-water mark start again from the current RSS, on
+/// Linux 4.0 and later. Elsewhere phases see the peak of the process so far.
+static void reset_peak_rss()
+{
+  std::ofstream clear_refs("/proc/self/clear_refs");
+  clear_refs << "5";
+}
+
+void statst::add_count(const std::string &name, unsigned long long n)
+{
+  counts[name] += n;
+}
+
+void statst::set_count(const std::string &name, unsigned long long n)
+{
+  counts[name] = n;
+}
+
+void statst::add_solver_stats(
+  const std::string &solver,
+  const std::vector<std::pair<std::string, std::string>> &values)
+{
+  solver_stats.emplace_back(solver, values);
+}
+
+statst::phaset &statst::get_phase(const std::string &name)
+{
+  for(auto &phase : phases)
+    if(phase.first == name)
+      return phase.second;
+
+  phases.emplace_back(name, phaset());
+  return phases.back().second;
+}
+
+unsigned long statst::get_peak_rss() const
+{
+  return std::max(process_peak, peak_rss());
+}
+
+static void output_string(std::ostream &out, const std::string &s)
+{
+  out << '"';
+  for(char c : s)
+  {
+    switch(c)
+    {
+    case '"':
+      out << "\\\"";
+      break;
+    case '\\':
+      out << "\\\\";
+      break;
+    case '\n':
+      out << "\\n";
+      break;
+    case '\t':
+      out << "\\t";
+      break;
+    default:
+      if((unsigned char)c < 0x20)
+        out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (int)c
+            << std::dec << std::setfill(' ');
+      else
+        out << c;
+    }
+  }
+  out << '"';
+}
+
+static void output_value(std::ostream &out, const std::string &value)
+{
+  char *end = nullptr;
+  strtod(value.c_str(), &end);
+  bool number = !value.empty() && end == value.c_str() + value.size() &&
+                value.find_first_not_of("0123456789+-.eE") == std::string::npos;
+
+  if(number)
+    out << value;
+  else
+    output_string(out, value);
+}
+
+void statst::output_json(std::ostream &out) const
+{
+  out << "{\n  \"phases\": {";
+  for(auto it = phases.begin(); it != phases.end(); it++)
+  {
+    const phaset &phase = it->second;
+    out << (it == phases.begin() ? "\n" : ",\n") << "    ";
+    output_string(out, it->first);
+    out << ": {\"runs\": " << phase.runs
+        << ", \"wall_ms\": " << phase.wall << ", \"cpu_ms\": " << phase.cpu
+        << ", \"peak_rss_kb\": " << phase.peak_rss << "}";
+  }
+  out << "\n  },\n  \"counts\": {";
+  for(auto it = counts.begin(); it != counts.end(); it++)
+  {
+    out << (it == counts.begin() ? "\n" : ",\n") << "    ";
+    output_string(out, it->first);
+    out << ": " << it->second;
+  }
+  out << "\n  },\n  \"solver\": [";
+  for(auto it = solver_stats.begin(); it != solver_stats.end(); it++)
+  {
+    out << (it == solver_stats.begin() ? "\n" : ",\n") << "    {\"name\": ";
+    output_string(out, it->first);
+    for(const auto &value : it->second)
+    {
+      out << ", ";
+      output_string(out, value.first);
+      out << ": ";
+      output_value(out, value.second);
+    }
+    out << "}";
+  }
+  out << "\n  ],\n  \"peak_rss_kb\": " << get_peak_rss()
+      << ",\n  \"cpu_ms\": " << cpu_time() << "\n}\n";
+}
+
+void statst::clear()
+{
+  phases.clear();
+  counts.clear();
+  solver_stats.clear();
+}
+
+// Strings are written length first, so they may hold any character
+static void save_string(std::ostream &out, const std::string &s)
+{
+  out << ' ' << s.size() << ':' << s;
+}
+
+static bool merge_string(std::istream &in, std::string &s)
+{
+  size_t len;
+  char colon;
+  if(!(in >> len) || !in.get(colon) || colon != ':')
+    return true;
+
+  s.resize(len);
+  return len != 0 && !in.read(&s[0], len);
+}
+
+void statst::save(std::ostream &out) const
+{
+  for(const auto &phase : phases)
+  {
+    out << "phase " << phase.second.runs << ' ' << phase.second.wall << ' '
+        << phase.second.cpu << ' ' << phase.second.peak_rss;
+    save_string(out, phase.first);
+    out << '\n';
+  }
+
+  for(const auto &count : counts)
+  {
+    out << "count " << count.second;
+    save_string(out, count.first);
+    out << '\n';
+  }
+
+  for(const auto &solver : solver_stats)
+  {
+    out << "solver " << solver.second.size();
+    save_string(out, solver.first);
+    for(const auto &value : solver.second)
+    {
+      save_string(out, value.first);
+      save_string(out, value.second);
+    }
+    out << '\n';
+  }
+}
+
+bool statst::merge(std::istream &in)
+{
+  std::string kind;
+  while(in >> kind)
+  {
+    std::string name;
+    if(kind == "phase")
+    {
+      phaset p;
+      if(
+        !(in >> p.runs >> p.wall >> p.cpu >> p.peak_rss) ||
+        merge_string(in, name))
+        return true;
+
+      phaset &phase = get_phase(name);
+      phase.runs += p.runs;
+      phase.wall += p.wall;
+      phase.cpu += p.cpu;
+      phase.peak_rss = std::max(phase.peak_rss, p.peak_rss);
+    }
+    else if(kind == "count")
+    {
+      unsigned long long n;
+      if(!(in >> n) || merge_string(in, name))
+        return true;
+
+      counts[name] += n;
+    }
+    else if(kind == "solver")
+    {
+      size_t num_values;
+      if(!(in >> num_values) || merge_string(in, name))
+        return true;
+
+      std::vector<std::pair<std::string, std::string>> values(num_values);
+      for(auto &value : values)
+        if(merge_string(in, value.first) || merge_string(in, value.second))
+          return true;
+
+      solver_stats.emplace_back(name, values);
+    }
+    else
+      return true;
+  }
+
+  return !in.eof();
+}
+
+stats_phaset::stats_phaset(const std::string &_name)
+  : name(_name), running(stats.enabled), wall_start(0), cpu_start(0)
+{
+  if(!running)
+    return;
+
+  wall_start = current_time();
+  cpu_start = cpu_time();
+
+  unsigned long peak = peak_rss();
+  stats.process_peak = std::max(stats.process_peak, peak);
+  if(!stats.open_peaks.empty())
+    stats.open_peaks.back() = std::max(stats.open_peaks.back(), peak);
+
+  // The mark starts again from the current RSS, which it covers from now on
+  reset_peak_rss();
+  stats.open_peaks.push_back(0);
+}
+
+stats_phaset::~stats_phaset()
+{
+  stop();
+}
+
+void stats_phaset::stop()
+{
+  if(!running)
+    return;
+  running = false;
+
+  unsigned long peak = std::max(stats.open_peaks.back(), peak_rss());
+  stats.process_peak = std::max(stats.process_peak, peak);
+  stats.open_peaks.pop_back();
+  if(!stats.open_peaks.empty())
+    stats.open_peaks.back() = std::max(stats.open_peaks.back(), peak);
+
+  statst::phaset &phase = stats.get_phase(name);
+  phase.runs++;
+  phase.wall += current_time() - wall_start;
+  phase.cpu += cpu_time() - cpu_start;
+  phase.peak_rss = std::max(phase.peak_rss, peak);
+}
@@ -0,0 +1,117 @@
+/*******************************************************************\
+
+Module: Resource accounting
+
+\*******************************************************************/
+
+#ifndef CPROVER_STATS_H
+#define CPROVER_STATS_H
+
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include <util/time_stopping.h>
+
+/** Resource accounting, written out by --stats-json. Phases of a run
+ *  (parsing, symex, solving, ...) record their wall and CPU time and the
+ *  peak resident set size reached while they ran, other parts of ESBMC bump
+ *  named counters, and solvers add the statistics they report themselves.
+ *  Phases are only timed once enabled is set: measuring their peak resets
+ *  the kernel's high-water mark (VmHWM in /proc/self/status), which would
+ *  otherwise be the peak of the whole process. Only this process is
+ *  accounted for: a forked worker keeps its own, which is lost when it
+ *  exits unless it saves it for its parent to merge. */
+class statst
+{
+public:
+  statst() : enabled(false), process_peak(0)
+  {
+  }
+
+  bool enabled;
+
+  struct phaset
+  {
+    phaset() : runs(0), wall(0), cpu(0), peak_rss(0)
+    {
+    }
+
+    unsigned runs;
+    fine_timet wall;        // milliseconds
+    fine_timet cpu;         // milliseconds, user and system, all threads
+    unsigned long peak_rss; // kilobytes, the largest of any run
+  };
+
+  void add_count(const std::string &name, unsigned long long n = 1);
+  void set_count(const std::string &name, unsigned long long n);
+
+  /** Statistics a solver reports about one call to dec_solve. Values that
+   *  read as numbers are written as JSON numbers, others as strings. */
+  void add_solver_stats(
+    const std::string &solver,
+    const std::vector<std::pair<std::string, std::string>> &values);
+
+  /** The peak resident set size of the process so far, in kilobytes. Use
+   *  this rather than VmHWM while enabled. */
+  unsigned long get_peak_rss() const;
+
+  void output_json(std::ostream &out) const;
+
+  /** Forgets everything accounted so far, as a forked worker does before it
+   *  starts on work its parent doesn't account for itself. */
+  void clear();
+
+  /** Writes the phases, counts and solver statistics accounted so far in
+   *  the form merge reads. */
+  void save(std::ostream &out) const;
+
+  /** Adds statistics written by save, e.g. in a worker process, to these.
+   *  Returns true if they can't be read. */
+  bool merge(std::istream &in);
+
+protected:
+  friend class stats_phaset;
+
+  phaset &get_phase(const std::string &name);
+
+  // in the order they first ran
+  std::vector<std::pair<std::string, phaset>> phases;
+  std::map<std::string, unsigned long long> counts;
+  std::vector<
+    std::pair<std::string, std::vector<std::pair<std::string, std::string>>>>
+    solver_stats;
+
+  // The peak RSS seen so far by each phase running now, innermost last. A
+  // phase resets the kernel's high-water mark when it starts, so it folds the
+  // mark into the phase around it first, and its own peak when it stops.
+  std::vector<unsigned long> open_peaks;
+  // the high-water mark as it was before each reset
+  unsigned long process_peak;
+};
+
+extern statst stats;
+
+/** Accounts the time from its construction to stop(), or its destruction,
+ *  to the named phase. Phases may nest; an inner phase counts towards the
+ *  outer one too. Does nothing unless stats.enabled is set. */
+class stats_phaset
+{
+public:
+  explicit stats_phaset(const std::string &name);
+  ~stats_phaset();
+
+  void stop();
+
+  stats_phaset(const stats_phaset &) = delete;
+  stats_phaset &operator=(const stats_phaset &) = delete;
+
+protected:
+  std::string name;
+  bool running;
+  fine_timet wall_start;
+  fine_timet cpu_start;
+};
+
+#endif
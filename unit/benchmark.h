@@ -0,0 +1,200 @@
+/*******************************************************************
+ Module: Micro-benchmark harness
+
+ A small stand-in for Google Benchmark, so that the benchmark targets
+ build without another dependency. A benchmark is a function that does
+ its setup, then loops while state.keep_running() holds; the harness
+ raises the iteration count until a run lasts at least --min-time and
+ reports the time per iteration.
+
+ This header defines main(): include it from one file per executable.
+ Benchmarks that build irep2 expressions or types define BENCHMARK_IREP2
+ first, so that main() sets up the type pool.
+
+ Usage: <benchmark> [--filter=substring] [--min-time=seconds]
+ With --min-time=0 every benchmark runs once, as a smoke test.
+ \*******************************************************************/
+
+#ifndef ESBMC_UNIT_BENCHMARK_H
+#define ESBMC_UNIT_BENCHMARK_H
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef BENCHMARK_IREP2
+#include <util/irep2_type.h>
+#endif
+
+class benchmark_statet
+{
+public:
+  explicit benchmark_statet(unsigned long _iterations)
+    : iterations(_iterations), remaining(_iterations), elapsed(0), items(0)
+  {
+  }
+
+  // The timer starts on the first call, and stops on the last one
+  bool keep_running()
+  {
+    if(remaining == iterations)
+      resume_timing();
+
+    if(remaining == 0)
+    {
+      pause_timing();
+      return false;
+    }
+
+    --remaining;
+    return true;
+  }
+
+  // Keep per-iteration setup out of the measurement
+  void pause_timing()
+  {
+    elapsed += std::chrono::steady_clock::now() - start;
+  }
+
+  void resume_timing()
+  {
+    start = std::chrono::steady_clock::now();
+  }
+
+  // Work items done per iteration, reported as a rate
+  void set_items_per_iteration(unsigned long n)
+  {
+    items = n;
+  }
+
+  unsigned long items_per_iteration() const
+  {
+    return items;
+  }
+
+  double seconds() const
+  {
+    return std::chrono::duration<double>(elapsed).count();
+  }
+
+  const unsigned long iterations;
+
+protected:
+  unsigned long remaining;
+  std::chrono::steady_clock::time_point start;
+  std::chrono::steady_clock::duration elapsed;
+  unsigned long items;
+};
+
+// Stops the compiler from discarding a value that is computed but not used
+template <typename T>
+inline void do_not_optimize(const T &value)
+{
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+typedef std::function<void(benchmark_statet &)> benchmark_functiont;
+
+inline std::vector<std::pair<std::string, benchmark_functiont>> &benchmarks()
+{
+  static std::vector<std::pair<std::string, benchmark_functiont>> list;
+  return list;
+}
+
+inline int register_benchmark(const char *name, benchmark_functiont f)
+{
+  benchmarks().emplace_back(name, f);
+  return 0;
+}
+
+#define BENCHMARK(f) static int f##_registered = register_benchmark(#f, f)
+
+inline int run_benchmarks(int argc, const char **argv)
+{
+  std::string filter;
+  double min_time = 0.5;
+  for(int i = 1; i < argc; i++)
+  {
+    if(!strncmp(argv[i], "--filter=", 9))
+      filter = argv[i] + 9;
+    else if(!strncmp(argv[i], "--min-time=", 11))
+      min_time = atof(argv[i] + 11);
+    else
+    {
+      fprintf(
+        stderr,
+        "Usage: %s [--filter=substring] [--min-time=seconds]\n",
+        argv[0]);
+      return 1;
+    }
+  }
+
+  printf(
+    "%-40s %14s %12s %14s\n",
+    "benchmark",
+    "time/iter",
+    "iterations",
+    "items/s");
+  for(const auto &b : benchmarks())
+  {
+    if(b.first.find(filter) == std::string::npos)
+      continue;
+
+    unsigned long iterations = 1;
+    for(;;)
+    {
+      benchmark_statet state(iterations);
+      b.second(state);
+      double secs = state.seconds();
+
+      if(secs >= min_time || iterations >= 1000000000UL)
+      {
+        double per_iter = secs / iterations;
+        const char *unit = "ns";
+        double scaled = per_iter * 1e9;
+        if(scaled >= 1e6)
+        {
+          unit = "ms";
+          scaled /= 1e6;
+        }
+        else if(scaled >= 1e3)
+        {
+          unit = "us";
+          scaled /= 1e3;
+        }
+
+        printf(
+          "%-40s %11.1f %s %12lu", b.first.c_str(), scaled, unit, iterations);
+        if(state.items_per_iteration() && secs > 0)
+          printf(" %14.0f", state.items_per_iteration() * iterations / secs);
+        printf("\n");
+        break;
+      }
+
+      // Aim a little past min_time, growing at most tenfold per attempt
+      double factor = secs > 0 ? 1.4 * min_time / secs : 10;
+      factor = factor < 2 ? 2 : (factor > 10 ? 10 : factor);
+      iterations = (unsigned long)(iterations * factor);
+    }
+  }
+
+  return 0;
+}
+
+int main(int argc, const char **argv)
+{
+#ifdef BENCHMARK_IREP2
+  // To avoid the static initialization order fiasco:
+  type_poolt bees(true);
+  type_pool = bees;
+#endif
+
+  return run_benchmarks(argc, argv);
+}
+
+#endif /* ESBMC_UNIT_BENCHMARK_H */
@@ -0,0 +1,127 @@
+/*******************************************************************
+ Module: BigInt benchmark
+
+ BigInt arithmetic as the rest of ESBMC does it: mostly on values that
+ fit a machine word (constant folding, bit-vector widths), sometimes on
+ wide ones (128-bit types, all-ones masks, power-of-two tables).
+ \*******************************************************************/
+
+#include <benchmark.h>
+#include <big-int/bigint.hh>
+#include <vector>
+
+namespace
+{
+std::vector<BigInt> small_values()
+{
+  std::vector<BigInt> v;
+  for(long i = 1; i <= 64; i++)
+    v.emplace_back(i * 977 - 31000);
+  return v;
+}
+
+std::vector<BigInt> wide_values()
+{
+  std::vector<BigInt> v;
+  BigInt x("340282366920938463463374607431768211455"); // 2^128 - 1
+  for(unsigned i = 1; i <= 64; i++)
+    v.push_back(x / i + i);
+  return v;
+}
+
+void bigint_add_small(benchmark_statet &state)
+{
+  std::vector<BigInt> v = small_values();
+  while(state.keep_running())
+  {
+    BigInt sum;
+    for(const BigInt &x : v)
+      sum += x;
+    do_not_optimize(sum);
+  }
+  state.set_items_per_iteration(v.size());
+}
+BENCHMARK(bigint_add_small);
+
+void bigint_mul_small(benchmark_statet &state)
+{
+  std::vector<BigInt> v = small_values();
+  while(state.keep_running())
+  {
+    for(unsigned i = 1; i < v.size(); i++)
+      do_not_optimize(v[i - 1] * v[i]);
+  }
+  state.set_items_per_iteration(v.size() - 1);
+}
+BENCHMARK(bigint_mul_small);
+
+void bigint_divmod_small(benchmark_statet &state)
+{
+  std::vector<BigInt> v = small_values();
+  while(state.keep_running())
+  {
+    for(unsigned i = 1; i < v.size(); i++)
+    {
+      do_not_optimize(v[i - 1] / v[i]);
+      do_not_optimize(v[i - 1] % v[i]);
+    }
+  }
+  state.set_items_per_iteration(2 * (v.size() - 1));
+}
+BENCHMARK(bigint_divmod_small);
+
+void bigint_compare_small(benchmark_statet &state)
+{
+  std::vector<BigInt> v = small_values();
+  while(state.keep_running())
+  {
+    int c = 0;
+    for(unsigned i = 1; i < v.size(); i++)
+      c += v[i - 1].compare(v[i]);
+    do_not_optimize(c);
+  }
+  state.set_items_per_iteration(v.size() - 1);
+}
+BENCHMARK(bigint_compare_small);
+
+void bigint_mul_wide(benchmark_statet &state)
+{
+  std::vector<BigInt> v = wide_values();
+  while(state.keep_running())
+  {
+    for(unsigned i = 1; i < v.size(); i++)
+      do_not_optimize(v[i - 1] * v[i]);
+  }
+  state.set_items_per_iteration(v.size() - 1);
+}
+BENCHMARK(bigint_mul_wide);
+
+void bigint_divmod_wide(benchmark_statet &state)
+{
+  std::vector<BigInt> v = wide_values();
+  BigInt divisor(1000000007);
+  while(state.keep_running())
+  {
+    for(const BigInt &x : v)
+    {
+      do_not_optimize(x / divisor);
+      do_not_optimize(x % divisor);
+    }
+  }
+  state.set_items_per_iteration(2 * v.size());
+}
+BENCHMARK(bigint_divmod_wide);
+
+void bigint_to_string(benchmark_statet &state)
+{
+  std::vector<BigInt> v = wide_values();
+  std::vector<char> buf(v[0].digits() + 2);
+  while(state.keep_running())
+  {
+    for(const BigInt &x : v)
+      do_not_optimize(x.as_string(buf.data(), buf.size()));
+  }
+  state.set_items_per_iteration(v.size());
+}
+BENCHMARK(bigint_to_string);
+} // namespace
@@ -0,0 +1,140 @@
+/*******************************************************************
+ Module: level2t benchmark
+
+ SSA renaming as symex does it: every expression read is renamed to the
+ current level2 names, every assignment bumps a name, and every goto
+ state snapshot clones the level2 map before writing to it.
+ \*******************************************************************/
+
+#define BENCHMARK_IREP2
+#include <benchmark.h>
+#include <goto-symex/renaming.h>
+#include <langapi/mode.h>
+#include <memory>
+#include <string>
+#include <util/irep2_utils.h>
+#include <vector>
+
+namespace
+{
+class bench_level2t : public renaming::level2t
+{
+public:
+  using renaming::level2t::rename;
+
+  std::shared_ptr<renaming::level2t> clone() const override
+  {
+    return std::make_shared<bench_level2t>(*this);
+  }
+
+  void rename(expr2tc &lhs_sym, unsigned count) override
+  {
+    coveredinbees(lhs_sym, count, 0);
+  }
+};
+
+const unsigned int num_vars = 1024;
+
+expr2tc l1_symbol(unsigned int n)
+{
+  return symbol2tc(
+    get_int_type(32),
+    "c:@F@main@x" + std::to_string(n),
+    symbol2t::level1,
+    1,
+    0,
+    0,
+    0);
+}
+
+// Every variable assigned once, and one in eight to a constant
+void assign_all(bench_level2t &level2, const std::vector<expr2tc> &vars)
+{
+  for(unsigned int i = 0; i < vars.size(); i++)
+  {
+    expr2tc lhs = vars[i];
+    expr2tc value = constant_int2tc(get_int_type(32), BigInt(i));
+    level2.make_assignment(lhs, i % 8 == 0 ? value : expr2tc(), value);
+  }
+}
+
+std::vector<expr2tc> l1_symbols()
+{
+  std::vector<expr2tc> vars;
+  for(unsigned int i = 0; i < num_vars; i++)
+    vars.push_back(l1_symbol(i));
+  return vars;
+}
+
+void level2_rename_symbol(benchmark_statet &state)
+{
+  std::vector<expr2tc> vars = l1_symbols();
+  bench_level2t level2;
+  assign_all(level2, vars);
+
+  while(state.keep_running())
+  {
+    for(const expr2tc &var : vars)
+    {
+      expr2tc e = var;
+      level2.rename(e);
+      do_not_optimize(e);
+    }
+  }
+  state.set_items_per_iteration(vars.size());
+}
+BENCHMARK(level2_rename_symbol);
+
+void level2_rename_expr(benchmark_statet &state)
+{
+  // A right hand side reading 64 variables
+  std::vector<expr2tc> vars = l1_symbols();
+  bench_level2t level2;
+  assign_all(level2, vars);
+
+  expr2tc rhs = vars[0];
+  for(unsigned int i = 1; i < 64; i++)
+    rhs = add2tc(get_int_type(32), rhs, vars[i * 16]);
+
+  while(state.keep_running())
+  {
+    expr2tc e = rhs;
+    level2.rename(e);
+    do_not_optimize(e);
+  }
+  state.set_items_per_iteration(64);
+}
+BENCHMARK(level2_rename_expr);
+
+void level2_make_assignment(benchmark_statet &state)
+{
+  std::vector<expr2tc> vars = l1_symbols();
+  bench_level2t level2;
+
+  while(state.keep_running())
+    assign_all(level2, vars);
+  state.set_items_per_iteration(vars.size());
+}
+BENCHMARK(level2_make_assignment);
+
+void level2_snapshot_and_assign(benchmark_statet &state)
+{
+  // A goto state taken at a branch, then one assignment on the new path
+  std::vector<expr2tc> vars = l1_symbols();
+  bench_level2t level2;
+  assign_all(level2, vars);
+
+  unsigned int i = 0;
+  expr2tc value = gen_zero(get_int_type(32));
+  while(state.keep_running())
+  {
+    std::shared_ptr<renaming::level2t> snapshot = level2.clone();
+    expr2tc lhs = vars[i++ % vars.size()];
+    snapshot->make_assignment(lhs, expr2tc(), value);
+    do_not_optimize(snapshot);
+  }
+}
+BENCHMARK(level2_snapshot_and_assign);
+} // namespace
+
+const mode_table_et mode_table[] = {LANGAPI_HAVE_MODE_END};
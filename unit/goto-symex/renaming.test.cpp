@@ -0,0 +1,246 @@
+/*******************************************************************
+ Module: level2t unit test
+
+ Test Plan:
+   - Assignment and lookup
+   - Copy-on-write isolation between snapshots
+   - Names whose hashes share a prefix, or collide
+   - Changed variables between snapshots
+ \*******************************************************************/
+
+#define BOOST_TEST_MODULE "Renaming"
+
+#include <boost/test/included/unit_test.hpp>
+#include <goto-symex/renaming.h>
+#include <langapi/mode.h>
+#include <memory>
+#include <set>
+#include <string>
+#include <util/irep2_utils.h>
+#include <vector>
+namespace utf = boost::unit_test;
+
+namespace
+{
+// To avoid the static initialization order fiasco
+struct type_pool_fixturet
+{
+  type_pool_fixturet() : bees(true)
+  {
+    type_pool = bees;
+  }
+
+  type_poolt bees;
+};
+
+class test_level2t : public renaming::level2t
+{
+public:
+  using renaming::level2t::rename;
+
+  std::shared_ptr<renaming::level2t> clone() const override
+  {
+    return std::make_shared<test_level2t>(*this);
+  }
+
+  void rename(expr2tc &lhs_sym, unsigned count) override
+  {
+    coveredinbees(lhs_sym, count, 0);
+  }
+};
+
+typedef renaming::level2t::name_record name_record;
+
+expr2tc l1_symbol(unsigned int n)
+{
+  return symbol2tc(
+    get_int_type(32),
+    "c:@F@main@x" + std::to_string(n),
+    symbol2t::level1,
+    1,
+    0,
+    0,
+    0);
+}
+
+name_record record(unsigned int n)
+{
+  return name_record(to_symbol2t(l1_symbol(n)));
+}
+
+// A record whose hash is forced, to place it in the trie at will
+name_record record(unsigned int n, size_t hash)
+{
+  name_record rec = record(n);
+  rec.hash = hash;
+  return rec;
+}
+
+void assign(renaming::level2t &level2, unsigned int n)
+{
+  expr2tc sym = l1_symbol(n);
+  level2.make_assignment(sym, expr2tc(), expr2tc());
+}
+
+size_t num_names(const renaming::level2t &level2)
+{
+  size_t n = 0;
+  for(auto it = level2.current_names.begin(); it != level2.current_names.end();
+      ++it)
+    n++;
+  return n;
+}
+} // namespace
+
+BOOST_GLOBAL_FIXTURE(type_pool_fixturet);
+
+// ** Assignment and lookup
+
+BOOST_AUTO_TEST_CASE(assign_and_lookup)
+{
+  test_level2t level2;
+  for(unsigned int i = 0; i < 1000; i++)
+    assign(level2, i);
+  assign(level2, 7);
+  assign(level2, 7);
+
+  BOOST_TEST(level2.current_number(record(7)) == 3);
+  BOOST_TEST(level2.current_number(record(8)) == 1);
+  BOOST_TEST(level2.current_number(record(1000)) == 0);
+  BOOST_TEST(num_names(level2) == 1000);
+
+  std::set<name_record> vars;
+  level2.get_variables(vars);
+  BOOST_TEST(vars.size() == 1000);
+  BOOST_TEST(vars.count(record(999)) == 1);
+}
+
+BOOST_AUTO_TEST_CASE(erase)
+{
+  test_level2t level2;
+  for(unsigned int i = 0; i < 100; i++)
+    assign(level2, i);
+
+  BOOST_TEST(level2.current_names.erase(record(42)) == 1);
+  BOOST_TEST(level2.current_names.erase(record(42)) == 0);
+  BOOST_TEST(level2.current_number(record(42)) == 0);
+  BOOST_TEST(num_names(level2) == 99);
+
+  for(unsigned int i = 0; i < 100; i++)
+    level2.remove(record(i));
+  BOOST_TEST(num_names(level2) == 0);
+  BOOST_TEST((level2.current_names.begin() == level2.current_names.end()));
+}
+
+// ** Copy-on-write isolation between snapshots
+
+BOOST_AUTO_TEST_CASE(snapshot_unaffected_by_writes)
+{
+  test_level2t level2;
+  for(unsigned int i = 0; i < 1000; i++)
+    assign(level2, i);
+
+  std::shared_ptr<renaming::level2t> snapshot = level2.clone();
+  assign(level2, 1);
+  assign(level2, 1000);
+  level2.current_names.erase(record(2));
+
+  BOOST_TEST(snapshot->current_number(record(1)) == 1);
+  BOOST_TEST(snapshot->current_number(record(1000)) == 0);
+  BOOST_TEST(snapshot->current_number(record(2)) == 1);
+  BOOST_TEST(num_names(*snapshot) == 1000);
+
+  BOOST_TEST(level2.current_number(record(1)) == 2);
+  BOOST_TEST(level2.current_number(record(1000)) == 1);
+  BOOST_TEST(level2.current_number(record(2)) == 0);
+  BOOST_TEST(num_names(level2) == 1000);
+}
+
+BOOST_AUTO_TEST_CASE(writes_to_snapshots_are_isolated)
+{
+  test_level2t level2;
+  for(unsigned int i = 0; i < 100; i++)
+    assign(level2, i);
+
+  std::shared_ptr<renaming::level2t> a = level2.clone();
+  std::shared_ptr<renaming::level2t> b = level2.clone();
+  assign(*a, 5);
+  assign(*b, 5);
+  assign(*b, 5);
+  b->current_names.erase(record(6));
+
+  BOOST_TEST(level2.current_number(record(5)) == 1);
+  BOOST_TEST(a->current_number(record(5)) == 2);
+  BOOST_TEST(b->current_number(record(5)) == 3);
+  BOOST_TEST(level2.current_number(record(6)) == 1);
+  BOOST_TEST(a->current_number(record(6)) == 1);
+  BOOST_TEST(b->current_number(record(6)) == 0);
+}
+
+// ** Names whose hashes share a prefix, or collide
+
+BOOST_AUTO_TEST_CASE(shared_prefixes_and_collisions)
+{
+  // The first three hashes agree on their low 20 bits, so they split
+  // several levels down; the last two are equal.
+  std::vector<name_record> recs = {
+    record(0, 0x12345),
+    record(1, 0x100012345),
+    record(2, 0x200012345),
+    record(3, 0x777),
+    record(4, 0x777)};
+
+  test_level2t level2;
+  for(unsigned int i = 0; i < recs.size(); i++)
+    level2.current_names[recs[i]].count = i + 1;
+
+  std::shared_ptr<renaming::level2t> snapshot = level2.clone();
+  level2.current_names[recs[1]].count = 10;
+  level2.current_names[recs[4]].count = 20;
+
+  for(unsigned int i = 0; i < recs.size(); i++)
+  {
+    BOOST_TEST(snapshot->current_number(recs[i]) == i + 1);
+    unsigned expected = i == 1 ? 10 : i == 4 ? 20 : i + 1;
+    BOOST_TEST(level2.current_number(recs[i]) == expected);
+  }
+
+  // Erasing down to one name of the prefix leaves it where it can be found
+  level2.current_names.erase(recs[0]);
+  level2.current_names.erase(recs[2]);
+  level2.current_names.erase(recs[3]);
+  BOOST_TEST(level2.current_number(recs[1]) == 10);
+  BOOST_TEST(level2.current_number(recs[4]) == 20);
+  BOOST_TEST(num_names(level2) == 2);
+  BOOST_TEST(num_names(*snapshot) == 5);
+}
+
+// ** Changed variables between snapshots
+
+BOOST_AUTO_TEST_CASE(changed_variables)
+{
+  test_level2t level2;
+  for(unsigned int i = 0; i < 1000; i++)
+    assign(level2, i);
+
+  // The two sides of a branch
+  std::shared_ptr<renaming::level2t> then_state = level2.clone();
+  std::shared_ptr<renaming::level2t> else_state = level2.clone();
+  assign(*then_state, 3);
+  assign(*then_state, 500);
+  assign(*else_state, 500);
+  assign(*else_state, 500);
+  assign(*else_state, 1001);
+
+  std::set<name_record> vars;
+  then_state->get_changed_variables(*else_state, vars);
+  BOOST_TEST(vars.size() == 2);
+  BOOST_TEST(vars.count(record(3)) == 1);
+  BOOST_TEST(vars.count(record(500)) == 1);
+
+  vars.clear();
+  level2.get_changed_variables(*level2.clone(), vars);
+  BOOST_TEST(vars.empty());
+}
+
+const mode_table_et mode_table[] = {LANGAPI_HAVE_MODE_END};
@@ -0,0 +1,160 @@
+/*******************************************************************
+ Module: symex_slicet::symbol_sett unit test
+
+ Test Plan:
+   - Keys of renamed symbols
+   - Insert and lookup
+   - Erase
+ \*******************************************************************/
+
+#define BOOST_TEST_MODULE "Slice"
+
+#include <boost/test/included/unit_test.hpp>
+#include <goto-symex/slice.h>
+#include <langapi/mode.h>
+#include <string>
+#include <util/irep2_utils.h>
+#include <vector>
+namespace utf = boost::unit_test;
+
+namespace
+{
+// To avoid the static initialization order fiasco
+struct type_pool_fixturet
+{
+  type_pool_fixturet() : bees(true)
+  {
+    type_pool = bees;
+  }
+
+  type_poolt bees;
+};
+
+typedef symex_slicet::symbol_keyt symbol_keyt;
+typedef symex_slicet::symbol_sett symbol_sett;
+
+expr2tc sym(
+  const std::string &name,
+  symbol2t::renaming_level lev,
+  unsigned int l1 = 0,
+  unsigned int l2 = 0,
+  unsigned int thread = 0,
+  unsigned int node = 0)
+{
+  return symbol2tc(get_int_type(32), name, lev, l1, l2, thread, node);
+}
+
+symbol_keyt key(const expr2tc &e)
+{
+  return symbol_keyt(to_symbol2t(e));
+}
+
+// One base name at every renaming level, as symex produces them
+std::vector<expr2tc> renamings(const std::string &name)
+{
+  return {
+    sym(name, symbol2t::level0),
+    sym(name, symbol2t::level1, 1, 0, 0),
+    sym(name, symbol2t::level1, 2, 0, 0),
+    sym(name, symbol2t::level1, 1, 0, 1),
+    sym(name, symbol2t::level2, 1, 1, 0, 0),
+    sym(name, symbol2t::level2, 1, 2, 0, 0),
+    sym(name, symbol2t::level2, 1, 2, 0, 3),
+    sym(name, symbol2t::level2, 2, 1, 0, 0),
+    sym(name, symbol2t::level2_global, 0, 1, 0, 0),
+    sym(name, symbol2t::level2_global, 0, 2, 0, 0)};
+}
+} // namespace
+
+BOOST_GLOBAL_FIXTURE(type_pool_fixturet);
+
+// ** Keys of renamed symbols
+
+BOOST_AUTO_TEST_CASE(keys_equal_exactly_when_names_do)
+{
+  std::vector<expr2tc> syms = renamings("c:@F@main@x");
+  for(const expr2tc &e : renamings("c:@F@main@y"))
+    syms.push_back(e);
+  // Printed as its level0 name, and numbers get_symbol_name doesn't print
+  syms.push_back(sym("c:@x", symbol2t::level1_global));
+  syms.push_back(sym("c:@x", symbol2t::level0));
+  syms.push_back(sym("c:@x", symbol2t::level2_global, 5, 1, 7, 0));
+  syms.push_back(sym("c:@x", symbol2t::level2_global, 0, 1, 0, 0));
+
+  for(const expr2tc &a : syms)
+    for(const expr2tc &b : syms)
+    {
+      bool same_name = to_symbol2t(a).get_symbol_name() ==
+                       to_symbol2t(b).get_symbol_name();
+      BOOST_TEST((key(a) == key(b)) == same_name);
+    }
+}
+
+// ** Insert and lookup
+
+BOOST_AUTO_TEST_CASE(insert_and_contains_renamings)
+{
+  symbol_sett set;
+  std::vector<expr2tc> xs = renamings("c:@F@main@x");
+  std::vector<expr2tc> ys = renamings("c:@F@main@y");
+
+  for(unsigned int i = 0; i < xs.size(); i += 2)
+    BOOST_TEST(set.insert(key(xs[i])));
+
+  for(unsigned int i = 0; i < xs.size(); i++)
+    BOOST_TEST(set.contains(key(xs[i])) == (i % 2 == 0));
+  for(const expr2tc &y : ys)
+    BOOST_TEST(!set.contains(key(y)));
+
+  BOOST_TEST(!set.insert(key(xs[0])));
+  BOOST_TEST(set.size() == (xs.size() + 1) / 2);
+}
+
+BOOST_AUTO_TEST_CASE(insert_grows)
+{
+  // Every level2 number of a few names, far past the initial table
+  symbol_sett set;
+  for(unsigned int n = 0; n < 4; n++)
+    for(unsigned int l2 = 1; l2 <= 1000; l2++)
+      BOOST_TEST(set.insert(
+        key(sym("c:@F@main@v" + std::to_string(n), symbol2t::level2, 1, l2))));
+
+  BOOST_TEST(set.size() == 4000);
+  for(unsigned int l2 = 1; l2 <= 1000; l2++)
+    BOOST_TEST(set.contains(key(sym("c:@F@main@v3", symbol2t::level2, 1, l2))));
+  BOOST_TEST(!set.contains(key(sym("c:@F@main@v3", symbol2t::level2, 1, 1001))));
+  BOOST_TEST(!set.contains(key(sym("c:@F@main@v3", symbol2t::level2, 2, 1))));
+  BOOST_TEST(set.peak_bytes() >= 8000 * sizeof(symbol_keyt));
+
+  set.clear();
+  BOOST_TEST(set.size() == 0);
+  BOOST_TEST(!set.contains(key(sym("c:@F@main@v3", symbol2t::level2, 1, 1))));
+}
+
+// ** Erase
+
+BOOST_AUTO_TEST_CASE(erase_keeps_the_rest)
+{
+  // Erasing from the middle of probe runs must not lose the members after
+  // the hole
+  symbol_sett set;
+  std::vector<symbol_keyt> keys;
+  for(unsigned int l2 = 1; l2 <= 500; l2++)
+    keys.push_back(key(sym("c:@F@main@x", symbol2t::level2, 1, l2)));
+  for(const symbol_keyt &k : keys)
+    set.insert(k);
+
+  for(unsigned int i = 0; i < keys.size(); i += 3)
+    BOOST_TEST(set.erase(keys[i]));
+  BOOST_TEST(!set.erase(keys[0]));
+
+  for(unsigned int i = 0; i < keys.size(); i++)
+    BOOST_TEST(set.contains(keys[i]) == (i % 3 != 0));
+  BOOST_TEST(set.size() == 333);
+
+  for(unsigned int i = 0; i < keys.size(); i++)
+    set.erase(keys[i]);
+  BOOST_TEST(set.size() == 0);
+}
+
+const mode_table_et mode_table[] = {LANGAPI_HAVE_MODE_END};
@@ -0,0 +1,131 @@
+/*******************************************************************
+ Module: value_sett benchmark
+
+ Points-to queries as dereferencing makes them: pointers that may point
+ to one object or to many (after merges at join points), read directly
+ or through pointer arithmetic.
+ \*******************************************************************/
+
+#define BENCHMARK_IREP2
+#include <benchmark.h>
+#include <langapi/mode.h>
+#include <pointer-analysis/value_set.h>
+#include <string>
+#include <util/context.h>
+#include <util/irep2_utils.h>
+#include <util/namespace.h>
+#include <vector>
+
+namespace
+{
+const unsigned int num_objects = 256;
+
+expr2tc l1_symbol(const type2tc &type, const std::string &name)
+{
+  return symbol2tc(type, "c:@F@main@" + name, symbol2t::level1, 1, 0, 0, 0);
+}
+
+class value_set_fixturet
+{
+public:
+  value_set_fixturet() : ns(context), value_set(ns)
+  {
+    const type2tc &int_type = get_int_type(32);
+    type2tc ptr_type(new pointer_type2t(int_type));
+
+    for(unsigned int i = 0; i < num_objects; i++)
+    {
+      expr2tc obj = l1_symbol(int_type, "obj" + std::to_string(i));
+      expr2tc p = l1_symbol(ptr_type, "p" + std::to_string(i));
+      value_set.assign(p, address_of2tc(int_type, obj));
+      single.push_back(p);
+    }
+
+    // One pointer to every object, as after a loop over them all
+    many = l1_symbol(ptr_type, "q");
+    expr2tc obj0 = l1_symbol(int_type, "obj0");
+    value_set.assign(many, address_of2tc(int_type, obj0));
+    for(unsigned int i = 1; i < num_objects; i++)
+    {
+      expr2tc obj = l1_symbol(int_type, "obj" + std::to_string(i));
+      value_set.assign(many, address_of2tc(int_type, obj), true);
+    }
+  }
+
+  contextt context;
+  namespacet ns;
+  value_sett value_set;
+  std::vector<expr2tc> single;
+  expr2tc many;
+};
+
+void value_set_single_target(benchmark_statet &state)
+{
+  value_set_fixturet f;
+  while(state.keep_running())
+  {
+    for(const expr2tc &p : f.single)
+    {
+      value_setst::valuest dest;
+      f.value_set.get_value_set(p, dest);
+      do_not_optimize(dest);
+    }
+  }
+  state.set_items_per_iteration(f.single.size());
+}
+BENCHMARK(value_set_single_target);
+
+void value_set_many_targets(benchmark_statet &state)
+{
+  value_set_fixturet f;
+  while(state.keep_running())
+  {
+    value_setst::valuest dest;
+    f.value_set.get_value_set(f.many, dest);
+    do_not_optimize(dest);
+  }
+  state.set_items_per_iteration(num_objects);
+}
+BENCHMARK(value_set_many_targets);
+
+void value_set_pointer_arithmetic(benchmark_statet &state)
+{
+  value_set_fixturet f;
+  const type2tc &int_type = get_int_type(32);
+  std::vector<expr2tc> exprs;
+  for(unsigned int i = 0; i < f.single.size(); i++)
+    exprs.push_back(add2tc(
+      f.single[i]->type, f.single[i], constant_int2tc(int_type, BigInt(i))));
+
+  while(state.keep_running())
+  {
+    for(const expr2tc &e : exprs)
+    {
+      value_setst::valuest dest;
+      f.value_set.get_value_set(e, dest);
+      do_not_optimize(dest);
+    }
+  }
+  state.set_items_per_iteration(exprs.size());
+}
+BENCHMARK(value_set_pointer_arithmetic);
+
+void value_set_copy_and_assign(benchmark_statet &state)
+{
+  // The value set copied with a goto state, then one pointer assigned
+  value_set_fixturet f;
+  const type2tc &int_type = get_int_type(32);
+  expr2tc target = address_of2tc(int_type, l1_symbol(int_type, "obj0"));
+
+  unsigned int i = 0;
+  while(state.keep_running())
+  {
+    value_sett copy(f.value_set);
+    copy.assign(f.single[i++ % f.single.size()], target);
+    do_not_optimize(copy);
+  }
+}
+BENCHMARK(value_set_copy_and_assign);
+} // namespace
+
+const mode_table_et mode_table[] = {LANGAPI_HAVE_MODE_END};
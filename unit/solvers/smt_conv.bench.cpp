@@ -0,0 +1,112 @@
+/*******************************************************************
+ Module: smt_convt benchmark
+
+ The cost of smt_convt::convert_ast itself, against a stub backend that
+ only numbers the asts it is asked for: walking expressions, the
+ conversion cache, sorts, and the tuple and array flatteners, without
+ any time spent in a real solver.
+ \*******************************************************************/
+
+#define BENCHMARK_IREP2
+#include "stub_conv.h"
+#include <benchmark.h>
+#include <langapi/mode.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+// A balanced tree of bit-vector arithmetic over distinct symbols and a
+// few constants, 2^depth leaves
+expr2tc mk_tree(unsigned int depth, unsigned int &leaf)
+{
+  const type2tc &t = get_int_type(32);
+  if(depth == 0)
+  {
+    unsigned int n = leaf++;
+    if(n % 4 == 3)
+      return constant_int2tc(t, BigInt(n));
+    return symbol2tc(t, "c:@x" + std::to_string(n));
+  }
+
+  expr2tc l = mk_tree(depth - 1, leaf);
+  expr2tc r = mk_tree(depth - 1, leaf);
+  switch(depth % 3)
+  {
+  case 0:
+    return add2tc(t, l, r);
+  case 1:
+    return mul2tc(t, l, r);
+  default:
+    return sub2tc(t, l, r);
+  }
+}
+
+// Shaped like a VCC: guard => (tree < bound), with the tree also read
+// through a conditional and a widening cast
+expr2tc mk_claim(unsigned int depth)
+{
+  unsigned int leaf = 0;
+  expr2tc tree = mk_tree(depth, leaf);
+  const type2tc &t = get_int_type(32);
+  expr2tc guard = symbol2tc(get_bool_type(), "c:@guard");
+  expr2tc ite = if2tc(t, guard, tree, gen_zero(t));
+  expr2tc wide = typecast2tc(get_int_type(64), ite);
+  expr2tc bound = constant_int2tc(get_int_type(64), BigInt(1000));
+  return implies2tc(guard, lessthan2tc(wide, bound));
+}
+
+const unsigned int depth = 8;
+const unsigned int nodes = (1 << (depth + 1)) - 1;
+
+void smt_convert_ast(benchmark_statet &state)
+{
+  // Every iteration converts from scratch: the asts and cache entries it
+  // makes are dropped by the pop
+  stub_solvert s;
+  expr2tc claim = mk_claim(depth);
+  while(state.keep_running())
+  {
+    s.conv.push_ctx();
+    do_not_optimize(s.conv.convert_ast(claim));
+    s.conv.pop_ctx();
+  }
+  state.set_items_per_iteration(nodes);
+}
+BENCHMARK(smt_convert_ast);
+
+void smt_convert_ast_cached(benchmark_statet &state)
+{
+  stub_solvert s;
+  expr2tc claim = mk_claim(depth);
+  s.conv.convert_ast(claim);
+  while(state.keep_running())
+    do_not_optimize(s.conv.convert_ast(claim));
+}
+BENCHMARK(smt_convert_ast_cached);
+
+void smt_convert_shared_subterms(benchmark_statet &state)
+{
+  // Many claims over one tree, as after symex: only the tops are new
+  stub_solvert s;
+  unsigned int leaf = 0;
+  expr2tc tree = mk_tree(depth, leaf);
+  const type2tc &t = get_int_type(32);
+  std::vector<expr2tc> claims;
+  for(unsigned int i = 0; i < 64; i++)
+    claims.push_back(
+      lessthan2tc(add2tc(t, tree, constant_int2tc(t, BigInt(i))), tree));
+
+  while(state.keep_running())
+  {
+    s.conv.push_ctx();
+    for(const expr2tc &c : claims)
+      do_not_optimize(s.conv.convert_ast(c));
+    s.conv.pop_ctx();
+  }
+  state.set_items_per_iteration(claims.size());
+}
+BENCHMARK(smt_convert_shared_subterms);
+} // namespace
+
+const mode_table_et mode_table[] = {LANGAPI_HAVE_MODE_END};
@@ -0,0 +1,142 @@
+/*******************************************************************
+ Module: smt_convt unit test
+
+ Test Plan:
+   - Converting deep expressions
+   - Fetching the value of deep expressions
+ \*******************************************************************/
+
+#define BOOST_TEST_MODULE "SmtConv"
+
+#include "stub_conv.h"
+#include <boost/test/included/unit_test.hpp>
+#include <langapi/mode.h>
+#include <string>
+namespace utf = boost::unit_test;
+
+namespace
+{
+// To avoid the static initialization order fiasco
+struct type_pool_fixturet
+{
+  type_pool_fixturet() : bees(true)
+  {
+    type_pool = bees;
+  }
+
+  type_poolt bees;
+};
+
+// Deep enough to overflow the C stack of a converter that recurses once
+// per level: these pass with a 2MB stack
+const unsigned int depth = 20000;
+
+// ((x + 1) + 2) + ..., as a long run of assignments to one variable ends up
+expr2tc mk_add_chain(unsigned int n)
+{
+  const type2tc &t = get_int_type(32);
+  expr2tc e = symbol2tc(t, "c:@x");
+  for(unsigned int i = 1; i <= n; i++)
+    e = add2tc(t, e, constant_int2tc(t, BigInt(i)));
+  return e;
+}
+
+// c1 ? 1 : (c2 ? 2 : (... : x)), as phi nodes after an unwound loop
+expr2tc mk_if_chain(unsigned int n)
+{
+  const type2tc &t = get_int_type(32);
+  expr2tc e = symbol2tc(t, "c:@x");
+  for(unsigned int i = 1; i <= n; i++)
+    e = if2tc(
+      t,
+      symbol2tc(get_bool_type(), "c:@c" + std::to_string(i)),
+      constant_int2tc(t, BigInt(i)),
+      e);
+  return e;
+}
+
+// a WITH [0 := 1] WITH [1 := 2] ..., as a loop writing array elements
+// round and round
+expr2tc mk_with_chain(unsigned int n)
+{
+  const type2tc &t = get_int_type(32);
+  type2tc arr_t = array_type2tc(t, gen_ulong(16), false);
+  expr2tc e = symbol2tc(arr_t, "c:@a");
+  for(unsigned int i = 0; i < n; i++)
+    e = with2tc(arr_t, e, gen_ulong(i % 16), constant_int2tc(t, BigInt(i + 1)));
+  return e;
+}
+} // namespace
+
+BOOST_GLOBAL_FIXTURE(type_pool_fixturet);
+
+// ** Converting deep expressions
+
+BOOST_AUTO_TEST_CASE(convert_deep_add_chain)
+{
+  stub_solvert s;
+  expr2tc e = mk_add_chain(depth);
+  smt_astt a = s.conv.convert_ast(e);
+  BOOST_TEST(a->sort->get_data_width() == 32);
+  // One ast for the symbol, and two for each level: the constant and the sum
+  BOOST_TEST(s.conv.num_asts >= 2 * depth + 1);
+
+  // Converted again, everything is in the cache
+  unsigned int before = s.conv.num_asts;
+  BOOST_TEST(s.conv.convert_ast(e) == a);
+  BOOST_TEST(s.conv.num_asts == before);
+}
+
+BOOST_AUTO_TEST_CASE(convert_deep_if_chain)
+{
+  stub_solvert s;
+  smt_astt a = s.conv.convert_ast(mk_if_chain(depth));
+  BOOST_TEST(a->sort->get_data_width() == 32);
+}
+
+BOOST_AUTO_TEST_CASE(convert_deep_with_chain)
+{
+  stub_solvert s;
+  smt_astt a = s.conv.convert_ast(mk_with_chain(depth));
+  BOOST_TEST(a->sort->id == SMT_SORT_ARRAY);
+}
+
+BOOST_AUTO_TEST_CASE(convert_deep_claim)
+{
+  // The chains as a claim over them would be handed over after symex
+  stub_solvert s;
+  const type2tc &t = get_int_type(32);
+  expr2tc arr = mk_with_chain(depth);
+  expr2tc claim = equality2tc(
+    add2tc(t, mk_if_chain(depth), index2tc(t, arr, gen_ulong(7))),
+    mk_add_chain(depth));
+  smt_astt a = s.conv.convert_ast(claim);
+  BOOST_TEST(a->sort->id == SMT_SORT_BOOL);
+}
+
+// ** Fetching the value of deep expressions
+
+BOOST_AUTO_TEST_CASE(get_deep_add_chain)
+{
+  // The stub solver has every symbol be zero: the sum of 1..n
+  stub_solvert s;
+  expr2tc e = mk_add_chain(depth);
+  s.conv.convert_ast(e);
+  expr2tc v = s.conv.get(e);
+  BOOST_TEST_REQUIRE(is_constant_int2t(v));
+  BigInt expected = BigInt((uint64_t)depth * (depth + 1) / 2 % (1ULL << 32));
+  BOOST_TEST(to_constant_int2t(v).value == expected);
+}
+
+BOOST_AUTO_TEST_CASE(get_deep_if_chain)
+{
+  // Every condition is false, so the value is that of x
+  stub_solvert s;
+  expr2tc e = mk_if_chain(depth);
+  s.conv.convert_ast(e);
+  expr2tc v = s.conv.get(e);
+  BOOST_TEST_REQUIRE(is_constant_int2t(v));
+  BOOST_TEST(to_constant_int2t(v).value == BigInt(0));
+}
+
+const mode_table_et mode_table[] = {LANGAPI_HAVE_MODE_END};
@@ -0,0 +1,292 @@
+/*******************************************************************
+ Module: Stub SMT backend for the smt_convt tests and benchmarks
+
+ A solver that only numbers the asts it is asked for, so that
+ smt_convt's own walking of expressions, conversion cache, sorts, and
+ tuple and array flatteners can be exercised without a real solver.
+ \*******************************************************************/
+
+#ifndef ESBMC_UNIT_SOLVERS_STUB_CONV_H
+#define ESBMC_UNIT_SOLVERS_STUB_CONV_H
+
+#include <cstdlib>
+#include <solvers/smt/array_conv.h>
+#include <solvers/smt/fp/fp_conv.h>
+#include <solvers/smt/smt_conv.h>
+#include <solvers/smt/tuple/smt_tuple_node.h>
+#include <string>
+#include <util/config.h>
+#include <util/context.h>
+#include <util/namespace.h>
+
+class stub_smt_ast : public solver_smt_ast<unsigned int>
+{
+public:
+  using solver_smt_ast<unsigned int>::solver_smt_ast;
+  ~stub_smt_ast() override = default;
+};
+
+// Every operation makes a new ast of the right sort, and nothing else
+class stub_convt : public smt_convt
+{
+public:
+  stub_convt(const namespacet &_ns) : smt_convt(false, _ns), num_asts(0)
+  {
+  }
+  ~stub_convt() override = default;
+
+  resultt dec_solve() override
+  {
+    return P_ERROR;
+  }
+  void assert_ast(smt_astt) override
+  {
+  }
+  const std::string solver_text() override
+  {
+    return "stub";
+  }
+
+  smt_astt node(smt_sortt s)
+  {
+    return new_solver_ast<stub_smt_ast>(num_asts++, s);
+  }
+  smt_astt bool_node()
+  {
+    return node(boolean_sort);
+  }
+  smt_astt bv_node(std::size_t width)
+  {
+    return node(mk_bv_sort(width));
+  }
+
+  smt_astt mk_bvadd(smt_astt a, smt_astt) override
+  {
+    return node(a->sort);
+  }
+  smt_astt mk_bvsub(smt_astt a, smt_astt) override
+  {
+    return node(a->sort);
+  }
+  smt_astt mk_bvmul(smt_astt a, smt_astt) override
+  {
+    return node(a->sort);
+  }
+  smt_astt mk_bvsmod(smt_astt a, smt_astt) override
+  {
+    return node(a->sort);
+  }
+  smt_astt mk_bvumod(smt_astt a, smt_astt) override
+  {
+    return node(a->sort);
+  }
+  smt_astt mk_bvsdiv(smt_astt a, smt_astt) override
+  {
+    return node(a->sort);
+  }
+  smt_astt mk_bvudiv(smt_astt a, smt_astt) override
+  {
+    return node(a->sort);
+  }
+  smt_astt mk_bvshl(smt_astt a, smt_astt) override
+  {
+    return node(a->sort);
+  }
+  smt_astt mk_bvashr(smt_astt a, smt_astt) override
+  {
+    return node(a->sort);
+  }
+  smt_astt mk_bvlshr(smt_astt a, smt_astt) override
+  {
+    return node(a->sort);
+  }
+  smt_astt mk_bvneg(smt_astt a) override
+  {
+    return node(a->sort);
+  }
+  smt_astt mk_bvnot(smt_astt a) override
+  {
+    return node(a->sort);
+  }
+  smt_astt mk_bvnxor(smt_astt a, smt_astt) override
+  {
+    return node(a->sort);
+  }
+  smt_astt mk_bvnor(smt_astt a, smt_astt) override
+  {
+    return node(a->sort);
+  }
+  smt_astt mk_bvnand(smt_astt a, smt_astt) override
+  {
+    return node(a->sort);
+  }
+  smt_astt mk_bvxor(smt_astt a, smt_astt) override
+  {
+    return node(a->sort);
+  }
+  smt_astt mk_bvor(smt_astt a, smt_astt) override
+  {
+    return node(a->sort);
+  }
+  smt_astt mk_bvand(smt_astt a, smt_astt) override
+  {
+    return node(a->sort);
+  }
+
+  smt_astt mk_implies(smt_astt, smt_astt) override
+  {
+    return bool_node();
+  }
+  smt_astt mk_xor(smt_astt, smt_astt) override
+  {
+    return bool_node();
+  }
+  smt_astt mk_or(smt_astt, smt_astt) override
+  {
+    return bool_node();
+  }
+  smt_astt mk_and(smt_astt, smt_astt) override
+  {
+    return bool_node();
+  }
+  smt_astt mk_not(smt_astt) override
+  {
+    return bool_node();
+  }
+  smt_astt mk_bvult(smt_astt, smt_astt) override
+  {
+    return bool_node();
+  }
+  smt_astt mk_bvslt(smt_astt, smt_astt) override
+  {
+    return bool_node();
+  }
+  smt_astt mk_bvugt(smt_astt, smt_astt) override
+  {
+    return bool_node();
+  }
+  smt_astt mk_bvsgt(smt_astt, smt_astt) override
+  {
+    return bool_node();
+  }
+  smt_astt mk_bvule(smt_astt, smt_astt) override
+  {
+    return bool_node();
+  }
+  smt_astt mk_bvsle(smt_astt, smt_astt) override
+  {
+    return bool_node();
+  }
+  smt_astt mk_bvuge(smt_astt, smt_astt) override
+  {
+    return bool_node();
+  }
+  smt_astt mk_bvsge(smt_astt, smt_astt) override
+  {
+    return bool_node();
+  }
+  smt_astt mk_eq(smt_astt, smt_astt) override
+  {
+    return bool_node();
+  }
+  smt_astt mk_neq(smt_astt, smt_astt) override
+  {
+    return bool_node();
+  }
+
+  smt_sortt mk_bool_sort() override
+  {
+    return new smt_sort(SMT_SORT_BOOL, 1);
+  }
+  smt_sortt mk_bv_sort(std::size_t width) override
+  {
+    return new smt_sort(SMT_SORT_BV, width);
+  }
+  smt_sortt mk_fbv_sort(std::size_t width) override
+  {
+    return new smt_sort(SMT_SORT_FIXEDBV, width);
+  }
+  smt_sortt mk_bvfp_sort(std::size_t ew, std::size_t sw) override
+  {
+    return new smt_sort(SMT_SORT_BVFP, ew + sw + 1, sw + 1);
+  }
+  smt_sortt mk_bvfp_rm_sort() override
+  {
+    return new smt_sort(SMT_SORT_BVFP_RM, 3);
+  }
+  smt_sortt mk_array_sort(smt_sortt domain, smt_sortt range) override
+  {
+    return new smt_sort(SMT_SORT_ARRAY, domain->get_data_width(), range);
+  }
+
+  smt_astt mk_smt_int(const BigInt &) override
+  {
+    abort();
+  }
+  smt_astt mk_smt_real(const std::string &) override
+  {
+    abort();
+  }
+  smt_astt mk_smt_bv(const BigInt &, smt_sortt s) override
+  {
+    return node(s);
+  }
+  smt_astt mk_smt_bool(bool) override
+  {
+    return bool_node();
+  }
+  smt_astt mk_smt_symbol(const std::string &, smt_sortt s) override
+  {
+    return node(s);
+  }
+  smt_astt mk_extract(smt_astt, unsigned int high, unsigned int low) override
+  {
+    return bv_node(high - low + 1);
+  }
+  smt_astt mk_sign_ext(smt_astt a, unsigned int topwidth) override
+  {
+    return bv_node(a->sort->get_data_width() + topwidth);
+  }
+  smt_astt mk_zero_ext(smt_astt a, unsigned int topwidth) override
+  {
+    return bv_node(a->sort->get_data_width() + topwidth);
+  }
+  smt_astt mk_concat(smt_astt a, smt_astt b) override
+  {
+    return bv_node(a->sort->get_data_width() + b->sort->get_data_width());
+  }
+  smt_astt mk_ite(smt_astt, smt_astt t, smt_astt) override
+  {
+    return node(t->sort);
+  }
+
+  bool get_bool(smt_astt) override
+  {
+    return false;
+  }
+  BigInt get_bv(smt_astt) override
+  {
+    return BigInt(0);
+  }
+
+  unsigned int num_asts;
+};
+
+class stub_solvert
+{
+public:
+  stub_solvert() : ns(context), conv(ns)
+  {
+    config.ansi_c.set_64();
+    conv.set_tuple_iface(new smt_tuple_node_flattener(&conv, ns));
+    conv.set_array_iface(new array_convt(&conv));
+    conv.set_fp_conv(new fp_convt(&conv));
+    conv.smt_post_init();
+  }
+
+  contextt context;
+  namespacet ns;
+  stub_convt conv;
+};
+
+#endif /* ESBMC_UNIT_SOLVERS_STUB_CONV_H */
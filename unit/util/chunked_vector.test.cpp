@@ -0,0 +1,143 @@
+/*******************************************************************
+ Module: chunked_vector unit test
+
+ Test Plan:
+   - Growth across chunks
+   - Iterators
+   - Erasure
+ \*******************************************************************/
+
+#define BOOST_TEST_MODULE "Chunked Vector"
+
+#include <algorithm>
+#include <boost/test/included/unit_test.hpp>
+#include <memory>
+#include <string>
+#include <util/chunked_vector.h>
+#include <vector>
+namespace utf = boost::unit_test;
+
+// Tiny chunks so that every test crosses several of them
+typedef chunked_vectort<std::string, 2> small_vectort;
+
+namespace
+{
+small_vectort make(unsigned int n)
+{
+  small_vectort v;
+  for(unsigned int i = 0; i < n; i++)
+    v.emplace_back(std::to_string(i));
+  return v;
+}
+} // namespace
+
+// ** Growth across chunks
+BOOST_AUTO_TEST_SUITE(growth)
+BOOST_AUTO_TEST_CASE(references_are_stable)
+{
+  small_vectort v;
+  std::vector<const std::string *> addrs;
+  for(unsigned int i = 0; i < 100; i++)
+    addrs.push_back(&v.emplace_back(std::to_string(i)));
+
+  BOOST_TEST(v.size() == 100u);
+  for(unsigned int i = 0; i < 100; i++)
+  {
+    BOOST_TEST(addrs[i] == &v[i]);
+    BOOST_TEST(v[i] == std::to_string(i));
+  }
+}
+BOOST_AUTO_TEST_CASE(clear_destroys_everything)
+{
+  std::shared_ptr<int> p = std::make_shared<int>(0);
+  chunked_vectort<std::shared_ptr<int>, 2> v;
+  for(unsigned int i = 0; i < 10; i++)
+    v.push_back(p);
+  BOOST_TEST(p.use_count() == 11);
+  BOOST_TEST(v.allocated_bytes() != 0u);
+
+  v.clear();
+  BOOST_TEST(p.use_count() == 1);
+  BOOST_TEST(v.empty());
+  BOOST_TEST(v.allocated_bytes() == 0u);
+}
+BOOST_AUTO_TEST_CASE(copy_and_move)
+{
+  small_vectort a = make(9);
+  small_vectort b(a);
+  BOOST_TEST(std::equal(a.begin(), a.end(), b.begin(), b.end()));
+
+  small_vectort c(std::move(a));
+  BOOST_TEST(a.empty());
+  BOOST_TEST(std::equal(b.begin(), b.end(), c.begin(), c.end()));
+}
+BOOST_AUTO_TEST_SUITE_END()
+
+// ** Iterators
+BOOST_AUTO_TEST_SUITE(iterators)
+BOOST_AUTO_TEST_CASE(survive_appends)
+{
+  small_vectort v = make(3);
+  small_vectort::iterator it = v.begin() + 1;
+  small_vectort::iterator at_end = v.end();
+  for(unsigned int i = 3; i < 50; i++)
+    v.emplace_back(std::to_string(i));
+
+  BOOST_TEST(*it == "1");
+  BOOST_TEST(*at_end == "3");
+}
+BOOST_AUTO_TEST_CASE(reverse_and_mixed_constness)
+{
+  small_vectort v = make(10);
+  const small_vectort &cv = v;
+
+  unsigned int i = 10;
+  for(small_vectort::const_reverse_iterator it = cv.rbegin(); it != cv.rend();
+      ++it)
+    BOOST_TEST(*it == std::to_string(--i));
+  BOOST_TEST(i == 0u);
+
+  small_vectort::const_iterator c = cv.begin() + 4;
+  small_vectort::iterator m = v.begin() + 4;
+  BOOST_TEST((c == m));
+  BOOST_TEST((m == c));
+  BOOST_TEST((c < v.end()));
+  BOOST_TEST((v.end() - m == 6));
+}
+BOOST_AUTO_TEST_SUITE_END()
+
+// ** Erasure
+BOOST_AUTO_TEST_SUITE(erasure)
+BOOST_AUTO_TEST_CASE(truncate_keeps_prefix)
+{
+  small_vectort v = make(10);
+  size_t bytes = v.allocated_bytes();
+  v.truncate(5);
+  BOOST_TEST(v.size() == 5u);
+  BOOST_TEST(v.back() == "4");
+  BOOST_TEST(v.allocated_bytes() == bytes);
+
+  v.emplace_back("x");
+  BOOST_TEST(v[5] == "x");
+}
+BOOST_AUTO_TEST_CASE(erase_middle)
+{
+  small_vectort v = make(10);
+  v.erase(v.begin() + 2, v.begin() + 5);
+  std::vector<std::string> expected = {"0", "1", "5", "6", "7", "8", "9"};
+  BOOST_TEST(std::equal(v.begin(), v.end(), expected.begin(), expected.end()));
+}
+BOOST_AUTO_TEST_CASE(remove_if_compacts)
+{
+  small_vectort v = make(20);
+  small_vectort::iterator new_end =
+    std::remove_if(v.begin(), v.end(), [](const std::string &s) {
+      return std::stoi(s) % 3 == 0;
+    });
+  v.erase(new_end, v.end());
+
+  BOOST_TEST(v.size() == 13u);
+  for(const auto &s : v)
+    BOOST_TEST(std::stoi(s) % 3 != 0);
+}
+BOOST_AUTO_TEST_SUITE_END()
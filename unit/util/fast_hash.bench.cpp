@@ -0,0 +1,132 @@
+/*******************************************************************
+ Module: State hashing benchmark
+
+ Compares crypto_hash (SHA-1) with fast_hash on the work that
+ --state-hashing does: hash every assigned value, then hash the map of
+ per-variable digests at each context switch point to prune interleavings.
+ \*******************************************************************/
+
+#include <array>
+#include <benchmark.h>
+#include <cstring>
+#include <map>
+#include <random>
+#include <util/crypto_hash.h>
+#include <util/fast_hash.h>
+#include <vector>
+
+namespace
+{
+// Roughly the amount of data expr2t::hash feeds in for a small rhs
+const unsigned int value_size = 48;
+const unsigned int num_values = 1024;
+const unsigned int num_vars = 256;
+const unsigned int assigns_per_state = 16;
+
+template <typename H, typename D>
+D digest(H &h);
+
+template <>
+std::array<unsigned int, 5> digest(crypto_hash &h)
+{
+  h.fin();
+  std::array<unsigned int, 5> d;
+  memcpy(d.data(), h.hash, sizeof(h.hash));
+  return d;
+}
+
+template <>
+fast_hash::digestt digest(fast_hash &h)
+{
+  h.fin();
+  return h.hash;
+}
+
+std::vector<uint8_t> random_values()
+{
+  std::mt19937 rng(0);
+  std::vector<uint8_t> values(num_values * value_size);
+  for(auto &v : values)
+    v = rng();
+  return values;
+}
+
+// One value assigned to each variable, as at every assignment
+template <typename H, typename D>
+void hash_assignments(benchmark_statet &state)
+{
+  std::vector<uint8_t> values = random_values();
+  std::map<unsigned int, D> current_hashes;
+
+  unsigned int i = 0;
+  while(state.keep_running())
+  {
+    for(unsigned int v = 0; v < num_vars; v++, i++)
+    {
+      H h;
+      h.ingest(&values[(i % num_values) * value_size], value_size);
+      current_hashes[v] = digest<H, D>(h);
+    }
+  }
+  do_not_optimize(current_hashes);
+  state.set_items_per_iteration(num_vars);
+}
+
+// The digest of the whole state, as at every context switch point, after
+// a few assignments since the last one
+template <typename H, typename D>
+void hash_states(benchmark_statet &state)
+{
+  std::vector<uint8_t> values = random_values();
+  std::map<unsigned int, D> current_hashes;
+  for(unsigned int v = 0; v < num_vars; v++)
+  {
+    H h;
+    h.ingest(&values[v * value_size], value_size);
+    current_hashes[v] = digest<H, D>(h);
+  }
+
+  unsigned int i = 0;
+  while(state.keep_running())
+  {
+    for(unsigned int a = 0; a < assigns_per_state; a++, i++)
+    {
+      H h;
+      h.ingest(&values[(i % num_values) * value_size], value_size);
+      current_hashes[i % num_vars] = digest<H, D>(h);
+    }
+
+    H h;
+    for(const auto &it : current_hashes)
+    {
+      h.ingest(&it.first, sizeof(it.first));
+      h.ingest(it.second.data(), sizeof(it.second));
+    }
+    do_not_optimize(digest<H, D>(h));
+  }
+}
+
+void crypto_hash_assignments(benchmark_statet &state)
+{
+  hash_assignments<crypto_hash, std::array<unsigned int, 5>>(state);
+}
+BENCHMARK(crypto_hash_assignments);
+
+void fast_hash_assignments(benchmark_statet &state)
+{
+  hash_assignments<fast_hash, fast_hash::digestt>(state);
+}
+BENCHMARK(fast_hash_assignments);
+
+void crypto_hash_states(benchmark_statet &state)
+{
+  hash_states<crypto_hash, std::array<unsigned int, 5>>(state);
+}
+BENCHMARK(crypto_hash_states);
+
+void fast_hash_states(benchmark_statet &state)
+{
+  hash_states<fast_hash, fast_hash::digestt>(state);
+}
+BENCHMARK(fast_hash_states);
+} // namespace
@@ -0,0 +1,99 @@
+/*******************************************************************
+ Module: fast_hash unit test
+
+ Test Plan:
+   - Known answers
+   - Incremental ingestion
+   - Comparators
+ \*******************************************************************/
+
+#define BOOST_TEST_MODULE "Fast Hash"
+
+#include <boost/test/included/unit_test.hpp>
+#include <cstring>
+#include <set>
+#include <string>
+#include <util/fast_hash.h>
+namespace utf = boost::unit_test;
+
+namespace
+{
+fast_hash::digestt hash_of(const std::string &str)
+{
+  fast_hash h;
+  h.ingest(str.data(), str.size());
+  h.fin();
+  return h.hash;
+}
+} // namespace
+
+// ** Known answers
+// MurmurHash3_x64_128 with a zero seed
+BOOST_AUTO_TEST_SUITE(known_answers)
+BOOST_AUTO_TEST_CASE(empty_input)
+{
+  fast_hash h;
+  h.fin();
+  BOOST_TEST(h.hash[0] == 0u);
+  BOOST_TEST(h.hash[1] == 0u);
+  BOOST_TEST(h.to_string() == std::string(32, '0'));
+}
+BOOST_AUTO_TEST_CASE(short_input)
+{
+  fast_hash::digestt d = hash_of("hello");
+  BOOST_TEST(d[0] == 0xcbd8a7b341bd9b02ULL);
+  BOOST_TEST(d[1] == 0x5b1e906a48ae1d19ULL);
+}
+BOOST_AUTO_TEST_SUITE_END()
+
+// ** Incremental ingestion
+BOOST_AUTO_TEST_SUITE(incremental)
+BOOST_AUTO_TEST_CASE(split_matches_whole)
+{
+  const std::string str =
+    "The quick brown fox jumps over the lazy dog, again and again";
+
+  for(unsigned int cut1 = 0; cut1 <= str.size(); cut1++)
+  {
+    for(unsigned int cut2 = cut1; cut2 <= str.size(); cut2 += 7)
+    {
+      fast_hash h;
+      h.ingest(str.data(), cut1);
+      h.ingest(str.data() + cut1, cut2 - cut1);
+      h.ingest(str.data() + cut2, str.size() - cut2);
+      h.fin();
+      BOOST_TEST((h.hash == hash_of(str)));
+    }
+  }
+}
+BOOST_AUTO_TEST_CASE(length_matters)
+{
+  // Trailing zero bytes must change the digest
+  std::string a("abc"), b("abc");
+  b.push_back('\0');
+  BOOST_TEST((hash_of(a) != hash_of(b)));
+}
+BOOST_AUTO_TEST_SUITE_END()
+
+// ** Comparators
+BOOST_AUTO_TEST_SUITE(comparators)
+BOOST_AUTO_TEST_CASE(ordering_is_strict)
+{
+  std::set<fast_hash::digestt> seen;
+  for(unsigned int i = 0; i < 1000; i++)
+    seen.insert(hash_of(std::to_string(i)));
+
+  BOOST_TEST(seen.size() == 1000u);
+}
+BOOST_AUTO_TEST_CASE(object_comparison)
+{
+  fast_hash a, b;
+  a.ingest("x", 1);
+  b.ingest("y", 1);
+  a.fin();
+  b.fin();
+  BOOST_TEST(!(a == b));
+  BOOST_TEST(((a < b) != (b < a)));
+  BOOST_TEST((a == a));
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,109 @@
+/*******************************************************************
+ Module: guardt benchmark
+
+ Guards as symex uses them: grown one branch condition at a time, merged
+ where two paths join (with a long common prefix, and either one or
+ several conditions apart), and turned into an expression for each
+ assignment and assertion.
+ \*******************************************************************/
+
+#define BENCHMARK_IREP2
+#include <benchmark.h>
+#include <string>
+#include <util/guard.h>
+#include <util/irep2_utils.h>
+#include <vector>
+
+namespace
+{
+std::vector<expr2tc> conditions(const std::string &prefix, unsigned int n)
+{
+  std::vector<expr2tc> v;
+  for(unsigned int i = 0; i < n; i++)
+    v.push_back(symbol2tc(get_bool_type(), prefix + std::to_string(i)));
+  return v;
+}
+
+guardt mk_guard(const std::vector<expr2tc> &conds)
+{
+  guardt g;
+  for(const expr2tc &c : conds)
+    g.add(c);
+  return g;
+}
+
+const unsigned int prefix_length = 32;
+
+void guard_add(benchmark_statet &state)
+{
+  std::vector<expr2tc> conds = conditions("c:@g", 64);
+  while(state.keep_running())
+    do_not_optimize(mk_guard(conds));
+  state.set_items_per_iteration(conds.size());
+}
+BENCHMARK(guard_add);
+
+void guard_merge_branches(benchmark_statet &state)
+{
+  // The two sides of an if, joining: prefix && c, and prefix && !c
+  guardt prefix = mk_guard(conditions("c:@g", prefix_length));
+  expr2tc c = symbol2tc(get_bool_type(), "c:@cond");
+  guardt then_guard = prefix;
+  then_guard.add(c);
+  guardt else_guard = prefix;
+  else_guard.add(not2tc(c));
+
+  while(state.keep_running())
+  {
+    guardt g = then_guard;
+    g |= else_guard;
+    do_not_optimize(g);
+  }
+}
+BENCHMARK(guard_merge_branches);
+
+void guard_merge_diverged(benchmark_statet &state)
+{
+  // Paths that went through several branches apart before joining
+  guardt prefix = mk_guard(conditions("c:@g", prefix_length));
+  guardt a = prefix;
+  for(const expr2tc &c : conditions("c:@a", 8))
+    a.add(c);
+  guardt b = prefix;
+  for(const expr2tc &c : conditions("c:@b", 8))
+    b.add(c);
+
+  while(state.keep_running())
+  {
+    guardt g = a;
+    g |= b;
+    do_not_optimize(g);
+  }
+}
+BENCHMARK(guard_merge_diverged);
+
+void guard_remove_prefix(benchmark_statet &state)
+{
+  // What leaving a function does to the guard of the caller
+  guardt prefix = mk_guard(conditions("c:@g", prefix_length));
+  guardt g = prefix;
+  for(const expr2tc &c : conditions("c:@a", 8))
+    g.add(c);
+
+  while(state.keep_running())
+  {
+    guardt tmp = g;
+    tmp -= prefix;
+    do_not_optimize(tmp);
+  }
+}
+BENCHMARK(guard_remove_prefix);
+
+void guard_as_expr(benchmark_statet &state)
+{
+  guardt g = mk_guard(conditions("c:@g", 64));
+  while(state.keep_running())
+    do_not_optimize(g.as_expr());
+}
+BENCHMARK(guard_as_expr);
+} // namespace
@@ -0,0 +1,163 @@
+/*******************************************************************
+ Module: guardt unit test
+
+ Test Plan:
+   - Equality
+   - Append
+   - Removing a prefix
+   - Disjunction
+ \*******************************************************************/
+
+#define BOOST_TEST_MODULE "Guard"
+
+#include <boost/test/included/unit_test.hpp>
+#include <string>
+#include <util/guard.h>
+#include <util/irep2_utils.h>
+#include <vector>
+namespace utf = boost::unit_test;
+
+namespace
+{
+// To avoid the static initialization order fiasco
+struct type_pool_fixturet
+{
+  type_pool_fixturet() : bees(true)
+  {
+    type_pool = bees;
+  }
+
+  type_poolt bees;
+};
+
+expr2tc sym(const std::string &name)
+{
+  return symbol2tc(get_bool_type(), "c:@" + name);
+}
+
+guardt mk_guard(const std::vector<std::string> &names)
+{
+  guardt g;
+  for(const auto &name : names)
+    g.add(sym(name));
+  return g;
+}
+} // namespace
+
+BOOST_GLOBAL_FIXTURE(type_pool_fixturet);
+
+// ** Equality
+
+BOOST_AUTO_TEST_CASE(equal_after_equal_adds)
+{
+  guardt g1 = mk_guard({"a", "b", "c"});
+  guardt g2 = mk_guard({"a", "b", "c"});
+  BOOST_TEST((g1 == g2));
+  BOOST_TEST((g1.as_expr() == g2.as_expr()));
+}
+
+BOOST_AUTO_TEST_CASE(not_equal_after_different_adds)
+{
+  guardt g1 = mk_guard({"a", "b", "c"});
+  guardt g2 = mk_guard({"a", "b", "d"});
+  guardt g3 = mk_guard({"a", "b"});
+  BOOST_TEST(!(g1 == g2));
+  BOOST_TEST(!(g1 == g3));
+}
+
+BOOST_AUTO_TEST_CASE(and_is_split_into_conjuncts)
+{
+  guardt g1 = mk_guard({"a", "b", "c"});
+  guardt g2 = mk_guard({"a"});
+  g2.add(and2tc(sym("b"), sym("c")));
+  BOOST_TEST((g1 == g2));
+}
+
+// ** Append
+
+BOOST_AUTO_TEST_CASE(append_onto_true)
+{
+  guardt g = mk_guard({"a", "b"});
+  guardt t;
+  t.append(g);
+  BOOST_TEST((t == g));
+  BOOST_TEST((t.as_expr() == and2tc(sym("a"), sym("b"))));
+}
+
+BOOST_AUTO_TEST_CASE(append_true)
+{
+  guardt g = mk_guard({"a", "b"});
+  guardt t;
+  g.append(t);
+  BOOST_TEST((g == mk_guard({"a", "b"})));
+}
+
+BOOST_AUTO_TEST_CASE(append_onto_guard)
+{
+  guardt g = mk_guard({"a"});
+  g.append(mk_guard({"b", "c"}));
+  BOOST_TEST((g == mk_guard({"a", "b", "c"})));
+}
+
+// ** Removing a prefix
+
+BOOST_AUTO_TEST_CASE(remove_prefix)
+{
+  guardt prefix = mk_guard({"a", "b"});
+  guardt g = mk_guard({"a", "b", "c", "d"});
+  g -= prefix;
+  BOOST_TEST((g == mk_guard({"c", "d"})));
+  BOOST_TEST((g.as_expr() == and2tc(sym("c"), sym("d"))));
+}
+
+BOOST_AUTO_TEST_CASE(remove_whole_guard)
+{
+  guardt g = mk_guard({"a", "b"});
+  g -= mk_guard({"a", "b"});
+  BOOST_TEST(g.is_true());
+}
+
+BOOST_AUTO_TEST_CASE(remove_true)
+{
+  guardt g = mk_guard({"a", "b"});
+  g -= guardt();
+  BOOST_TEST((g == mk_guard({"a", "b"})));
+}
+
+// ** Disjunction
+
+BOOST_AUTO_TEST_CASE(or_of_siblings)
+{
+  // The two sides of an if, joining: prefix && c, and prefix && !c
+  guardt prefix = mk_guard({"a", "b"});
+  guardt then_guard = prefix;
+  then_guard.add(sym("c"));
+  guardt else_guard = prefix;
+  else_guard.add(not2tc(sym("c")));
+
+  then_guard |= else_guard;
+  BOOST_TEST((then_guard == prefix));
+}
+
+BOOST_AUTO_TEST_CASE(or_of_diverged_guards)
+{
+  // Several branches apart: only the common prefix stays out of the or
+  guardt g1 = mk_guard({"a", "b", "x", "y"});
+  guardt g2 = mk_guard({"a", "b", "z"});
+  g1 |= g2;
+
+  guardt expected = mk_guard({"a", "b"});
+  expected.add(or2tc(and2tc(sym("x"), sym("y")), sym("z")));
+  BOOST_TEST((g1 == expected));
+}
+
+BOOST_AUTO_TEST_CASE(or_with_true)
+{
+  guardt g = mk_guard({"a", "b"});
+  g |= guardt();
+  BOOST_TEST(g.is_true());
+
+  guardt t;
+  t |= mk_guard({"a", "b"});
+  BOOST_TEST(t.is_true());
+}
@@ -0,0 +1,218 @@
+/*******************************************************************
+ Module: irep2 benchmark
+
+ The operations every pass does on expressions: building them, hashing
+ them (crc), comparing them, simplifying them, and writing and reading
+ the old ireps they are migrated back to in goto binaries.
+ \*******************************************************************/
+
+#define BENCHMARK_IREP2
+#include <benchmark.h>
+#include <sstream>
+#include <string>
+#include <util/irep2.h>
+#include <util/irep2_utils.h>
+#include <util/irep_serialization.h>
+#include <util/migrate.h>
+#include <vector>
+
+namespace
+{
+// A balanced tree of integer arithmetic over distinct symbols and a few
+// constants, 2^depth leaves
+expr2tc mk_tree(unsigned int depth, unsigned int &leaf)
+{
+  const type2tc &t = get_int_type(32);
+  if(depth == 0)
+  {
+    unsigned int n = leaf++;
+    if(n % 4 == 3)
+      return constant_int2tc(t, BigInt(n));
+    return symbol2tc(t, "c:@x" + std::to_string(n));
+  }
+
+  expr2tc l = mk_tree(depth - 1, leaf);
+  expr2tc r = mk_tree(depth - 1, leaf);
+  switch(depth % 3)
+  {
+  case 0:
+    return add2tc(t, l, r);
+  case 1:
+    return mul2tc(t, l, r);
+  default:
+    return sub2tc(t, l, r);
+  }
+}
+
+expr2tc mk_tree(unsigned int depth)
+{
+  unsigned int leaf = 0;
+  return mk_tree(depth, leaf);
+}
+
+const unsigned int depth = 8;
+const unsigned int nodes = (1 << (depth + 1)) - 1;
+
+void expr_construction(benchmark_statet &state)
+{
+  while(state.keep_running())
+    do_not_optimize(mk_tree(depth));
+  state.set_items_per_iteration(nodes);
+}
+BENCHMARK(expr_construction);
+
+void expr_construction_hash_consed(benchmark_statet &state)
+{
+  irep2_hash_consing = true;
+  while(state.keep_running())
+    do_not_optimize(mk_tree(depth));
+  irep2_hash_consing = false;
+  state.set_items_per_iteration(nodes);
+}
+BENCHMARK(expr_construction_hash_consed);
+
+void expr_crc(benchmark_statet &state)
+{
+  while(state.keep_running())
+  {
+    // crc is cached in each node: hash a fresh tree every time
+    state.pause_timing();
+    const expr2tc tree = mk_tree(depth);
+    state.resume_timing();
+    do_not_optimize(tree.crc());
+  }
+  state.set_items_per_iteration(nodes);
+}
+BENCHMARK(expr_crc);
+
+void expr_compare_equal(benchmark_statet &state)
+{
+  // Equal, but not shared, so that the whole tree is walked
+  const expr2tc a = mk_tree(depth);
+  const expr2tc b = mk_tree(depth);
+  while(state.keep_running())
+    do_not_optimize(a == b);
+  state.set_items_per_iteration(nodes);
+}
+BENCHMARK(expr_compare_equal);
+
+void replace_last_leaf(expr2tc &e, const expr2tc &leaf)
+{
+  unsigned int n = e->get_num_sub_exprs();
+  if(n == 0)
+    e = leaf;
+  else
+    replace_last_leaf(*e->get_sub_expr_nc(n - 1), leaf);
+}
+
+void expr_compare_less(benchmark_statet &state)
+{
+  // Only the last leaf differs, so the comparison walks the whole tree
+  const expr2tc a = mk_tree(depth);
+  expr2tc b = mk_tree(depth);
+  replace_last_leaf(b, symbol2tc(get_int_type(32), "c:@z"));
+  while(state.keep_running())
+  {
+    do_not_optimize(a < b);
+    do_not_optimize(b < a);
+  }
+  state.set_items_per_iteration(2);
+}
+BENCHMARK(expr_compare_less);
+
+// What symex hands to the simplifier: constant folding, decided
+// conditionals, and operations with a neutral operand
+std::vector<expr2tc> simplifiable_exprs()
+{
+  const type2tc &t = get_int_type(32);
+  std::vector<expr2tc> v;
+  for(unsigned int i = 0; i < 16; i++)
+  {
+    symbol2tc x(t, "c:@x" + std::to_string(i));
+    symbol2tc y(t, "c:@y" + std::to_string(i));
+    constant_int2tc c(t, BigInt(i));
+    constant_int2tc d(t, BigInt(i + 3));
+
+    v.push_back(add2tc(t, x, mul2tc(t, c, d)));
+    v.push_back(if2tc(t, lessthan2tc(c, d), x, y));
+    v.push_back(and2tc(gen_true_expr(), equality2tc(x, x)));
+    v.push_back(sub2tc(t, add2tc(t, x, gen_zero(t)), c));
+  }
+  return v;
+}
+
+void expr_simplify(benchmark_statet &state)
+{
+  std::vector<expr2tc> v = simplifiable_exprs();
+  while(state.keep_running())
+  {
+    for(const expr2tc &e : v)
+      do_not_optimize(e->simplify());
+  }
+  state.set_items_per_iteration(v.size());
+}
+BENCHMARK(expr_simplify);
+
+void expr_simplify_nothing(benchmark_statet &state)
+{
+  // Nothing folds: the cost of finding that out
+  const expr2tc tree = mk_tree(6);
+  while(state.keep_running())
+    do_not_optimize(tree->simplify());
+}
+BENCHMARK(expr_simplify_nothing);
+
+std::vector<irept> serializable_ireps()
+{
+  std::vector<irept> v;
+  for(unsigned int i = 0; i < 64; i++)
+  {
+    unsigned int leaf = i;
+    v.push_back(migrate_expr_back(mk_tree(5, leaf)));
+  }
+  return v;
+}
+
+void irep_serialization_write(benchmark_statet &state)
+{
+  std::vector<irept> v = serializable_ireps();
+  while(state.keep_running())
+  {
+    std::ostringstream out;
+    irep_serializationt::ireps_containert container;
+    irep_serializationt s(container);
+    for(const irept &irep : v)
+      s.reference_convert(irep, out);
+    do_not_optimize(out.tellp());
+  }
+  state.set_items_per_iteration(v.size());
+}
+BENCHMARK(irep_serialization_write);
+
+void irep_serialization_read(benchmark_statet &state)
+{
+  std::vector<irept> v = serializable_ireps();
+  std::string data;
+  {
+    std::ostringstream out;
+    irep_serializationt::ireps_containert container;
+    irep_serializationt s(container);
+    for(const irept &irep : v)
+      s.reference_convert(irep, out);
+    data = out.str();
+  }
+
+  while(state.keep_running())
+  {
+    std::istringstream in(data);
+    irep_serializationt::ireps_containert container;
+    irep_serializationt s(container);
+    irept irep;
+    for(unsigned int i = 0; i < v.size(); i++)
+      s.reference_convert(in, irep);
+    do_not_optimize(irep);
+  }
+  state.set_items_per_iteration(v.size());
+}
+BENCHMARK(irep_serialization_read);
+} // namespace
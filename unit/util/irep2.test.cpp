@@ -0,0 +1,131 @@
+/*******************************************************************
+ Module: irep2 hash-consing unit test
+
+ Test Plan:
+   - Structurally equal types and expressions share one object
+   - Different ones don't
+   - Writes never reach the canonical object
+   - Nothing is shared while hash-consing is off
+ \*******************************************************************/
+
+#define BOOST_TEST_MODULE "IRep2"
+
+#include <boost/test/included/unit_test.hpp>
+#include <string>
+#include <util/irep2_utils.h>
+namespace utf = boost::unit_test;
+
+namespace
+{
+// To avoid the static initialization order fiasco
+struct type_pool_fixturet
+{
+  type_pool_fixturet() : bees(true)
+  {
+    type_pool = bees;
+  }
+
+  type_poolt bees;
+};
+
+// Turns hash-consing on for one test case
+struct hash_consing_fixturet
+{
+  hash_consing_fixturet()
+  {
+    irep2_hash_consing = true;
+  }
+
+  ~hash_consing_fixturet()
+  {
+    irep2_hash_consing = false;
+  }
+};
+
+// The object held, without detaching as the non-const accessors would
+template <typename T>
+const T *obj(const irep_container<T> &c)
+{
+  return c.get();
+}
+
+// x + (y * 3) over unsigned 32 bit values, built from scratch every time
+expr2tc mk_expr(const std::string &y)
+{
+  type2tc t = unsignedbv_type2tc(32);
+  expr2tc x = symbol2tc(t, "c:@x");
+  expr2tc mul = mul2tc(t, symbol2tc(t, "c:@" + y), constant_int2tc(t, 3));
+  return add2tc(t, x, mul);
+}
+} // namespace
+
+BOOST_GLOBAL_FIXTURE(type_pool_fixturet);
+
+// ** Structurally equal types and expressions share one object
+
+BOOST_FIXTURE_TEST_CASE(equal_types_shared, hash_consing_fixturet)
+{
+  const type2tc a = unsignedbv_type2tc(32);
+  const type2tc b = unsignedbv_type2tc(32);
+  BOOST_TEST(obj(a) == obj(b));
+
+  const type2tc p1 = pointer_type2tc(signedbv_type2tc(8));
+  const type2tc p2 = pointer_type2tc(signedbv_type2tc(8));
+  BOOST_TEST(obj(p1) == obj(p2));
+  BOOST_TEST(
+    obj(to_pointer_type(p1).subtype) == obj(to_pointer_type(p2).subtype));
+}
+
+BOOST_FIXTURE_TEST_CASE(equal_exprs_shared, hash_consing_fixturet)
+{
+  const expr2tc a = mk_expr("y");
+  const expr2tc b = mk_expr("y");
+  BOOST_TEST(obj(a) == obj(b));
+  BOOST_TEST(obj(to_add2t(a).side_2) == obj(to_add2t(b).side_2));
+  BOOST_TEST(obj(a->type) == obj(b->type));
+  BOOST_TEST(irep2_interned_count() > 0);
+}
+
+// ** Different ones don't
+
+BOOST_FIXTURE_TEST_CASE(different_not_shared, hash_consing_fixturet)
+{
+  BOOST_TEST(obj(unsignedbv_type2tc(32)) != obj(unsignedbv_type2tc(64)));
+  BOOST_TEST(obj(unsignedbv_type2tc(32)) != obj(signedbv_type2tc(32)));
+
+  const expr2tc a = mk_expr("y");
+  const expr2tc b = mk_expr("z");
+  BOOST_TEST(obj(a) != obj(b));
+  BOOST_TEST(!(a == b));
+  // The parts they have in common still are
+  BOOST_TEST(obj(to_add2t(a).side_1) == obj(to_add2t(b).side_1));
+}
+
+// ** Writes never reach the canonical object
+
+BOOST_FIXTURE_TEST_CASE(write_detaches, hash_consing_fixturet)
+{
+  const expr2tc a = mk_expr("y");
+  expr2tc b = mk_expr("y");
+  BOOST_TEST(obj(a) == obj(b));
+
+  to_add2t(b).side_1 = symbol2tc(unsignedbv_type2tc(32), "c:@w");
+  BOOST_TEST(obj(a) != obj(b));
+  BOOST_TEST(to_symbol2t(to_add2t(a).side_1).thename == "c:@x");
+  BOOST_TEST(to_symbol2t(to_add2t(b).side_1).thename == "c:@w");
+
+  // A new copy of the original is still the canonical one
+  BOOST_TEST(obj(mk_expr("y")) == obj(a));
+}
+
+// ** Nothing is shared while hash-consing is off
+
+BOOST_AUTO_TEST_CASE(off_by_default)
+{
+  BOOST_TEST(!irep2_hash_consing);
+
+  const expr2tc a = mk_expr("y");
+  const expr2tc b = mk_expr("y");
+  BOOST_TEST(obj(a) != obj(b));
+  BOOST_TEST((a == b));
+}